@@ -0,0 +1,70 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <iostream>
+#include <cstdlib>
+
+
+namespace
+{
+    struct Check
+    {
+        const char* name;
+        bool      (*function)();
+    };
+
+    const Check checks[] =
+    {
+        {"Glyph pages", &checkGlyphPages},
+        {"Text layout", &checkTextLayout},
+        {"Pixel formats", &checkPixelFormats},
+        {"Pixel kernels", &checkPixelKernels},
+        {"Image resizing", &checkResize},
+        {"PNG writer", &checkPngWriter},
+        {"QOI images", &checkQoi},
+        {"Copy-on-write images", &checkCopyOnWrite},
+        {"Software render target", &checkSoftwareRenderTarget}
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+bool check(bool condition, const std::string& description)
+{
+    if (!condition)
+        std::cout << "    failed: " << description << std::endl;
+
+    return condition;
+}
+
+
+////////////////////////////////////////////////////////////
+/// Entry point of application
+///
+/// Runs all the checks and reports the ones that fail, so
+/// that the program can be run by hand or by a script.
+///
+/// \return Application exit code
+///
+////////////////////////////////////////////////////////////
+int main()
+{
+    std::size_t failures = 0;
+
+    for (std::size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); ++i)
+    {
+        std::cout << checks[i].name << "..." << std::endl;
+
+        bool passed = checks[i].function();
+        if (!passed)
+            failures++;
+
+        std::cout << "    " << (passed ? "passed" : "FAILED") << std::endl;
+    }
+
+    std::cout << failures << " of " << sizeof(checks) / sizeof(checks[0]) << " checks failed" << std::endl;
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
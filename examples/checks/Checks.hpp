@@ -0,0 +1,36 @@
+#ifndef CHECKS_HPP
+#define CHECKS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <string>
+
+
+////////////////////////////////////////////////////////////
+/// Print a message if a condition is false
+///
+/// \param condition   Condition to check
+/// \param description What the condition verifies
+///
+/// \return The condition
+///
+////////////////////////////////////////////////////////////
+bool check(bool condition, const std::string& description);
+
+
+////////////////////////////////////////////////////////////
+// Checks of each feature, they return true if it works as expected
+////////////////////////////////////////////////////////////
+bool checkGlyphPages();
+bool checkTextLayout();
+bool checkPixelFormats();
+bool checkPixelKernels();
+bool checkResize();
+bool checkPngWriter();
+bool checkQoi();
+bool checkCopyOnWrite();
+bool checkSoftwareRenderTarget();
+
+
+#endif // CHECKS_HPP
@@ -0,0 +1,162 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Functions modifying an image
+    void setPixel(sf::Image& image)           {image.setPixel(1, 2, sf::Color::Red);}
+    void flipHorizontally(sf::Image& image)   {image.flipHorizontally();}
+    void flipVertically(sf::Image& image)     {image.flipVertically();}
+    void createMask(sf::Image& image)         {image.createMaskFromColor(image.getPixel(0, 0));}
+    void copyImage(sf::Image& image)          {sf::Image red; red.create(4, 4, sf::Color::Red); image.copy(red, 2, 2);}
+    void convert(sf::Image& image)            {image.convert(sf::L8);}
+    void resize(sf::Image& image)             {image.resize(7, 5);}
+    void premultiplyAlpha(sf::Image& image)   {image.premultiplyAlpha();}
+    void blendPremultiplied(sf::Image& image) {sf::Image red; red.create(4, 4, sf::Color(128, 0, 0, 128)); image.blendPremultiplied(red, 3, 3);}
+
+    struct Modification
+    {
+        const char* name;
+        void      (*function)(sf::Image&);
+    };
+
+    const Modification modifications[] =
+    {
+        {"setPixel",            &setPixel},
+        {"flipHorizontally",    &flipHorizontally},
+        {"flipVertically",      &flipVertically},
+        {"createMaskFromColor", &createMask},
+        {"copy",                &copyImage},
+        {"convert",             &convert},
+        {"resize",              &resize},
+        {"premultiplyAlpha",    &premultiplyAlpha},
+        {"blendPremultiplied",  &blendPremultiplied}
+    };
+
+    // Create an image whose pixels are all different
+    sf::Image createTestImage()
+    {
+        sf::Image image;
+        image.create(16, 12);
+        for (unsigned int y = 0; y < image.getSize().y; ++y)
+        {
+            for (unsigned int x = 0; x < image.getSize().x; ++x)
+                image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 16), static_cast<sf::Uint8>(y * 20), 100, static_cast<sf::Uint8>(50 + x * 10)));
+        }
+
+        return image;
+    }
+
+    // Check that an image still has the given pixels
+    bool hasPixels(const sf::Image& image, const std::vector<sf::Uint8>& pixels)
+    {
+        return (image.getPixelFormat() == sf::RGBA8) &&
+               (image.getSize().x * image.getSize().y * 4 == pixels.size()) &&
+               (std::memcmp(image.getPixelsPtr(), &pixels[0], pixels.size()) == 0);
+    }
+
+    // Copy and modify a shared image many times, from several threads at once
+    struct ThreadData
+    {
+        const sf::Image* shared;
+        sf::Uint8        value;
+        bool             passed;
+    };
+
+    void modifyCopies(ThreadData* data)
+    {
+        data->passed = true;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            sf::Image copy = *data->shared;
+            sf::Image other = copy;
+            copy.setPixel(0, 0, sf::Color(data->value, data->value, data->value));
+
+            if ((copy.getPixel(0, 0).r != data->value) || (other.getPixelsPtr() != data->shared->getPixelsPtr()))
+                data->passed = false;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Copies of an image share their pixels until one of them
+/// is modified; a modification must never be visible in the
+/// other copies
+///
+////////////////////////////////////////////////////////////
+bool checkCopyOnWrite()
+{
+    sf::Image image = createTestImage();
+    std::vector<sf::Uint8> pixels(image.getPixelsPtr(), image.getPixelsPtr() + image.getSize().x * image.getSize().y * 4);
+
+    bool passed = true;
+
+    // Copies share the pixels
+    sf::Image copy(image);
+    sf::Image assigned;
+    assigned = image;
+    passed = check((copy.getPixelsPtr() == image.getPixelsPtr()) && (assigned.getPixelsPtr() == image.getPixelsPtr()), "copies share the pixels") && passed;
+
+    // Every modification detaches the modified copy only
+    for (std::size_t i = 0; i < sizeof(modifications) / sizeof(modifications[0]); ++i)
+    {
+        sf::Image modified(image);
+        sf::Image sibling(image);
+        modifications[i].function(modified);
+
+        passed = check(hasPixels(image, pixels) && hasPixels(sibling, pixels) && (sibling.getPixelsPtr() == image.getPixelsPtr()),
+                       std::string(modifications[i].name) + " doesn't change the other copies") && passed;
+        passed = check(!hasPixels(modified, pixels), std::string(modifications[i].name) + " changes the modified copy") && passed;
+    }
+
+    // The image that was copied can be modified too, its copies keep the old pixels
+    sf::Image source(image);
+    sf::Image copyOfSource(source);
+    source.setPixel(0, 0, sf::Color::Green);
+    passed = check(hasPixels(copyOfSource, pixels) && (source.getPixel(0, 0) == sf::Color::Green), "modify an image which was copied") && passed;
+
+    // Views look at the pixels of the image without copying them
+    sf::ImageView view(image, sf::IntRect(4, 3, 5, 6));
+    passed = check((view.getPixelsPtr() == image.getPixelsPtr() + (4 + 3 * 16) * 4) && (view.getStride() == 16 * 4) &&
+                   (view.getSize() == sf::Vector2u(5, 6)), "a view points to the pixels of the image") && passed;
+
+    sf::ImageView subView = view.getSubView(sf::IntRect(1, 1, 2, 2));
+    passed = check((subView.getPixelsPtr() == image.getPixelsPtr() + (5 + 4 * 16) * 4) && (subView.getSize() == sf::Vector2u(2, 2)),
+                   "a sub-view points to the pixels of the image") && passed;
+
+    sf::Image fromView;
+    fromView.create(5, 6);
+    fromView.copy(view, 0, 0);
+    passed = check((fromView.getPixel(0, 0) == image.getPixel(4, 3)) && (fromView.getPixel(4, 5) == image.getPixel(8, 8)), "copy a view into an image") && passed;
+
+    // The reference count of the shared pixels is safe across threads
+    ThreadData data[4];
+    std::vector<sf::Thread*> threads;
+    for (int i = 0; i < 4; ++i)
+    {
+        data[i].shared = &image;
+        data[i].value = static_cast<sf::Uint8>(i * 60);
+        threads.push_back(new sf::Thread(&modifyCopies, &data[i]));
+        threads.back()->launch();
+    }
+
+    bool threadsPassed = true;
+    for (int i = 0; i < 4; ++i)
+    {
+        threads[i]->wait();
+        threadsPassed = threadsPassed && data[i].passed;
+        delete threads[i];
+    }
+    passed = check(threadsPassed && hasPixels(image, pixels), "copy and modify an image from several threads") && passed;
+
+    return passed;
+}
@@ -0,0 +1,160 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+
+
+namespace
+{
+    // Count the pixels drawn with the color of the text, and the black ones
+    void countTextPixels(const sf::Image& image, unsigned int& colored, unsigned int& black)
+    {
+        colored = 0;
+        black = 0;
+
+        for (unsigned int y = 0; y < image.getSize().y; ++y)
+        {
+            for (unsigned int x = 0; x < image.getSize().x; ++x)
+            {
+                sf::Color color = image.getPixel(x, y);
+                if ((color.r > 128) && (color.g < 64) && (color.b < 64))
+                    colored++;
+                else if ((color.r < 40) && (color.g < 40) && (color.b < 40))
+                    black++;
+            }
+        }
+    }
+
+    // Fragment shader doing what the default pipeline does (OpenGL ES 2
+    // contexts without texture swizzles sample glyph pages as black,
+    // so only their alpha is used there)
+#ifdef SFML_OPENGL_ES2
+    const char* textureShader =
+        "precision mediump float;"
+        "uniform sampler2D texture;"
+        "varying vec4 sf_FrontColor;"
+        "varying vec4 sf_TexCoord;"
+        "void main()"
+        "{"
+        "    gl_FragColor = vec4(sf_FrontColor.rgb, sf_FrontColor.a * texture2D(texture, sf_TexCoord.xy).a);"
+        "}";
+#else
+    const char* textureShader =
+        "uniform sampler2D texture;"
+        "void main()"
+        "{"
+        "    gl_FragColor = gl_Color * texture2D(texture, gl_TexCoord[0].xy);"
+        "}";
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+/// Glyph pages store only the coverage of the glyphs; they
+/// must still sample as white, otherwise text comes out
+/// black instead of taking the color of the vertices
+///
+////////////////////////////////////////////////////////////
+bool checkGlyphPages()
+{
+    sf::Font font;
+    if (!check(font.loadFromFile("resources/sansation.ttf"), "load the font"))
+        return false;
+
+    sf::RenderTexture target;
+    if (!check(target.create(200, 60), "create the render texture"))
+        return false;
+
+    sf::Text text("Hello World", font, 30);
+    text.setFillColor(sf::Color::Red);
+    text.setPosition(5, 5);
+
+    bool passed = true;
+    unsigned int colored;
+    unsigned int black;
+
+    // Default pipeline
+    target.clear(sf::Color::White);
+    target.draw(text);
+    target.display();
+    countTextPixels(target.getTexture().copyToImage(), colored, black);
+    passed = check((colored > 300) && (black == 0), "text drawn with the default states is red") && passed;
+
+    // User shader sampling the page
+    if (sf::Shader::isAvailable())
+    {
+        sf::Shader shader;
+        if (check(shader.loadFromMemory(textureShader, sf::Shader::Fragment), "load the shader"))
+        {
+            shader.setUniform("texture", sf::Shader::CurrentTexture);
+
+            target.clear(sf::Color::White);
+            target.draw(text, &shader);
+            target.display();
+            countTextPixels(target.getTexture().copyToImage(), colored, black);
+            passed = check((colored > 300) && (black == 0), "text drawn with a shader is red") && passed;
+        }
+        else
+        {
+            passed = false;
+        }
+    }
+
+    // The page can be read back, and its pixels are white
+    sf::Image page = font.getTexture(30).copyToImage();
+    passed = check((page.getSize().x > 0) && (page.getSize().y > 0), "read back the glyph page") && passed;
+    page.convert(sf::RGBA8);
+
+    unsigned int covered = 0;
+    unsigned int white = 0;
+    for (unsigned int y = 0; y < page.getSize().y; ++y)
+    {
+        for (unsigned int x = 0; x < page.getSize().x; ++x)
+        {
+            sf::Color color = page.getPixel(x, y);
+            if (color.a > 0)
+            {
+                covered++;
+                if ((color.r == 255) && (color.g == 255) && (color.b == 255))
+                    white++;
+            }
+        }
+    }
+    passed = check(covered > 100, "the glyph page contains the glyphs") && passed;
+    passed = check(white == covered, "the glyphs are white in the glyph page") && passed;
+
+    // A8 textures too; all the rows are the same, so that the result doesn't depend on the orientation of the target
+    sf::Uint8 alpha[8 * 4];
+    for (int i = 0; i < 8 * 4; ++i)
+        alpha[i] = static_cast<sf::Uint8>((i % 8) * 32);
+
+    sf::Texture texture;
+    sf::RenderTexture spriteTarget;
+    if (!check(texture.create(8, 4, sf::A8) && spriteTarget.create(8, 4), "create an A8 texture and its target"))
+        return false;
+    texture.update(alpha);
+
+    sf::Sprite sprite(texture);
+    sprite.setColor(sf::Color::Green);
+
+    spriteTarget.clear(sf::Color::Black);
+    spriteTarget.draw(sprite, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::Zero));
+    spriteTarget.display();
+
+    sf::Image result = spriteTarget.getTexture().copyToImage();
+    bool green = true;
+    for (unsigned int y = 0; y < 4; ++y)
+    {
+        for (unsigned int x = 0; x < 8; ++x)
+        {
+            sf::Color color = result.getPixel(x, y);
+            if ((color.r != 0) || (color.g != 255) || (color.b != 0) || (color.a != alpha[x]))
+                green = false;
+        }
+    }
+    passed = check(green, "A8 sprites take the color of the vertices") && passed;
+
+    return passed;
+}
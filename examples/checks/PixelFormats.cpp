@@ -0,0 +1,203 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    const sf::PixelFormat formats[] = {sf::RGBA8, sf::RGB8, sf::RGB565, sf::RGBA4444, sf::L8, sf::A8};
+    const char* formatNames[] = {"RGBA8", "RGB8", "RGB565", "RGBA4444", "L8", "A8"};
+    const std::size_t formatCount = sizeof(formats) / sizeof(formats[0]);
+
+    // Size of a pixel, in bytes
+    std::size_t getPixelSize(sf::PixelFormat format)
+    {
+        switch (format)
+        {
+            case sf::RGBA8:    return 4;
+            case sf::RGB8:     return 3;
+            case sf::RGB565:   return 2;
+            case sf::RGBA4444: return 2;
+            default:           return 1;
+        }
+    }
+
+    // Straightforward version of the conversion of an RGBA8 pixel, as documented in PixelFormat.hpp
+    void fromRgba(const sf::Uint8* rgba, sf::PixelFormat format, sf::Uint8* pixel)
+    {
+        sf::Uint16 word;
+        switch (format)
+        {
+            case sf::RGBA8:
+                std::memcpy(pixel, rgba, 4);
+                break;
+
+            case sf::RGB8:
+                std::memcpy(pixel, rgba, 3);
+                break;
+
+            case sf::RGB565:
+                word = static_cast<sf::Uint16>(((rgba[0] >> 3) << 11) | ((rgba[1] >> 2) << 5) | (rgba[2] >> 3));
+                std::memcpy(pixel, &word, 2);
+                break;
+
+            case sf::RGBA4444:
+                word = static_cast<sf::Uint16>(((rgba[0] >> 4) << 12) | ((rgba[1] >> 4) << 8) | ((rgba[2] >> 4) << 4) | (rgba[3] >> 4));
+                std::memcpy(pixel, &word, 2);
+                break;
+
+            case sf::L8:
+                pixel[0] = static_cast<sf::Uint8>((77 * rgba[0] + 150 * rgba[1] + 29 * rgba[2] + 128) >> 8);
+                break;
+
+            case sf::A8:
+                pixel[0] = rgba[3];
+                break;
+        }
+    }
+
+    // Straightforward version of the conversion of a pixel to RGBA8
+    void toRgba(const sf::Uint8* pixel, sf::PixelFormat format, sf::Uint8* rgba)
+    {
+        sf::Uint16 word;
+        switch (format)
+        {
+            case sf::RGBA8:
+                std::memcpy(rgba, pixel, 4);
+                break;
+
+            case sf::RGB8:
+                std::memcpy(rgba, pixel, 3);
+                rgba[3] = 255;
+                break;
+
+            case sf::RGB565:
+                std::memcpy(&word, pixel, 2);
+                rgba[0] = static_cast<sf::Uint8>(((word >> 11) << 3) | (word >> 13));
+                rgba[1] = static_cast<sf::Uint8>((((word >> 5) & 0x3F) << 2) | ((word >> 9) & 0x03));
+                rgba[2] = static_cast<sf::Uint8>(((word & 0x1F) << 3) | ((word >> 2) & 0x07));
+                rgba[3] = 255;
+                break;
+
+            case sf::RGBA4444:
+                std::memcpy(&word, pixel, 2);
+                rgba[0] = static_cast<sf::Uint8>(((word >> 12) & 0xF) * 0x11);
+                rgba[1] = static_cast<sf::Uint8>(((word >> 8) & 0xF) * 0x11);
+                rgba[2] = static_cast<sf::Uint8>(((word >> 4) & 0xF) * 0x11);
+                rgba[3] = static_cast<sf::Uint8>((word & 0xF) * 0x11);
+                break;
+
+            case sf::L8:
+                rgba[0] = rgba[1] = rgba[2] = pixel[0];
+                rgba[3] = 255;
+                break;
+
+            case sf::A8:
+                rgba[0] = rgba[1] = rgba[2] = 255;
+                rgba[3] = pixel[0];
+                break;
+        }
+    }
+
+    // Convert an image with the reference functions
+    std::vector<sf::Uint8> convert(const std::vector<sf::Uint8>& pixels, sf::PixelFormat from, sf::PixelFormat to)
+    {
+        std::size_t count = pixels.size() / getPixelSize(from);
+        std::vector<sf::Uint8> result(count * getPixelSize(to));
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sf::Uint8 rgba[4] = {0, 0, 0, 0};
+            toRgba(&pixels[i * getPixelSize(from)], from, rgba);
+            fromRgba(rgba, to, &result[i * getPixelSize(to)]);
+        }
+
+        return result;
+    }
+
+    // Check that the pixels of an image are the expected ones
+    bool hasPixels(const sf::Image& image, sf::PixelFormat format, const std::vector<sf::Uint8>& pixels)
+    {
+        return (image.getPixelFormat() == format) &&
+               (std::memcmp(image.getPixelsPtr(), &pixels[0], pixels.size()) == 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// Conversions between pixel formats use vectorized code
+/// for most of the pixels, with scalar code for the last
+/// ones; both must follow the documented rules exactly
+///
+////////////////////////////////////////////////////////////
+bool checkPixelFormats()
+{
+    // Odd size, so that the vectorized loops have a remainder
+    const unsigned int width = 67;
+    const unsigned int height = 13;
+
+    std::vector<sf::Uint8> rgba(width * height * 4);
+    unsigned int seed = 12345;
+    for (std::size_t i = 0; i < rgba.size(); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        rgba[i] = static_cast<sf::Uint8>(seed >> 16);
+    }
+
+    bool passed = true;
+
+    for (std::size_t i = 0; i < formatCount; ++i)
+    {
+        std::vector<sf::Uint8> source = convert(rgba, sf::RGBA8, formats[i]);
+
+        sf::Image image;
+        image.create(width, height, &rgba[0]);
+        image.convert(formats[i]);
+        passed = check(hasPixels(image, formats[i], source), std::string("convert from RGBA8 to ") + formatNames[i]) && passed;
+
+        // Each format to each other
+        for (std::size_t j = 0; j < formatCount; ++j)
+        {
+            sf::Image converted;
+            converted.create(width, height, &source[0], formats[i]);
+            converted.convert(formats[j]);
+
+            passed = check(hasPixels(converted, formats[j], convert(source, formats[i], formats[j])),
+                           std::string("convert from ") + formatNames[i] + " to " + formatNames[j]) && passed;
+        }
+
+        // getPixel gives the RGBA8 value of the pixel
+        std::vector<sf::Uint8> expanded = convert(source, formats[i], sf::RGBA8);
+        sf::Color color = image.getPixel(5, 7);
+        const sf::Uint8* expected = &expanded[(5 + 7 * width) * 4];
+        passed = check((color.r == expected[0]) && (color.g == expected[1]) && (color.b == expected[2]) && (color.a == expected[3]),
+                       std::string("read a pixel of a ") + formatNames[i] + " image") && passed;
+
+        // Textures keep the format of the image
+        sf::Texture texture;
+        if (check(texture.loadFromImage(image), std::string("load a ") + formatNames[i] + " texture"))
+        {
+            passed = check(texture.getPixelFormat() == formats[i], std::string("a ") + formatNames[i] + " texture keeps its format") && passed;
+
+            // OpenGL ES can't read luminance and alpha textures back
+#ifdef SFML_OPENGL_ES
+            bool readable = (formats[i] != sf::L8) && (formats[i] != sf::A8);
+#else
+            bool readable = true;
+#endif
+            if (readable)
+                passed = check(hasPixels(texture.copyToImage(), formats[i], source), std::string("read back a ") + formatNames[i] + " texture") && passed;
+        }
+        else
+        {
+            passed = false;
+        }
+    }
+
+    return passed;
+}
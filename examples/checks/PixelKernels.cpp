@@ -0,0 +1,176 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Pseudo-random pixels, with fully transparent and opaque ones mixed in
+    std::vector<sf::Uint8> randomPixels(unsigned int width, unsigned int height, unsigned int seed)
+    {
+        std::vector<sf::Uint8> pixels(width * height * 4);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            pixels[i] = static_cast<sf::Uint8>(seed >> 16);
+            if ((i % 4 == 3) && (seed % 5 == 0))
+                pixels[i] = (seed % 2) ? 255 : 0;
+        }
+
+        return pixels;
+    }
+
+    // Straightforward versions of the pixel operations, with the same
+    // formulas as the scalar code which handles the last pixels of rows
+    sf::Uint8 divide255(unsigned int x)
+    {
+        return static_cast<sf::Uint8>(x / 255);
+    }
+
+    sf::Uint8 round255(unsigned int x)
+    {
+        return static_cast<sf::Uint8>((x + 127) / 255);
+    }
+
+    void blend(sf::Uint8* destination, const sf::Uint8* source)
+    {
+        unsigned int alpha = source[3];
+        destination[0] = divide255(source[0] * alpha + destination[0] * (255 - alpha));
+        destination[1] = divide255(source[1] * alpha + destination[1] * (255 - alpha));
+        destination[2] = divide255(source[2] * alpha + destination[2] * (255 - alpha));
+        destination[3] = divide255(255 * alpha + destination[3] * (255 - alpha));
+    }
+
+    void blendPremultiplied(sf::Uint8* destination, const sf::Uint8* source)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            unsigned int value = source[i] + round255(destination[i] * (255u - source[3]));
+            destination[i] = static_cast<sf::Uint8>(value > 255 ? 255 : value);
+        }
+    }
+
+    void premultiply(sf::Uint8* pixel)
+    {
+        pixel[0] = round255(pixel[0] * pixel[3]);
+        pixel[1] = round255(pixel[1] * pixel[3]);
+        pixel[2] = round255(pixel[2] * pixel[3]);
+    }
+
+    // Check that the pixels of an image are the expected ones
+    bool hasPixels(const sf::Image& image, const std::vector<sf::Uint8>& pixels)
+    {
+        return (image.getSize().x * image.getSize().y * 4 == pixels.size()) &&
+               (std::memcmp(image.getPixelsPtr(), &pixels[0], pixels.size()) == 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// The pixel operations of images process blocks of pixels
+/// with SSE2 or NEON, and the rest of each row with scalar
+/// code; whatever the width, and thus the number of pixels
+/// left to the scalar code, the result must be the same
+///
+////////////////////////////////////////////////////////////
+bool checkPixelKernels()
+{
+    const unsigned int height = 3;
+
+    bool fillPassed               = true;
+    bool maskPassed               = true;
+    bool flipPassed               = true;
+    bool blendPassed              = true;
+    bool blendPremultipliedPassed = true;
+    bool premultiplyPassed        = true;
+
+    // From scalar code only to several blocks with every possible tail, for blocks of 4 and 8 pixels
+    for (unsigned int width = 1; width <= 40; ++width)
+    {
+        std::size_t count = width * height;
+        std::vector<sf::Uint8> source = randomPixels(width, height, width);
+        std::vector<sf::Uint8> destination = randomPixels(width, height, width + 1000);
+
+        // Fill
+        const sf::Uint8 color[4] = {12, 34, 56, 78};
+        std::vector<sf::Uint8> expected(count * 4);
+        for (std::size_t i = 0; i < count; ++i)
+            std::memcpy(&expected[i * 4], color, 4);
+
+        sf::Image image;
+        image.create(width, height, sf::Color(12, 34, 56, 78));
+        fillPassed = hasPixels(image, expected) && fillPassed;
+
+        // Mask, with the color of some of the pixels
+        sf::Color key(source[8], source[9], source[10], source[11]);
+        for (std::size_t i = 0; i < count; i += 3)
+            std::memcpy(&source[i * 4], &source[(i < 2 ? i : 2) * 4], 4);
+
+        expected = source;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if ((expected[i * 4] == key.r) && (expected[i * 4 + 1] == key.g) && (expected[i * 4 + 2] == key.b) && (expected[i * 4 + 3] == key.a))
+                expected[i * 4 + 3] = 99;
+        }
+
+        image.create(width, height, &source[0]);
+        image.createMaskFromColor(key, 99);
+        maskPassed = hasPixels(image, expected) && maskPassed;
+
+        // Horizontal flip
+        for (unsigned int y = 0; y < height; ++y)
+        {
+            for (unsigned int x = 0; x < width; ++x)
+                std::memcpy(&expected[(y * width + x) * 4], &source[(y * width + width - 1 - x) * 4], 4);
+        }
+
+        image.create(width, height, &source[0]);
+        image.flipHorizontally();
+        flipPassed = hasPixels(image, expected) && flipPassed;
+
+        // Alpha blending
+        sf::Image sourceImage;
+        sourceImage.create(width, height, &source[0]);
+
+        expected = destination;
+        for (std::size_t i = 0; i < count; ++i)
+            blend(&expected[i * 4], &source[i * 4]);
+
+        image.create(width, height, &destination[0]);
+        image.copy(sourceImage, 0, 0, sf::IntRect(), true);
+        blendPassed = hasPixels(image, expected) && blendPassed;
+
+        // Premultiplied alpha blending, with saturated sums since the pixels aren't really premultiplied
+        expected = destination;
+        for (std::size_t i = 0; i < count; ++i)
+            blendPremultiplied(&expected[i * 4], &source[i * 4]);
+
+        image.create(width, height, &destination[0]);
+        image.blendPremultiplied(sourceImage, 0, 0);
+        blendPremultipliedPassed = hasPixels(image, expected) && blendPremultipliedPassed;
+
+        // Premultiplication
+        expected = source;
+        for (std::size_t i = 0; i < count; ++i)
+            premultiply(&expected[i * 4]);
+
+        image.create(width, height, &source[0]);
+        image.premultiplyAlpha();
+        premultiplyPassed = hasPixels(image, expected) && premultiplyPassed;
+    }
+
+    bool passed = true;
+    passed = check(fillPassed, "fill an image with a color") && passed;
+    passed = check(maskPassed, "mask a color") && passed;
+    passed = check(flipPassed, "flip an image horizontally") && passed;
+    passed = check(blendPassed, "copy an image with alpha blending") && passed;
+    passed = check(blendPremultipliedPassed, "blend an image with premultiplied alpha") && passed;
+    passed = check(premultiplyPassed, "premultiply the alpha of an image") && passed;
+
+    return passed;
+}
@@ -0,0 +1,124 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+namespace
+{
+    // Read a whole file
+    std::vector<char> readFile(const std::string& filename)
+    {
+        std::ifstream file(filename.c_str(), std::ios_base::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    // Check that two images have the same size and RGBA pixels
+    bool sameImage(const sf::Image& left, const sf::Image& right)
+    {
+        sf::Image leftPixels = left;
+        sf::Image rightPixels = right;
+        leftPixels.convert(sf::RGBA8);
+        rightPixels.convert(sf::RGBA8);
+
+        return (left.getSize() == right.getSize()) &&
+               (std::memcmp(leftPixels.getPixelsPtr(), rightPixels.getPixelsPtr(), left.getSize().x * left.getSize().y * 4) == 0);
+    }
+
+    // Save an image and load it back
+    bool roundTrip(const sf::Image& image, const sf::Image::SaveOptions& options, const std::string& filename)
+    {
+        sf::Image loaded;
+        return image.saveToFile(filename, options) && loaded.loadFromFile(filename) && sameImage(image, loaded);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// The PNG encoder must produce files that decode to the
+/// exact same pixels, whatever the filter and the level of
+/// compression
+///
+////////////////////////////////////////////////////////////
+bool checkPngWriter()
+{
+    const std::string filename = "checks.png";
+    const char* filterNames[] = {"none", "sub", "up", "average", "Paeth", "adaptive"};
+
+    // Smooth gradients, noise and a transparent area, so that every filter is useful somewhere
+    sf::Image image;
+    image.create(123, 45);
+    unsigned int seed = 1;
+    for (unsigned int y = 0; y < image.getSize().y; ++y)
+    {
+        for (unsigned int x = 0; x < image.getSize().x; ++x)
+        {
+            seed = seed * 1103515245 + 12345;
+            sf::Uint8 noise = static_cast<sf::Uint8>(seed >> 16);
+            sf::Uint8 alpha = (x < 20) ? 0 : static_cast<sf::Uint8>(255 - y);
+            image.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 2), static_cast<sf::Uint8>(y * 5), (x > 60) ? noise : 0, alpha));
+        }
+    }
+
+    bool passed = true;
+
+    // Every filter, stored and compressed
+    for (int filter = sf::Image::PngFilterNone; filter <= sf::Image::PngFilterAdaptive; ++filter)
+    {
+        for (unsigned int level = 0; level <= 9; level += 3)
+        {
+            sf::Image::SaveOptions options;
+            options.pngFilter = static_cast<sf::Image::PngFilter>(filter);
+            options.pngCompression = level;
+
+            char description[64];
+            std::sprintf(description, "save with the %s filter at level %u", filterNames[filter], level);
+            passed = check(roundTrip(image, options, filename), description) && passed;
+        }
+    }
+
+    // Compression levels
+    sf::Image::SaveOptions stored;
+    stored.pngCompression = 0;
+    image.saveToFile(filename, stored);
+    std::size_t storedSize = readFile(filename).size();
+
+    sf::Image::SaveOptions best;
+    best.pngCompression = 9;
+    image.saveToFile(filename, best);
+    std::size_t bestSize = readFile(filename).size();
+
+    passed = check(storedSize > image.getSize().x * image.getSize().y * 4, "level 0 stores the pixels") && passed;
+    passed = check(bestSize < storedSize, "level 9 compresses the pixels") && passed;
+
+    // Default options
+    image.saveToFile(filename);
+    std::vector<char> defaultFile = readFile(filename);
+    image.saveToFile(filename, sf::Image::SaveOptions());
+    passed = check(readFile(filename) == defaultFile, "the default options produce the same file as saveToFile without options") && passed;
+
+    // Other pixel formats are saved as RGBA
+    sf::Image grey = image;
+    grey.convert(sf::L8);
+    passed = check(roundTrip(grey, sf::Image::SaveOptions(), filename), "save an L8 image") && passed;
+
+    // Background saves use the pixels at the time of the call
+    sf::Image modified = image;
+    passed = check(modified.saveToFileAsync(filename), "queue a background save") && passed;
+    modified.flipHorizontally();
+    sf::Image::waitForAsyncSaves();
+
+    sf::Image loaded;
+    passed = check(loaded.loadFromFile(filename) && sameImage(image, loaded), "save in the background") && passed;
+
+    std::remove(filename.c_str());
+
+    return passed;
+}
@@ -0,0 +1,121 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+
+namespace
+{
+    // Read a whole file
+    std::vector<char> readFile(const std::string& filename)
+    {
+        std::ifstream file(filename.c_str(), std::ios_base::binary);
+        return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    // Check that an image has the given RGBA pixels
+    bool hasPixels(const sf::Image& image, unsigned int width, unsigned int height, const sf::Uint8* pixels)
+    {
+        return (image.getSize() == sf::Vector2u(width, height)) &&
+               (std::memcmp(image.getPixelsPtr(), pixels, width * height * 4) == 0);
+    }
+
+    // Image written by hand from the specification, with one chunk of each kind
+    const unsigned char specificationFile[] =
+    {
+        'q', 'o', 'i', 'f', 0, 0, 0, 4, 0, 0, 0, 2, 4, 0, // 4x2 pixels, RGBA, sRGB
+        0xFE, 10, 20, 30,                                  // QOI_OP_RGB:   10, 20, 30, 255
+        0xC1,                                              // QOI_OP_RUN:   2 more times
+        0x76,                                              // QOI_OP_DIFF:  +1, -1, +0
+        0xAA, 0xA5,                                        // QOI_OP_LUMA:  green +10, red +12, blue +7
+        0xFF, 200, 100, 50, 128,                           // QOI_OP_RGBA:  200, 100, 50, 128
+        0x09,                                              // QOI_OP_INDEX: 10, 20, 30, 255, at (10*3 + 20*5 + 30*7 + 255*11) % 64
+        0xC0,                                              // QOI_OP_RUN:   1 more time
+        0, 0, 0, 0, 0, 0, 0, 1                             // End marker
+    };
+
+    const sf::Uint8 specificationPixels[] =
+    {
+        10, 20, 30, 255,   10, 20, 30, 255,   10, 20, 30, 255,    11, 19, 30, 255,
+        23, 29, 37, 255,   200, 100, 50, 128, 10, 20, 30, 255,    10, 20, 30, 255
+    };
+}
+
+
+////////////////////////////////////////////////////////////
+/// The QOI decoder must follow the specification, and the
+/// encoder must produce files that decode to the exact same
+/// pixels
+///
+////////////////////////////////////////////////////////////
+bool checkQoi()
+{
+    const std::string filename = "checks.qoi";
+
+    bool passed = true;
+
+    // Decoding a file from another encoder
+    sf::Image decoded;
+    passed = check(decoded.loadFromMemory(specificationFile, sizeof(specificationFile)), "load a QOI file from memory") && passed;
+    passed = check(hasPixels(decoded, 4, 2, specificationPixels), "decode every kind of chunk") && passed;
+
+    sf::Image truncated;
+    passed = check(!truncated.loadFromMemory(specificationFile, 20), "reject a truncated file") && passed;
+
+    // The last chunk of a file cut in the middle of it must not be completed with zeros
+    const unsigned char cutFile[] = {'q', 'o', 'i', 'f', 0, 0, 0, 1, 0, 0, 0, 1, 4, 0, 0xFF, 200, 100};
+    passed = check(!truncated.loadFromMemory(cutFile, sizeof(cutFile)), "reject a file whose last chunk is cut") && passed;
+
+    // Rows producing each kind of chunk
+    const unsigned int width = 150;
+    const unsigned int height = 6;
+    sf::Image image;
+    image.create(width, height);
+    unsigned int seed = 7;
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            seed = seed * 1103515245 + 12345;
+            sf::Uint8 noise = static_cast<sf::Uint8>(seed >> 16);
+
+            sf::Color color;
+            switch (y)
+            {
+                case 0:  color = sf::Color(50, 60, 70);                                 break; // Run longer than a single chunk
+                case 1:  color = sf::Color(x, 255 - x, x / 2);                          break; // Small differences
+                case 2:  color = sf::Color(x * 5, x * 7, x * 3);                        break; // Medium differences
+                case 3:  color = sf::Color((x % 3) * 80, (x % 5) * 50, (x % 2) * 200); break; // Colors seen before
+                case 4:  color = sf::Color(noise, noise ^ 0x55, noise ^ 0xAA);          break; // Unrelated colors
+                default: color = sf::Color(noise, 128, 64, noise);                      break; // Changes of alpha
+            }
+
+            image.setPixel(x, y, color);
+        }
+    }
+
+    const sf::Uint8* pixels = image.getPixelsPtr();
+    passed = check(image.saveToFile(filename), "save a QOI file") && passed;
+
+    std::vector<char> file = readFile(filename);
+    passed = check((file.size() > 22) && (std::memcmp(&file[0], "qoif\0\0\0\x96\0\0\0\x06", 12) == 0), "write the QOI header") && passed;
+    passed = check((file.size() > 22) && (std::memcmp(&file[file.size() - 8], "\0\0\0\0\0\0\0\x01", 8) == 0), "write the end marker") && passed;
+
+    sf::Image loaded;
+    passed = check(loaded.loadFromFile(filename) && hasPixels(loaded, width, height, pixels), "load back a saved QOI file") && passed;
+
+    sf::Image fromMemory;
+    passed = check(!file.empty() && fromMemory.loadFromMemory(&file[0], file.size()) && hasPixels(fromMemory, width, height, pixels),
+                   "load back a saved QOI file from memory") && passed;
+
+    std::remove(filename.c_str());
+
+    return passed;
+}
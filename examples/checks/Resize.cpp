@@ -0,0 +1,179 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    const sf::Image::ResizeFilter filters[] = {sf::Image::Box, sf::Image::Bilinear, sf::Image::Lanczos};
+    const char* filterNames[] = {"box", "bilinear", "Lanczos"};
+
+    // Same fixed point weights as the resampler
+    const int precisionBits = 14;
+
+    double box(double x)
+    {
+        return ((x > -0.5) && (x <= 0.5)) ? 1.0 : 0.0;
+    }
+
+    double bilinear(double x)
+    {
+        x = std::fabs(x);
+        return (x < 1.0) ? 1.0 - x : 0.0;
+    }
+
+    double sinc(double x)
+    {
+        if (x == 0.0)
+            return 1.0;
+
+        x *= 3.14159265358979323846;
+        return std::sin(x) / x;
+    }
+
+    double lanczos(double x)
+    {
+        return ((x > -3.0) && (x < 3.0)) ? sinc(x) * sinc(x / 3.0) : 0.0;
+    }
+
+    // Straightforward version of the resampling along one axis, with the same
+    // weights and rounding as the scalar code of the resampler; pixels are
+    // "step" bytes apart along the axis, and "lines" of them are resampled
+    std::vector<sf::Uint8> resampleAxis(const std::vector<sf::Uint8>& pixels, unsigned int inSize, unsigned int outSize,
+                                        unsigned int lines, bool horizontal, sf::Image::ResizeFilter filter)
+    {
+        double (*kernel)(double) = bilinear;
+        double support = 1.0;
+        switch (filter)
+        {
+            case sf::Image::Box:      kernel = box;      support = 0.5; break;
+            case sf::Image::Bilinear: kernel = bilinear; support = 1.0; break;
+            case sf::Image::Lanczos:  kernel = lanczos;  support = 3.0; break;
+        }
+
+        double scale       = static_cast<double>(inSize) / outSize;
+        double filterScale = std::max(scale, 1.0);
+        support *= filterScale;
+        int stride = static_cast<int>(std::ceil(support)) * 2 + 1;
+
+        std::vector<sf::Uint8> result(outSize * lines * 4);
+        for (unsigned int i = 0; i < outSize; ++i)
+        {
+            double center = (i + 0.5) * scale;
+            int    first  = std::max(static_cast<int>(center - support + 0.5), 0);
+            int    last   = std::min(static_cast<int>(center + support + 0.5), static_cast<int>(inSize));
+            int    count  = std::min(std::max(last - first, 1), stride);
+
+            std::vector<double> weights(count);
+            double total = 0.0;
+            for (int j = 0; j < count; ++j)
+            {
+                weights[j] = kernel((first + j - center + 0.5) / filterScale);
+                total += weights[j];
+            }
+
+            std::vector<int> fixed(count);
+            for (int j = 0; j < count; ++j)
+            {
+                double weight = (total != 0.0) ? weights[j] / total : (j == 0 ? 1.0 : 0.0);
+                fixed[j] = static_cast<int>(std::floor(weight * (1 << precisionBits) + 0.5));
+            }
+
+            for (unsigned int line = 0; line < lines; ++line)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    int sum = 1 << (precisionBits - 1);
+                    for (int j = 0; j < count; ++j)
+                    {
+                        std::size_t index = horizontal ? (line * inSize + first + j) : ((first + j) * lines + line);
+                        sum += pixels[index * 4 + c] * fixed[j];
+                    }
+
+                    sum >>= precisionBits;
+                    std::size_t index = horizontal ? (line * outSize + i) : (i * lines + line);
+                    result[index * 4 + c] = static_cast<sf::Uint8>(sum < 0 ? 0 : (sum > 255 ? 255 : sum));
+                }
+            }
+        }
+
+        return result;
+    }
+
+    // Resample horizontally then vertically, like the resampler
+    std::vector<sf::Uint8> resample(const std::vector<sf::Uint8>& pixels, const sf::Vector2u& from, const sf::Vector2u& to, sf::Image::ResizeFilter filter)
+    {
+        std::vector<sf::Uint8> result = pixels;
+        if (from.x != to.x)
+            result = resampleAxis(result, from.x, to.x, from.y, true, filter);
+        if (from.y != to.y)
+            result = resampleAxis(result, from.y, to.y, to.x, false, filter);
+
+        return result;
+    }
+
+    // Check that the pixels of an image are the expected ones
+    bool hasPixels(const sf::Image& image, const sf::Vector2u& size, const std::vector<sf::Uint8>& pixels)
+    {
+        return (image.getSize() == size) && (std::memcmp(image.getPixelsPtr(), &pixels[0], pixels.size()) == 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// The resampler accumulates several source pixels at once
+/// with SSE2 or NEON, and handles the last pixels of rows
+/// with scalar code; with odd sizes, odd numbers of source
+/// pixels per destination pixel, and both enlarged and
+/// reduced axes, the result must be the same as the
+/// scalar code alone
+///
+////////////////////////////////////////////////////////////
+bool checkResize()
+{
+    const sf::Vector2u source(37, 23);
+    const sf::Vector2u sizes[] =
+    {
+        sf::Vector2u(53, 11), // Enlarged horizontally, reduced vertically
+        sf::Vector2u(18, 41), // Reduced horizontally, enlarged vertically
+        sf::Vector2u(37, 30), // Vertical pass only, on the source rows
+        sf::Vector2u(29, 23), // Horizontal pass only
+        sf::Vector2u(5, 3),   // Fewer pixels than a block
+        sf::Vector2u(113, 70) // Several bands of rows with every thread count
+    };
+
+    std::vector<sf::Uint8> pixels(source.x * source.y * 4);
+    unsigned int seed = 4321;
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        pixels[i] = static_cast<sf::Uint8>(seed >> 16);
+    }
+
+    sf::Image image;
+    image.create(source.x, source.y, &pixels[0]);
+
+    bool passed = true;
+
+    for (std::size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); ++i)
+    {
+        bool filterPassed = true;
+        for (std::size_t j = 0; j < sizeof(sizes) / sizeof(sizes[0]); ++j)
+        {
+            std::vector<sf::Uint8> expected = resample(pixels, source, sizes[j], filters[i]);
+            for (unsigned int threadCount = 1; threadCount <= 4; ++threadCount)
+                filterPassed = hasPixels(image.scaled(sizes[j].x, sizes[j].y, filters[i], threadCount), sizes[j], expected) && filterPassed;
+        }
+
+        passed = check(filterPassed, std::string("resize with the ") + filterNames[i] + " filter") && passed;
+    }
+
+    return passed;
+}
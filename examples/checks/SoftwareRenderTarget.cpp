@@ -0,0 +1,199 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstring>
+
+
+namespace
+{
+    // Pseudo-random numbers which are the same on every platform
+    unsigned int seed = 1;
+    float random(float range)
+    {
+        seed = seed * 1103515245 + 12345;
+        return static_cast<float>((seed >> 8) % 65536) / 65536.f * range;
+    }
+
+    sf::Color randomColor()
+    {
+        return sf::Color(static_cast<sf::Uint8>(random(256)), static_cast<sf::Uint8>(random(256)),
+                         static_cast<sf::Uint8>(random(256)), static_cast<sf::Uint8>(random(256)));
+    }
+
+    // Draw a scene mixing all kinds of primitives, textures and blend modes
+    void drawScene(sf::RenderTarget& target, const sf::VertexArray& triangles, sf::Texture& texture, const sf::Font& font)
+    {
+        target.clear(sf::Color(20, 30, 40));
+
+        // Big triangles partly outside of the target, textured or not, with several blend modes
+        texture.setSmooth(false);
+        target.draw(triangles, sf::RenderStates(&texture));
+        target.draw(triangles, sf::BlendAdd);
+        texture.setSmooth(true);
+        sf::RenderStates states(&texture);
+        states.blendMode = sf::BlendMultiply;
+        target.draw(triangles, states);
+
+        // Shapes with outlines, rotated and with fractional positions
+        sf::CircleShape circle(60.3f);
+        circle.setPosition(100.2f, 80.7f);
+        circle.setFillColor(sf::Color(200, 50, 50, 180));
+        circle.setOutlineThickness(3);
+        circle.setOutlineColor(sf::Color::Yellow);
+        target.draw(circle);
+
+        sf::RectangleShape rectangle(sf::Vector2f(150, 90));
+        rectangle.setPosition(300, 200);
+        rectangle.setRotation(30);
+        rectangle.setFillColor(sf::Color(0, 255, 0, 128));
+        target.draw(rectangle);
+
+        // Lines and points
+        sf::VertexArray lines(sf::Lines);
+        sf::VertexArray points(sf::Points);
+        for (int i = 0; i < 200; ++i)
+        {
+            lines.append(sf::Vertex(sf::Vector2f(random(600), random(400)), randomColor()));
+            points.append(sf::Vertex(sf::Vector2f(random(600), random(400)), randomColor()));
+        }
+        target.draw(lines);
+        target.draw(points);
+
+        // Text
+        sf::Text text("Deterministic rasterization", font, 30);
+        text.setPosition(40, 330);
+        text.setRotation(-5);
+        target.draw(text);
+    }
+
+    // Check that the pixels of two images are the same
+    bool samePixels(const sf::Image& left, const sf::Image& right)
+    {
+        return (left.getSize() == right.getSize()) &&
+               (std::memcmp(left.getPixelsPtr(), right.getPixelsPtr(), left.getSize().x * left.getSize().y * 4) == 0);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// The software rasterizer splits big draws between threads;
+/// the result must be the same pixels whatever the number of
+/// threads, and must follow the rasterization rules of OpenGL
+///
+////////////////////////////////////////////////////////////
+bool checkSoftwareRenderTarget()
+{
+    sf::Font font;
+    if (!check(font.loadFromFile("resources/sansation.ttf"), "load the font"))
+        return false;
+
+    sf::Image checkerboard;
+    checkerboard.create(8, 8);
+    for (unsigned int y = 0; y < 8; ++y)
+    {
+        for (unsigned int x = 0; x < 8; ++x)
+            checkerboard.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 32), static_cast<sf::Uint8>(y * 32), ((x ^ y) & 1) ? 255 : 0));
+    }
+
+    sf::Texture texture;
+    if (!check(texture.loadFromImage(checkerboard), "create the texture"))
+        return false;
+
+    sf::VertexArray triangles(sf::Triangles);
+    for (int i = 0; i < 900; ++i)
+        triangles.append(sf::Vertex(sf::Vector2f(random(800) - 100, random(600) - 100), randomColor(), sf::Vector2f(random(16), random(16))));
+
+    bool passed = true;
+
+    // Same pixels with any number of threads, and when drawing again
+    const unsigned int threadCounts[] = {1, 2, 3, 4, 7, 1};
+    sf::Image reference;
+    for (std::size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); ++i)
+    {
+        sf::SoftwareRenderTarget target;
+        if (!check(target.create(600, 400), "create the software target"))
+            return false;
+
+        target.setThreadCount(threadCounts[i]);
+        unsigned int sceneSeed = seed;
+        drawScene(target, triangles, texture, font);
+        seed = sceneSeed;
+
+        if (i == 0)
+            reference = target.getImage();
+        else
+            passed = check(samePixels(reference, target.getImage()), "the result doesn't depend on the number of threads") && passed;
+    }
+
+    // Pixels on edges shared by two triangles are filled once
+    sf::SoftwareRenderTarget target;
+    target.create(128, 128);
+    target.clear(sf::Color::Transparent);
+
+    sf::VertexArray grid(sf::Triangles);
+    for (int i = 0; i < 12; ++i)
+    {
+        for (int j = 0; j < 12; ++j)
+        {
+            sf::Vector2f topLeft(3.3f + i * 9.77f, 2.1f + j * 10.13f);
+            sf::Vector2f topRight = topLeft + sf::Vector2f(9.77f, 0.f);
+            sf::Vector2f bottomLeft = topLeft + sf::Vector2f(0.f, 10.13f);
+            sf::Vector2f bottomRight = topLeft + sf::Vector2f(9.77f, 10.13f);
+            sf::Color color(0, 0, 0, 20);
+
+            grid.append(sf::Vertex(topLeft, color));
+            grid.append(sf::Vertex(topRight, color));
+            grid.append(sf::Vertex(bottomRight, color));
+            grid.append(sf::Vertex(topLeft, color));
+            grid.append(sf::Vertex(bottomRight, color));
+            grid.append(sf::Vertex(bottomLeft, color));
+        }
+    }
+    target.draw(grid, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::One));
+
+    bool filledOnce = true;
+    for (unsigned int y = 0; y < 128; ++y)
+    {
+        for (unsigned int x = 0; x < 128; ++x)
+        {
+            sf::Uint8 alpha = target.getImage().getPixel(x, y).a;
+            filledOnce = filledOnce && ((alpha == 0) || (alpha == 20));
+        }
+    }
+    passed = check(filledOnce, "shared edges are filled once") && passed;
+
+    // Pixels are filled when their center is covered
+    target.clear(sf::Color::Transparent);
+    sf::RectangleShape rectangle(sf::Vector2f(20.f, 15.f));
+    rectangle.setPosition(10.4f, 20.6f);
+    target.draw(rectangle);
+
+    unsigned int filled = 0;
+    for (unsigned int y = 0; y < 128; ++y)
+    {
+        for (unsigned int x = 0; x < 128; ++x)
+        {
+            if (target.getImage().getPixel(x, y) == sf::Color::White)
+                filled++;
+        }
+    }
+    passed = check((filled == 20 * 15) && (target.getImage().getPixel(10, 21) == sf::Color::White), "pixels whose center is covered are filled") && passed;
+
+    // Updates of a texture are seen by the next draw
+    texture.setSmooth(false);
+    sf::Sprite sprite(texture);
+    sprite.setScale(4, 4);
+    target.draw(sprite);
+    sf::Color before = target.getImage().getPixel(2, 2);
+
+    sf::Image red;
+    red.create(8, 8, sf::Color::Red);
+    texture.update(red);
+    target.draw(sprite);
+    passed = check((before == checkerboard.getPixel(0, 0)) && (target.getImage().getPixel(2, 2) == sf::Color::Red), "draw an updated texture") && passed;
+
+    return passed;
+}
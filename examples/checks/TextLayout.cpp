@@ -0,0 +1,122 @@
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "Checks.hpp"
+#include <SFML/Graphics.hpp>
+#include <sstream>
+
+
+namespace
+{
+    // Draw something alone in a render texture and return the result
+    sf::Image render(sf::RenderTexture& target, const sf::Drawable& drawable, const sf::View& view)
+    {
+        target.setView(view);
+        target.clear(sf::Color::Black);
+        target.draw(drawable);
+        target.display();
+
+        return target.getTexture().copyToImage();
+    }
+
+    // Compare the pixels of two images of the same size
+    bool samePixels(const sf::Image& left, const sf::Image& right)
+    {
+        for (unsigned int y = 0; y < left.getSize().y; ++y)
+        {
+            for (unsigned int x = 0; x < left.getSize().x; ++x)
+            {
+                if (left.getPixel(x, y) != right.getPixel(x, y))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Compare the result of the layout of two texts
+    bool sameLayout(const sf::TextLayout& left, const sf::TextLayout& right)
+    {
+        return (left.getParagraphCount() == right.getParagraphCount()) &&
+               (left.getLineCount() == right.getLineCount()) &&
+               (left.getLocalBounds() == right.getLocalBounds());
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+/// sf::TextLayout must place the glyphs exactly like sf::Text,
+/// and its cached line breaks must stay correct when the
+/// text is edited
+///
+////////////////////////////////////////////////////////////
+bool checkTextLayout()
+{
+    sf::Font font;
+    if (!check(font.loadFromFile("resources/sansation.ttf"), "load the font"))
+        return false;
+
+    sf::RenderTexture target;
+    if (!check(target.create(300, 120), "create the render texture"))
+        return false;
+
+    const unsigned int characterSize = 20;
+    const float lineSpacing = font.getLineSpacing(characterSize);
+    const sf::String string = "First line\nSecond, longer line\n\nFourth";
+
+    bool passed = true;
+
+    // Paragraphs and lines
+    sf::TextLayout layout(font, characterSize);
+    layout.setString(string);
+    passed = check((layout.getParagraphCount() == 4) && (layout.getLineCount() == 4), "one paragraph and one line per line break") && passed;
+    passed = check(layout.getParagraph(1) == "Second, longer line", "paragraphs contain the text between line breaks") && passed;
+    passed = check(layout.getLocalBounds().height == 4 * lineSpacing, "the height is the number of lines times the line spacing") && passed;
+
+    bool linesSpaced = true;
+    for (std::size_t i = 0; i < layout.getLineCount(); ++i)
+        linesSpaced = linesSpaced && (layout.getLineTop(i) == i * lineSpacing);
+    passed = check(linesSpaced, "lines are separated by the line spacing") && passed;
+
+    // Same glyphs as sf::Text
+    sf::Text text(string, font, characterSize);
+    sf::View view = target.getDefaultView();
+    passed = check(samePixels(render(target, layout, view), render(target, text, view)), "the layout is drawn like sf::Text") && passed;
+
+    // Word wrapping
+    const float wrapWidth = 100.f;
+    layout.setWrapWidth(wrapWidth);
+    passed = check(layout.getLineCount() > layout.getParagraphCount(), "long paragraphs are wrapped") && passed;
+    passed = check(layout.getLocalBounds().width <= wrapWidth, "wrapped lines fit in the wrap width") && passed;
+
+    layout.setParagraph(3, "AVeryLongWordWithoutAnyWhitespaceInIt");
+    passed = check(layout.getLocalBounds().width <= wrapWidth, "words longer than the wrap width are broken") && passed;
+
+    // Editing gives the same result as laying out the final text from scratch
+    layout.appendParagraph("Fifth\nSixth, which is long enough to be wrapped");
+    layout.insertParagraph(1, "Inserted");
+    layout.removeParagraphs(2, 2);
+    layout.setParagraph(0, "First line, edited");
+
+    sf::TextLayout fresh(font, characterSize);
+    fresh.setWrapWidth(wrapWidth);
+    fresh.setString("First line, edited\nInserted\nAVeryLongWordWithoutAnyWhitespaceInIt\nFifth\nSixth, which is long enough to be wrapped");
+    passed = check(sameLayout(layout, fresh), "edited paragraphs are laid out again") && passed;
+    passed = check(samePixels(render(target, layout, view), render(target, fresh, view)), "edited text is drawn like the same text laid out at once") && passed;
+
+    // Only the visible lines of a long document are drawn, at the right place
+    std::ostringstream document;
+    for (int i = 0; i < 1000; ++i)
+        document << "Line number " << i << "\n";
+    sf::TextLayout log(font, characterSize);
+    log.setString(document.str());
+
+    sf::Text visible("Line number 500\nLine number 501\nLine number 502\nLine number 503\nLine number 504\nLine number 505", font, characterSize);
+    visible.setPosition(0, log.getLineTop(500));
+    sf::View scrolled = view;
+    scrolled.move(0, log.getLineTop(500));
+    passed = check(samePixels(render(target, log, scrolled), render(target, visible, scrolled)), "the visible part of a long document is drawn correctly") && passed;
+
+    return passed;
+}
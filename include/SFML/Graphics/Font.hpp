@@ -197,6 +197,33 @@ public:
     ////////////////////////////////////////////////////////////
     float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a set of glyphs in advance, using several threads
+    ///
+    /// Rasterizing glyphs is the most expensive part of rendering
+    /// text for the first time. This function rasterizes all the
+    /// requested glyphs on \a threadCount worker threads, each one
+    /// working on its own FreeType face, and then packs and uploads
+    /// them to the glyph page of the calling thread. Glyphs which
+    /// are already loaded are skipped.
+    ///
+    /// Parallel rasterization is only possible for fonts loaded
+    /// from a file or from memory; fonts loaded from a stream are
+    /// loaded sequentially on the calling thread.
+    ///
+    /// \param characters       Characters to load
+    /// \param characterSize    Reference character size
+    /// \param bold             Load the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyphs will not be filled)
+    /// \param threadCount      Number of worker threads to use
+    ///
+    /// \return True if the glyphs were loaded, false if the font is not loaded
+    ///
+    /// \see getGlyph
+    ///
+    ////////////////////////////////////////////////////////////
+    bool preloadGlyphs(const String& characters, unsigned int characterSize, bool bold = false, float outlineThickness = 0, unsigned int threadCount = 4) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the line spacing
     ///
@@ -246,6 +273,12 @@ public:
     /// are requested, thus it is not very relevant. It is mainly
     /// used internally by sf::Text.
     ///
+    /// The texture is white, with the coverage of the glyphs as
+    /// alpha, so its color is taken from the vertices when it is
+    /// drawn. It is an A8 texture (one byte per pixel), see
+    /// Texture::create for how shaders sample it; copying it to an
+    /// image reads the copy of its pixels kept by the font.
+    ///
     /// \param characterSize Reference character size
     ///
     /// \return Texture containing the glyphs of the requested size
@@ -253,6 +286,44 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture(unsigned int characterSize) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the loaded glyphs to a cache file
+    ///
+    /// The cache file contains the glyph pages of all the character
+    /// sizes used so far: the pixels of their texture, the metrics
+    /// of their glyphs and the kerning values already computed.
+    /// Giving it to loadGlyphCache the next time the same font is
+    /// loaded skips rasterizing these glyphs again.
+    ///
+    /// \param filename Path of the cache file to write
+    ///
+    /// \return True if saving succeeded, false if it failed
+    ///
+    /// \see loadGlyphCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveGlyphCache(const std::string& filename) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load glyphs from a cache file
+    ///
+    /// This function must be called after the font is loaded.
+    /// Each page stored in the cache replaces the page of the
+    /// same character size, and its texture is created with a
+    /// single upload. The file is rejected if it was saved for a
+    /// different font, with a different version of the cache
+    /// format or of FreeType, or on a platform with a different
+    /// byte order.
+    ///
+    /// \param filename Path of the cache file to read
+    ///
+    /// \return True if loading succeeded, false if it failed
+    ///
+    /// \see saveGlyphCache
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadGlyphCache(const std::string& filename);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -281,7 +352,8 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+    typedef std::map<Uint64, Glyph> GlyphTable;   ///< Table mapping a codepoint to its glyph
+    typedef std::map<Uint64, float> KerningTable; ///< Table mapping a pair of codepoints to their kerning offset
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -290,13 +362,37 @@ private:
     struct Page
     {
         Page();
+        Page(const Page& copy);
+
+        GlyphTable         glyphs;  ///< Table mapping code points to their corresponding glyph
+        KerningTable       kerning; ///< Table caching the kerning offsets of the pairs already requested
+        Texture            texture; ///< Texture containing the pixels of the glyphs (white, with the coverage as alpha)
+        unsigned int       nextRow; ///< Y position of the next new row in the texture
+        std::vector<Row>   rows;    ///< List containing the position of all the existing rows
+        std::vector<Uint8> pixels;  ///< Copy of the texture's pixels (one alpha byte per pixel), to grow, copy and save the page
+    };
 
-        GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
-        Texture          texture; ///< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; ///< Y position of the next new row in the texture
-        std::vector<Row> rows;    ///< List containing the position of all the existing rows
+    ////////////////////////////////////////////////////////////
+    /// \brief Structure holding a rasterized glyph before it is packed into a page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphBitmap
+    {
+        GlyphBitmap() : width(0), height(0), outlineFailed(false) {}
+
+        Glyph              glyph;         ///< Metrics of the glyph (its texture rectangle is not assigned yet)
+        unsigned int       width;         ///< Width of the bitmap, in pixels
+        unsigned int       height;        ///< Height of the bitmap, in pixels
+        std::vector<Uint8> pixels;        ///< Coverage of the glyph, one byte per pixel
+        bool               outlineFailed; ///< Was an outline requested for a glyph that can't be outlined?
     };
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Work shared with a glyph rasterization thread
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Free all the internal resources
     ///
@@ -316,6 +412,52 @@ private:
     ////////////////////////////////////////////////////////////
     Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize a glyph with the given FreeType objects
+    ///
+    /// This function doesn't access any member of the font, nor
+    /// write errors to sf::err() (they are recorded in \a bitmap),
+    /// so it can safely be called from a worker thread as long
+    /// as the FreeType objects are owned by that thread.
+    ///
+    /// \param library          FreeType library (FT_Library)
+    /// \param face             FreeType face, already set to the requested size (FT_Face)
+    /// \param stroker          FreeType stroker (FT_Stroker)
+    /// \param codePoint        Unicode code point of the character to rasterize
+    /// \param bold             Rasterize the bold version or the regular one?
+    /// \param outlineThickness Thickness of outline (when != 0 the glyph will not be filled)
+    /// \param bitmap           Rasterized glyph to fill
+    ///
+    /// \return True on success, false if the glyph couldn't be loaded
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool rasterizeGlyph(void* library, void* face, void* stroker, Uint32 codePoint, bool bold, float outlineThickness, GlyphBitmap& bitmap);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the glyphs of a batch (worker thread entry point)
+    ///
+    /// \param batch Batch of glyphs to rasterize
+    ///
+    ////////////////////////////////////////////////////////////
+    static void rasterizeGlyphBatch(GlyphBatch* batch);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pack a rasterized glyph into a page
+    ///
+    /// The glyph is always written to the pixels of the page; if
+    /// \a upload is false, it is up to the caller to upload them
+    /// to the texture. Errors recorded while rasterizing the glyph
+    /// are reported here, on the thread which owns the font.
+    ///
+    /// \param page   Page of glyphs to insert the glyph into
+    /// \param bitmap Rasterized glyph
+    /// \param upload Upload the glyph to the texture immediately?
+    ///
+    /// \return The glyph, with its texture rectangle assigned
+    ///
+    ////////////////////////////////////////////////////////////
+    Glyph placeGlyph(Page& page, const GlyphBitmap& bitmap, bool upload) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Find a suitable rectangle within the texture for a glyph
     ///
@@ -354,6 +496,9 @@ private:
     Info                       m_info;        ///< Information about the font
     mutable PageTable          m_pages;       ///< Table containing the glyphs pages by character size
     mutable std::vector<Uint8> m_pixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
+    std::string                m_sourceFile;  ///< Path of the font file, if the font was loaded from a file
+    const void*                m_sourceData;  ///< Pointer to the font data, if the font was loaded from memory
+    std::size_t                m_sourceSize;  ///< Size of the font data, if the font was loaded from memory
     #ifdef SFML_SYSTEM_ANDROID
     void*                      m_stream; ///< Asset file streamer (if loaded from file)
     #endif
@@ -30,6 +30,8 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <string>
 #include <vector>
@@ -39,6 +41,11 @@ namespace sf
 {
 class InputStream;
 
+namespace priv
+{
+    class ImageStorage;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Class for loading, manipulating and saving images
 ///
@@ -47,6 +54,83 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters available to resize an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResizeFilter
+    {
+        Box,      ///< Average of the covered pixels, nearest neighbor when enlarging (fastest)
+        Bilinear, ///< Linear interpolation, good for moderate scaling
+        Lanczos   ///< Lanczos-3 windowed sinc, sharpest result (slowest)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Row filters of the PNG encoder
+    ///
+    ////////////////////////////////////////////////////////////
+    enum PngFilter
+    {
+        PngFilterNone,    ///< No filtering (fastest)
+        PngFilterSub,     ///< Difference with the pixel on the left
+        PngFilterUp,      ///< Difference with the pixel above, cheap and effective on most images
+        PngFilterAverage, ///< Difference with the average of the pixels on the left and above
+        PngFilterPaeth,   ///< Difference with the Paeth predictor of the neighbor pixels
+        PngFilterAdaptive ///< Best filter chosen for each row (smallest files, slowest)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Chroma subsampling of the JPEG encoder
+    ///
+    ////////////////////////////////////////////////////////////
+    enum JpegSubsampling
+    {
+        Subsampling444, ///< Full resolution colors (best quality)
+        Subsampling422, ///< Colors at half horizontal resolution
+        Subsampling420  ///< Colors at half resolution in both directions (smallest files)
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Options of the encoders used to save images
+    ///
+    /// The default options produce the same files as saveToFile
+    /// without options.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SaveOptions
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        ////////////////////////////////////////////////////////////
+        SaveOptions() :
+        pngCompression (6),
+        pngFilter      (PngFilterAdaptive),
+        jpegQuality    (90),
+        jpegSubsampling(Subsampling420)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int    pngCompression;  ///< PNG compression level, from 0 (no compression, fastest) to 9 (smallest files)
+        PngFilter       pngFilter;       ///< Row filter of the PNG encoder
+        unsigned int    jpegQuality;     ///< JPEG quality, from 1 (smallest files) to 100 (best quality)
+        JpegSubsampling jpegSubsampling; ///< Chroma subsampling of the JPEG encoder
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Function called by loadBatch for each image
+    ///
+    /// \param index    Index of the image in the batch
+    /// \param image    Loaded image, empty if loading failed
+    /// \param success  True if the image was loaded successfully
+    /// \param userData User pointer passed to loadBatch
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef void (*BatchCallback)(std::size_t index, Image& image, bool success, void* userData);
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -55,6 +139,17 @@ public:
     ////////////////////////////////////////////////////////////
     Image();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy constructor
+    ///
+    /// The pixels are not copied: both images share them until
+    /// one of the two is modified.
+    ///
+    /// \param copy Instance to copy
+    ///
+    ////////////////////////////////////////////////////////////
+    Image(const Image& copy);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -67,31 +162,34 @@ public:
     /// \param width  Width of the image
     /// \param height Height of the image
     /// \param color  Fill color
+    /// \param format Format of the pixels stored by the image
     ///
     ////////////////////////////////////////////////////////////
-    void create(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0));
+    void create(unsigned int width, unsigned int height, const Color& color = Color(0, 0, 0), PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Create the image from an array of pixels
     ///
-    /// The \a pixel array is assumed to contain 32-bits RGBA pixels,
-    /// and have the given \a width and \a height. If not, this is
+    /// The \a pixel array is assumed to contain pixels of the
+    /// given \a format (32-bits RGBA pixels by default), and have
+    /// the given \a width and \a height. If not, this is
     /// an undefined behavior.
     /// If \a pixels is null, an empty image is created.
     ///
     /// \param width  Width of the image
     /// \param height Height of the image
     /// \param pixels Array of pixels to copy to the image
+    /// \param format Format of the pixels
     ///
     ////////////////////////////////////////////////////////////
-    void create(unsigned int width, unsigned int height, const Uint8* pixels);
+    void create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not
+    /// supported, like 16-bit png.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
@@ -103,12 +201,34 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromFile(const std::string& filename);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the image from a file on disk, reduced towards a target size
+    ///
+    /// JPEG images are downscaled while they are decoded, by
+    /// 1/2, 1/4 or 1/8: the smallest of these sizes that is
+    /// still at least as large as \a targetSize is kept, which
+    /// is much faster than decoding the full image and resizing
+    /// it. Call resize afterwards to get an exact size. Other
+    /// formats are loaded at their full size. A zero component
+    /// of \a targetSize doesn't constrain that dimension.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param filename   Path of the image file to load
+    /// \param targetSize Smallest size wanted for the image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see resize
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename, const Vector2u& targetSize);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file in memory
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not
+    /// supported, like 16-bit png.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param data Pointer to the file data in memory
@@ -121,12 +241,27 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromMemory(const void* data, std::size_t size);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the image from a file in memory, reduced towards a target size
+    ///
+    /// See loadFromFile for the meaning of \a targetSize.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param data       Pointer to the file data in memory
+    /// \param size       Size of the data to load, in bytes
+    /// \param targetSize Smallest size wanted for the image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t size, const Vector2u& targetSize);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a custom stream
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
-    /// like progressive jpeg.
+    /// psd, hdr, pic and qoi. Some format options are not
+    /// supported, like 16-bit png.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
@@ -138,12 +273,56 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromStream(InputStream& stream);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the image from a custom stream, reduced towards a target size
+    ///
+    /// See loadFromFile for the meaning of \a targetSize.
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param stream     Source stream to read from
+    /// \param targetSize Smallest size wanted for the image, in pixels
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, const Vector2u& targetSize);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several image files in parallel
+    ///
+    /// The files are decoded by up to \a threadCount threads,
+    /// the calling thread included. \a images is resized to
+    /// the number of files, and each image is loaded as with
+    /// loadFromFile; the images that fail to load are left
+    /// empty, and the reason is written to sf::err() for each
+    /// of them.
+    ///
+    /// If \a callback is not null, it is called on the calling
+    /// thread for every image, as soon as possible after it is
+    /// decoded, so that it can already be uploaded to a texture
+    /// while the other files are still being loaded. The images
+    /// are not reported in any particular order.
+    ///
+    /// \param filenames   Paths of the image files to load
+    /// \param images      Array that receives the loaded images
+    /// \param threadCount Maximum number of threads to use
+    /// \param callback    Function called for each image, or null
+    /// \param userData    User pointer passed to \a callback
+    ///
+    /// \return Number of images loaded successfully
+    ///
+    /// \see loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t loadBatch(const std::vector<std::string>& filenames, std::vector<Image>& images, unsigned int threadCount = 4,
+                                 BatchCallback callback = NULL, void* userData = NULL);
+
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
     ///
     /// The format of the image is automatically deduced from
     /// the extension. The supported image formats are bmp, png,
-    /// tga and jpg. The destination file is overwritten
+    /// tga, jpg and qoi. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
     ///
     /// \param filename Path of the file to save
@@ -155,6 +334,54 @@ public:
     ////////////////////////////////////////////////////////////
     bool saveToFile(const std::string& filename) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a file on disk, with encoder options
+    ///
+    /// Lower PNG compression levels and simpler PNG filters
+    /// trade file size for speed, which matters for frequent
+    /// captures on slow devices.
+    ///
+    /// \param filename Path of the file to save
+    /// \param options  Options of the encoder
+    ///
+    /// \return True if saving was successful
+    ///
+    /// \see saveToFileAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFile(const std::string& filename, const SaveOptions& options) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save the image to a file on disk, in the background
+    ///
+    /// The pixels are copied and the file is encoded and written
+    /// by a background thread, so that the caller isn't blocked.
+    /// The saves are processed in the order they are requested,
+    /// and errors are written to sf::err(). The image can be
+    /// modified or destroyed as soon as the function returns.
+    /// Pending saves are completed before the program exits.
+    ///
+    /// \param filename Path of the file to save
+    /// \param options  Options of the encoder
+    ///
+    /// \return True if the save was queued, false if the image is empty
+    ///
+    /// \see saveToFile, waitForAsyncSaves
+    ///
+    ////////////////////////////////////////////////////////////
+    bool saveToFileAsync(const std::string& filename, const SaveOptions& options = SaveOptions()) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Wait until the background saves are finished
+    ///
+    /// This function returns once no save is queued or in
+    /// progress, and can be called by several threads at once.
+    ///
+    /// \see saveToFileAsync
+    ///
+    ////////////////////////////////////////////////////////////
+    static void waitForAsyncSaves();
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
     ///
@@ -163,12 +390,41 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the pixels stored by the image
+    ///
+    /// Images are loaded as RGBA8. A texture loaded from an image
+    /// keeps its format, so that smaller formats also reduce the
+    /// video memory and the bandwidth used to upload the pixels.
+    ///
+    /// \return Format of the pixels
+    ///
+    /// \see convert
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the pixels to another format
+    ///
+    /// Converting to a format with fewer bits loses the low bits
+    /// of each component; converting back to RGBA8 then gives
+    /// the closest color of the smaller format.
+    ///
+    /// \param format New format of the pixels
+    ///
+    /// \see getPixelFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    void convert(PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a transparency mask from a specified color-key
     ///
     /// This function sets the alpha value of every pixel matching
     /// the given color to \a alpha (0 by default), so that they
-    /// become transparent.
+    /// become transparent. It has no effect on formats without
+    /// alpha.
     ///
     /// \param color Color to make transparent
     /// \param alpha Alpha value to assign to transparent pixels
@@ -179,7 +435,7 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Copy pixels from another image onto this one
     ///
-    /// This function does a slow pixel copy and should not be
+    /// This function copies pixels on the CPU and should not be
     /// used intensively. It can be used to prepare a complex
     /// static image from several others, but if you need this
     /// kind of feature in real-time you'd better use sf::RenderTexture.
@@ -189,6 +445,8 @@ public:
     /// source pixels is applied. If it is false, the pixels are
     /// copied unchanged with their alpha value.
     ///
+    /// Pixels are converted if the source image has another format.
+    ///
     /// \param source     Source image to copy
     /// \param destX      X coordinate of the destination position
     /// \param destY      Y coordinate of the destination position
@@ -198,6 +456,57 @@ public:
     ////////////////////////////////////////////////////////////
     void copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0), bool applyAlpha = false);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy pixels from a view onto this image
+    ///
+    /// This is the same as the other overload, but the source
+    /// can be any rectangle of pixels, for example a frame of a
+    /// sprite sheet, without extracting it to an image first.
+    ///
+    /// \param source     View of the pixels to copy
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param applyAlpha Should the copy take into account the source transparency?
+    ///
+    ////////////////////////////////////////////////////////////
+    void copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Blend pixels with premultiplied alpha from another image onto this one
+    ///
+    /// Both images must contain premultiplied colors (see
+    /// premultiplyAlpha). Each destination pixel becomes
+    /// source + destination * (1 - source alpha), which is
+    /// the "over" operator used to composite layers.
+    ///
+    /// If \a sourceRect is empty, the whole image is blended.
+    /// Pixels are converted if the source image has another format.
+    ///
+    /// \param source     Source image to blend
+    /// \param destX      X coordinate of the destination position
+    /// \param destY      Y coordinate of the destination position
+    /// \param sourceRect Sub-rectangle of the source image to blend
+    ///
+    /// \see premultiplyAlpha, copy
+    ///
+    ////////////////////////////////////////////////////////////
+    void blendPremultiplied(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect = IntRect(0, 0, 0, 0));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert the pixels to premultiplied alpha
+    ///
+    /// The red, green and blue components of each pixel are
+    /// multiplied by its alpha. Premultiplied images can be
+    /// composited with blendPremultiplied, and drawn with
+    /// a blend mode of sf::BlendMode(sf::BlendMode::One,
+    /// sf::BlendMode::OneMinusSrcAlpha) once uploaded.
+    /// Formats without alpha are left unchanged.
+    ///
+    /// \see blendPremultiplied
+    ///
+    ////////////////////////////////////////////////////////////
+    void premultiplyAlpha();
+
     ////////////////////////////////////////////////////////////
     /// \brief Change the color of a pixel
     ///
@@ -234,9 +543,11 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get a read-only pointer to the array of pixels
     ///
-    /// The returned value points to an array of RGBA pixels made of
-    /// 8 bits integers components. The size of the array is
-    /// width * height * 4 (getSize().x * getSize().y * 4).
+    /// The returned value points to an array of pixels in the format
+    /// of the image (see getPixelFormat), which are RGBA pixels made
+    /// of 8 bits integers components by default. The size of the
+    /// array is width * height * the size of a pixel, i.e.
+    /// getSize().x * getSize().y * 4 for RGBA8.
     /// Warning: the returned pointer may become invalid if you
     /// modify the image, so you should never store it for too long.
     /// If the image is empty, a null pointer is returned.
@@ -258,15 +569,92 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Resize the image
+    ///
+    /// The image is resampled with the given filter; when
+    /// reducing it, all the source pixels contribute to the
+    /// result, so that no detail is skipped. For images with
+    /// transparent areas, call premultiplyAlpha first to
+    /// avoid colored fringes along the edges. Images in other
+    /// formats than RGBA8 are resampled in RGBA8 and converted
+    /// back.
+    ///
+    /// The work is split across \a threadCount threads, each
+    /// one producing a band of rows.
+    ///
+    /// \param width       New width of the image, in pixels
+    /// \param height      New height of the image, in pixels
+    /// \param filter      Resampling filter
+    /// \param threadCount Maximum number of threads to use
+    ///
+    /// \see scaled
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(unsigned int width, unsigned int height, ResizeFilter filter = Bilinear, unsigned int threadCount = 4);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a resized copy of the image
+    ///
+    /// The pixels are resampled directly into the returned image,
+    /// this one is left unchanged. See resize for details.
+    ///
+    /// \param width       Width of the new image, in pixels
+    /// \param height      Height of the new image, in pixels
+    /// \param filter      Resampling filter
+    /// \param threadCount Maximum number of threads to use
+    ///
+    /// \return Resized image
+    ///
+    /// \see resize
+    ///
+    ////////////////////////////////////////////////////////////
+    Image scaled(unsigned int width, unsigned int height, ResizeFilter filter = Bilinear, unsigned int threadCount = 4) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Overload of assignment operator
+    ///
+    /// The pixels are shared, like with the copy constructor.
+    ///
+    /// \param right Instance to assign
+    ///
+    /// \return Reference to self
+    ///
+    ////////////////////////////////////////////////////////////
+    Image& operator =(const Image& right);
+
 private:
 
+    friend class SoftwareRenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure that the pixels are not shared with another image
+    ///
+    /// This function must be called before modifying the pixels;
+    /// it copies them if they are shared.
+    ///
+    ////////////////////////////////////////////////////////////
+    void detach();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the pixels of the image
+    ///
+    /// The new pixels are swapped in, \a pixels receives garbage.
+    /// If \a pixels is empty, the image no longer has a storage.
+    ///
+    /// \param pixels New pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void commitPixels(std::vector<Uint8>& pixels);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u           m_size;   ///< Image size
-    std::vector<Uint8> m_pixels; ///< Pixels of the image
+    Vector2u            m_size;    ///< Image size
+    PixelFormat         m_format;  ///< Format of the pixels
+    priv::ImageStorage* m_storage; ///< Pixels of the image, shared with its copies (NULL if the image is empty)
     #ifdef SFML_SYSTEM_ANDROID
-    void*              m_stream; ///< Asset file streamer (if loaded from file)
+    void*               m_stream;  ///< Asset file streamer (if loaded from file)
     #endif
 };
 
@@ -294,9 +682,10 @@ private:
 /// functions (such as loadFromMemory) must use this
 /// representation as well.
 ///
-/// A sf::Image can be copied, but it is a heavy resource and
-/// if possible you should always use [const] references to
-/// pass or return them to avoid useless copies.
+/// Copying a sf::Image is cheap: the copies share the same
+/// pixels, which are only duplicated when one of them is
+/// modified (copy-on-write). Use sf::ImageView to work on a
+/// part of an image without copying it.
 ///
 /// Usage example:
 /// \code
@@ -322,6 +711,6 @@ private:
 ///     return -1;
 /// \endcode
 ///
-/// \see sf::Texture
+/// \see sf::Texture, sf::ImageView
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_IMAGEVIEW_HPP
+#define SFML_IMAGEVIEW_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+class Image;
+
+////////////////////////////////////////////////////////////
+/// \brief Read-only view onto a rectangle of pixels that
+///        belong to someone else
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageView
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty view.
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a whole image
+    ///
+    /// This constructor is not explicit, so that images can be
+    /// passed directly to the functions that take a view.
+    ///
+    /// \param image Image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of a rectangle of an image
+    ///
+    /// The area is clipped to the bounds of the image. If it
+    /// is empty, the view covers the whole image.
+    ///
+    /// \param image Image to view
+    /// \param area  Area of the image to view
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Image& image, const IntRect& area);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a view of an array of pixels
+    ///
+    /// \param pixels Pointer to the first pixel of the view
+    /// \param width  Width of the view, in pixels
+    /// \param height Height of the view, in pixels
+    /// \param format Format of the pixels
+    /// \param stride Number of bytes between the starts of two
+    ///               rows, or 0 if the rows are contiguous
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView(const Uint8* pixels, unsigned int width, unsigned int height, PixelFormat format = RGBA8, std::size_t stride = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a view of a rectangle of this view
+    ///
+    /// The area is relative to this view, and clipped to its
+    /// bounds. If it is empty, the whole view is returned.
+    ///
+    /// \param area Area to view
+    ///
+    /// \return View of the area, sharing the same pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageView getSubView(const IntRect& area) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the first pixel of the view
+    ///
+    /// \return Pointer to the first pixel, or a null pointer if the view is empty
+    ///
+    ////////////////////////////////////////////////////////////
+    const Uint8* getPixelsPtr() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the view
+    ///
+    /// \return Size of the view, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of bytes between the starts of two rows
+    ///
+    /// \return Stride of the view, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the pixels
+    ///
+    /// \return Pixel format
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const Uint8* m_pixels; ///< First pixel of the view
+    Vector2u     m_size;   ///< Size of the view
+    std::size_t  m_stride; ///< Number of bytes between the starts of two rows
+    PixelFormat  m_format; ///< Format of the pixels
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGEVIEW_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageView
+/// \ingroup graphics
+///
+/// sf::ImageView describes a rectangle of pixels without
+/// owning them: a pointer to the first pixel, a size, a
+/// stride and a pixel format. Creating or copying a view
+/// never copies pixels, which makes it a cheap way to pass
+/// a part of an image -- a frame of a sprite sheet, a tile
+/// of an atlas -- to sf::Image::copy or sf::Texture.
+///
+/// A view doesn't keep its pixels alive: it is only valid
+/// as long as the image (or array) that it looks at exists
+/// and is not modified, just like the pointer returned by
+/// sf::Image::getPixelsPtr.
+///
+/// Usage example:
+/// \code
+/// sf::Image sheet;
+/// if (!sheet.loadFromFile("sheet.png"))
+///     return -1;
+///
+/// // Upload the second frame of the sheet, without copying it first
+/// sf::Texture frame;
+/// frame.loadFromImage(sf::ImageView(sheet, sf::IntRect(32, 0, 32, 32)));
+///
+/// // Copy the first frame into another image
+/// sf::Image thumbnail;
+/// thumbnail.create(32, 32);
+/// thumbnail.copy(sf::ImageView(sheet, sf::IntRect(0, 0, 32, 32)), 0, 0);
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_LARGETEXTURE_HPP
+#define SFML_LARGETEXTURE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <string>
+#include <vector>
+
+
+namespace sf
+{
+class InputStream;
+class RenderTarget;
+
+////////////////////////////////////////////////////////////
+/// \brief Image split into a grid of textures, to display
+///        images bigger than the maximum texture size
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API LargeTexture : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    LargeTexture();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a file on disk
+    ///
+    /// See loadFromImage for details.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param tileSize Size of the tiles, in pixels (0 for the default size)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromMemory, loadFromStream, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromFile(const std::string& filename, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a file in memory
+    ///
+    /// See loadFromImage for details.
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param size     Size of the data to load, in bytes
+    /// \param tileSize Size of the tiles, in pixels (0 for the default size)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromStream, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromMemory(const void* data, std::size_t size, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a custom stream
+    ///
+    /// See loadFromImage for details.
+    ///
+    /// \param stream   Source stream to read from
+    /// \param tileSize Size of the tiles, in pixels (0 for the default size)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromMemory, loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromStream(InputStream& stream, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an image
+    ///
+    /// The image is split into square tiles of \a tileSize pixels
+    /// (the tiles of the last row and column may be smaller).
+    /// Nothing is uploaded yet: each tile is uploaded the first
+    /// time it is visible, or when upload is called.
+    ///
+    /// The texture keeps a copy of the image to upload the tiles,
+    /// which is cheap since copies of an image share their pixels.
+    ///
+    /// The tile size is clamped to the maximum texture size.
+    /// The default size, 512, is a good balance between the
+    /// number of draw calls and the precision of the culling.
+    ///
+    /// \param image    Image to load into the texture
+    /// \param tileSize Size of the tiles, in pixels (0 for the default size)
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromFile, loadFromMemory, loadFromStream
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const Image& image, unsigned int tileSize = 0);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the texture
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the tiles
+    ///
+    /// \return Size of the tiles, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable the smooth filter of the tiles
+    ///
+    /// The tiles overlap by one pixel, so that there is no
+    /// visible seam between them when the filter is enabled.
+    /// The smooth filter is disabled by default.
+    ///
+    /// \param smooth True to enable smoothing, false to disable it
+    ///
+    /// \see isSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setSmooth(bool smooth);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the smooth filter is enabled or not
+    ///
+    /// \return True if smoothing is enabled, false if it is disabled
+    ///
+    /// \see setSmooth
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isSmooth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of tiles uploaded per draw
+    ///
+    /// Uploading many tiles at once, for example when the view
+    /// jumps to another part of the texture, can stall a frame.
+    /// With a limit, the missing tiles are uploaded progressively
+    /// over the next draws and are not displayed until then.
+    /// The default value is 0, which means no limit.
+    ///
+    /// \param count Maximum number of tiles uploaded per draw (0 for no limit)
+    ///
+    /// \see getUploadLimit, upload
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUploadLimit(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of tiles uploaded per draw
+    ///
+    /// \return Maximum number of tiles uploaded per draw (0 for no limit)
+    ///
+    /// \see setUploadLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getUploadLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of tiles kept in video memory
+    ///
+    /// Above the limit, the tiles that haven't been drawn for
+    /// the longest time are destroyed; they are uploaded again
+    /// if they become visible. This bounds the
+    /// video memory used by the texture to about count * tile
+    /// size * tile size * pixel size bytes. The tiles drawn by
+    /// the current draw are never evicted, so the limit can be
+    /// exceeded if they are more numerous.
+    /// The default value is 0, which means no limit.
+    ///
+    /// \param count Maximum number of resident tiles (0 for no limit)
+    ///
+    /// \see getResidentLimit, getResidentCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setResidentLimit(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of tiles kept in video memory
+    ///
+    /// \return Maximum number of resident tiles (0 for no limit)
+    ///
+    /// \see setResidentLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getResidentLimit() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of tiles currently in video memory
+    ///
+    /// \return Number of resident tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getResidentCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the tiles of an area in advance
+    ///
+    /// This function ignores the upload limit, and can be used
+    /// to upload the tiles around the visible area during a
+    /// loading screen. For the resident limit, the tiles of the
+    /// area count as drawn: they evict older tiles, not each other.
+    ///
+    /// \param area Area to upload, in pixels (an empty area uploads the whole texture)
+    ///
+    /// \see setUploadLimit
+    ///
+    ////////////////////////////////////////////////////////////
+    void upload(const FloatRect& area = FloatRect());
+
+private:
+
+    friend class LargeSprite;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tile of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Tile
+    {
+        IntRect area;    ///< Area of the image covered by the tile
+        IntRect padded;  ///< Area uploaded to the texture, with a border taken from the neighbor tiles
+        Texture texture; ///< Texture of the tile (empty if not resident)
+        Uint64  lastUse; ///< Draw during which the tile was last used
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the tiles intersecting an area
+    ///
+    /// \param target Render target to draw to
+    /// \param states Render states, with the transform of the sprite
+    /// \param area   Visible area, in pixels of the texture
+    /// \param color  Color of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, RenderStates states, const FloatRect& area, const Color& color) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the range of tiles intersecting an area
+    ///
+    /// \param area  Area, in pixels of the texture
+    /// \param range Receives the first and last columns and rows of the tiles
+    ///
+    /// \return False if no tile intersects the area
+    ///
+    ////////////////////////////////////////////////////////////
+    bool getTileRange(const FloatRect& area, IntRect& range) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make a tile resident
+    ///
+    /// Other tiles may be evicted to respect the resident limit.
+    ///
+    /// \param tile Tile to upload
+    ///
+    /// \return True if the tile is resident
+    ///
+    ////////////////////////////////////////////////////////////
+    bool uploadTile(Tile& tile) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Evict the least recently used tiles over the resident limit
+    ///
+    ////////////////////////////////////////////////////////////
+    void evictTiles() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Image                     m_image;         ///< Source pixels of the tiles
+    unsigned int              m_tileSize;      ///< Size of the tiles
+    Vector2u                  m_tileCount;     ///< Number of columns and rows of tiles
+    mutable std::vector<Tile> m_tiles;         ///< Tiles, row by row
+    bool                      m_isSmooth;      ///< Status of the smooth filter
+    unsigned int              m_uploadLimit;   ///< Maximum number of tiles uploaded per draw
+    unsigned int              m_residentLimit; ///< Maximum number of resident tiles
+    mutable unsigned int      m_residentCount; ///< Number of resident tiles
+    mutable Uint64            m_drawCount;     ///< Number of draws, to find the least recently used tiles
+};
+
+} // namespace sf
+
+
+#endif // SFML_LARGETEXTURE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::LargeTexture
+/// \ingroup graphics
+///
+/// sf::LargeTexture displays images that are too big for a
+/// single sf::Texture, such as maps or panoramas: the image
+/// is split into a grid of tiles, each one being a texture
+/// smaller than sf::Texture::getMaximumSize.
+///
+/// The tiles are uploaded lazily, when they become visible,
+/// and only the visible tiles are drawn. Optionally, the
+/// number of tiles uploaded per draw can be limited to avoid
+/// stalls, and the number of tiles kept in video memory can
+/// be bounded, in which case the tiles that are not visible
+/// anymore are evicted.
+///
+/// sf::LargeTexture is displayed with sf::LargeSprite.
+///
+/// Usage example:
+/// \code
+/// sf::LargeTexture map;
+/// if (!map.loadFromFile("world.png"))
+///     return -1;
+///
+/// // Keep at most 16 tiles in video memory
+/// map.setResidentLimit(16);
+///
+/// sf::LargeSprite sprite(map);
+/// window.draw(sprite);
+/// \endcode
+///
+/// \see sf::LargeSprite, sf::Texture
+///
+////////////////////////////////////////////////////////////
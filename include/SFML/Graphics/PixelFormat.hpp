@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELFORMAT_HPP
+#define SFML_PIXELFORMAT_HPP
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \ingroup graphics
+/// \brief Layouts of the pixels stored by sf::Image and sf::Texture
+///
+/// 16-bit formats store each pixel as a single native-endian
+/// unsigned short, with the first component in the most
+/// significant bits. Formats without alpha are opaque when
+/// converted to RGBA, and A8 pixels are white. Luminance is
+/// computed from RGB with the Rec. 601 weights.
+///
+////////////////////////////////////////////////////////////
+enum PixelFormat
+{
+    RGBA8,    ///< 8 bits per component, 4 bytes per pixel (default)
+    RGB8,     ///< 8 bits per color component and no alpha, 3 bytes per pixel
+    RGB565,   ///< 5 bits of red, 6 of green and 5 of blue, 2 bytes per pixel
+    RGBA4444, ///< 4 bits per component, 2 bytes per pixel
+    L8,       ///< 8 bits of luminance (grey level), 1 byte per pixel
+    A8        ///< 8 bits of alpha over white, 1 byte per pixel
+};
+
+} // namespace sf
+
+
+#endif // SFML_PIXELFORMAT_HPP
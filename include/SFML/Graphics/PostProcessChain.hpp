@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_POSTPROCESSCHAIN_HPP
+#define SFML_POSTPROCESSCHAIN_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class RenderTarget;
+class RenderTexture;
+class Shader;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Sequence of full-screen shader passes
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API PostProcessChain : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty chain.
+    ///
+    ////////////////////////////////////////////////////////////
+    PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~PostProcessChain();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a pass at the end of the chain
+    ///
+    /// The pass draws the result of the previous pass (or the
+    /// input of the chain, for the first pass) with \a shader,
+    /// into an image of the size of the input multiplied by
+    /// \a scale. The shader reads its input through a \p sampler2D
+    /// uniform set to sf::Shader::CurrentTexture.
+    ///
+    /// A pass without shader only resamples its input, which is
+    /// typically used to reduce the resolution before expensive
+    /// passes.
+    ///
+    /// The shader is not copied, it must remain alive as long
+    /// as the chain uses it.
+    ///
+    /// \param shader Shader of the pass, can be null
+    /// \param scale  Resolution of the pass, relative to the input of the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    void addPass(const Shader* shader, float scale = 1.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of passes of the chain
+    ///
+    /// \return Number of passes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getPassCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the passes
+    ///
+    /// The intermediate targets are kept, see releaseTargets.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroy the intermediate targets
+    ///
+    /// The targets are created again by the next call to apply.
+    ///
+    ////////////////////////////////////////////////////////////
+    void releaseTargets();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Run the passes and draw the result
+    ///
+    /// The result is drawn to \a target like a sprite of the
+    /// input texture: a rectangle of the size of \a input, with
+    /// the transform and the blend mode of \a states. The texture
+    /// and the shader of \a states are ignored.
+    ///
+    /// \param input  Texture to process, usually the texture of a sf::RenderTexture
+    /// \param target Render target to draw the result to
+    /// \param states Render states used to draw the result
+    ///
+    /// \return True if the passes could be run
+    ///
+    ////////////////////////////////////////////////////////////
+    bool apply(const Texture& input, RenderTarget& target, const RenderStates& states = RenderStates::Default);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pass of the chain
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Pass
+    {
+        const Shader* shader; ///< Shader of the pass, null for a plain resampling
+        float         scale;  ///< Resolution, relative to the input of the chain
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get an intermediate target of a given size
+    ///
+    /// The returned target is moved among the first \a used
+    /// targets of the list, which are the ones used by the
+    /// current call to apply.
+    ///
+    /// \param size    Size of the target
+    /// \param exclude Texture which is being read, whose target can't be returned
+    /// \param used    Number of targets used so far by the current call to apply
+    ///
+    /// \return Target, or null if it could not be created
+    ///
+    ////////////////////////////////////////////////////////////
+    RenderTexture* getTarget(const Vector2u& size, const Texture* exclude, std::size_t& used);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Pass>           m_passes;  ///< Passes, in order of execution
+    std::vector<RenderTexture*> m_targets; ///< Intermediate targets, reused across passes and frames
+};
+
+} // namespace sf
+
+
+#endif // SFML_POSTPROCESSCHAIN_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::PostProcessChain
+/// \ingroup graphics
+///
+/// sf::PostProcessChain applies full-screen effects, such as
+/// blur, bloom or color grading, which are made of several
+/// shader passes: each pass reads the result of the previous
+/// one. The chain owns the intermediate render textures and
+/// reuses them from one pass and one frame to the next, so
+/// that there is nothing to manage by hand. The targets that
+/// a call to apply doesn't need anymore, for example after the
+/// input was resized, are destroyed at the end of that call.
+///
+/// Each pass has its own resolution. Effects like blurs can
+/// run at half or quarter resolution, which divides their
+/// fill rate by 4 or 16.
+///
+/// The chain avoids the work that doesn't change the result:
+/// \li consecutive passes without shader are merged into one resampling
+/// \li a pass without shader at the current resolution is skipped
+/// \li the last pass draws directly to the final target when its resolution
+///     is the one of the input, or is skipped if it has no shader,
+///     since the final draw resamples anyway
+/// \li intermediate targets are not cleared, each pass overwrites all their pixels
+///
+/// Usage example:
+/// \code
+/// // Horizontal and vertical blurs at half resolution, then the final
+/// // composition at full resolution
+/// sf::PostProcessChain bloom;
+/// bloom.addPass(&brightPass, 0.5f);
+/// bloom.addPass(&horizontalBlur, 0.5f);
+/// bloom.addPass(&verticalBlur, 0.5f);
+/// bloom.addPass(&composite);
+///
+/// // Draw the scene to a render texture
+/// scene.clear();
+/// scene.draw(...);
+/// scene.display();
+///
+/// // Apply the effect and draw the result to the window
+/// bloom.apply(scene.getTexture(), window);
+/// \endcode
+///
+/// In the shaders, the input of the pass is the current texture
+/// and the texture coordinates cover it entirely. A pass which
+/// also needs an earlier image, like the composite pass above
+/// which blends the blurred image with the original scene, gets
+/// it as a regular texture uniform.
+///
+/// \see sf::Shader, sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
@@ -44,6 +44,11 @@ namespace sf
 {
 class Drawable;
 
+namespace priv
+{
+    class ProgramState;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Base class for all render targets (window, texture, ...)
 ///
@@ -67,7 +72,7 @@ public:
     /// \param color Fill color to use to clear the render target
     ///
     ////////////////////////////////////////////////////////////
-    void clear(const Color& color = Color(0, 0, 0, 255));
+    virtual void clear(const Color& color = Color(0, 0, 0, 255));
 
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
@@ -244,8 +249,8 @@ public:
     /// \param states      Render states to use for drawing
     ///
     ////////////////////////////////////////////////////////////
-    void draw(const Vertex* vertices, std::size_t vertexCount,
-              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+    virtual void draw(const Vertex* vertices, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
@@ -304,7 +309,8 @@ public:
     /// be achieved if you handle OpenGL states yourself (because
     /// you know which states have really changed, and need to be
     /// saved and restored). Take a look at the resetGLStates
-    /// function if you do so.
+    /// function if you do so, or at GLStateScope, which only
+    /// saves the states that SFML modifies.
     ///
     /// \see popGLStates
     ///
@@ -345,6 +351,96 @@ public:
     ////////////////////////////////////////////////////////////
     void resetGLStates();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief RAII helper class to mix SFML drawing and direct OpenGL rendering
+    ///
+    /// A GLStateScope saves, when it is created, the OpenGL states
+    /// that SFML's drawing functions modify: enabled capabilities,
+    /// blending, viewport, texture binding, current program, vertex
+    /// arrays and, on the fixed-function backends, the matrices.
+    /// It restores them when it is destroyed. On both occasions
+    /// the render target forgets its cached states, so they are
+    /// applied again lazily by its next draw.
+    ///
+    /// It is a much cheaper alternative to pushGLStates/popGLStates,
+    /// which snapshot the whole OpenGL state, and it also works on
+    /// OpenGL ES, where the attribute stacks don't exist.
+    ///
+    /// The scope can surround either kind of code:
+    /// \code
+    /// // OpenGL code here...
+    /// {
+    ///     sf::RenderTarget::GLStateScope scope(window);
+    ///     window.draw(...);
+    ///     window.draw(...);
+    /// }
+    /// // OpenGL code here, with its own states...
+    ///
+    /// // SFML drawing here...
+    /// {
+    ///     sf::RenderTarget::GLStateScope scope(window);
+    ///     // OpenGL code here...
+    /// }
+    /// // SFML drawing here...
+    /// \endcode
+    ///
+    /// Only the client-side vertex arrays of the texture unit 0
+    /// are saved: buffer object bindings are left untouched.
+    ///
+    ////////////////////////////////////////////////////////////
+    class SFML_GRAPHICS_API GLStateScope : NonCopyable
+    {
+    public:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Save the OpenGL states used by SFML
+        ///
+        /// The render target is activated for rendering.
+        ///
+        /// \param target Render target whose context is saved
+        ///
+        ////////////////////////////////////////////////////////////
+        explicit GLStateScope(RenderTarget& target);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Restore the saved OpenGL states
+        ///
+        ////////////////////////////////////////////////////////////
+        ~GLStateScope();
+
+    private:
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Saved state of a vertex array
+        ///
+        ////////////////////////////////////////////////////////////
+        struct ArrayState
+        {
+            bool        enabled;    ///< Is the array enabled?
+            int         size;       ///< Number of components per vertex
+            int         type;       ///< Type of the components
+            bool        normalized; ///< Are integer components normalized? (generic attributes only)
+            int         stride;     ///< Byte offset between consecutive vertices
+            const void* pointer;    ///< Address of the first component
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        RenderTarget& m_target;              ///< Render target whose cache must be invalidated
+        bool          m_active;              ///< Could the target be activated?
+        bool          m_capabilities[6];     ///< Enabled capabilities (blending, culling, depth test, texturing, lighting, alpha test)
+        int           m_blendFunction[4];    ///< Blending factors (color source/destination, alpha source/destination)
+        int           m_blendEquation[2];    ///< Blending equations (color, alpha)
+        int           m_viewport[4];         ///< Viewport rectangle
+        int           m_matrixMode;          ///< Current matrix mode
+        int           m_activeTexture;       ///< Active texture unit
+        int           m_clientActiveTexture; ///< Active texture unit of the client-side arrays
+        int           m_texture;             ///< Texture bound to the texture unit 0
+        unsigned int  m_program;             ///< Current program
+        ArrayState    m_arrays[3];           ///< Position, color and texture coordinates arrays
+    };
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -422,9 +518,10 @@ private:
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    View        m_defaultView; ///< Default view
-    View        m_view;        ///< Current view
-    StatesCache m_cache;       ///< Render states cache
+    View                m_defaultView;        ///< Default view
+    View                m_view;               ///< Current view
+    StatesCache         m_cache;              ///< Render states cache
+    priv::ProgramState* m_defaultPrograms[3]; ///< Default programs of the target's context, untextured, textured and alpha textured (OpenGL ES 2 only)
 };
 
 } // namespace sf
@@ -452,7 +549,8 @@ private:
 /// On top of that, render targets are still able to render direct
 /// OpenGL stuff. It is even possible to mix together OpenGL calls
 /// and regular SFML drawing commands. When doing so, make sure that
-/// OpenGL states are not messed up by calling the
+/// OpenGL states are not messed up by using a
+/// sf::RenderTarget::GLStateScope, or by calling the
 /// pushGLStates/popGLStates functions.
 ///
 /// \see sf::RenderWindow, sf::RenderTexture, sf::View
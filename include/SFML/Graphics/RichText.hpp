@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_RICHTEXT_HPP
+#define SFML_RICHTEXT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/String.hpp>
+#include <map>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Graphical text made of several differently styled runs
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API RichText : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Piece of text sharing the same attributes
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SFML_GRAPHICS_API Run
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// Creates an empty run with a character size of 30,
+        /// regular style, white fill and no outline.
+        ///
+        ////////////////////////////////////////////////////////////
+        Run();
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Construct the run from a string and its attributes
+        ///
+        /// \param string        Text of the run
+        /// \param characterSize Size of the characters, in pixels
+        /// \param style         Combination of sf::Text::Style flags
+        /// \param fillColor     Fill color of the characters
+        ///
+        ////////////////////////////////////////////////////////////
+        Run(const String& string, unsigned int characterSize = 30, Uint32 style = Text::Regular, const Color& fillColor = Color::White);
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        String       string;           ///< Text of the run
+        unsigned int characterSize;    ///< Size of the characters, in pixels
+        Uint32       style;            ///< Combination of sf::Text::Style flags
+        Color        fillColor;        ///< Fill color of the characters
+        Color        outlineColor;     ///< Outline color of the characters
+        float        outlineThickness; ///< Thickness of the outline, 0 to disable it
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty rich text without font.
+    ///
+    ////////////////////////////////////////////////////////////
+    RichText();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty rich text using the given font
+    ///
+    /// \param font Font used to draw all the runs
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit RichText(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font used by all the runs
+    ///
+    /// The \a font argument refers to a font that must
+    /// exist as long as the text uses it, like with sf::Text.
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font used by all the runs
+    ///
+    /// \return Pointer to the font, or NULL if none is set
+    ///
+    /// \see setFont
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a run at the end of the text
+    ///
+    /// A run can contain line breaks; the next run continues
+    /// where the previous one stopped.
+    ///
+    /// \param run Run to append
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Run& run);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a run built from a string and its attributes
+    ///
+    /// \param string        Text of the run
+    /// \param characterSize Size of the characters, in pixels
+    /// \param style         Combination of sf::Text::Style flags
+    /// \param fillColor     Fill color of the characters
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const String& string, unsigned int characterSize = 30, Uint32 style = Text::Regular, const Color& fillColor = Color::White);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace an existing run
+    ///
+    /// \param index Index of the run to replace
+    /// \param run   New run
+    ///
+    /// \see getRun
+    ///
+    ////////////////////////////////////////////////////////////
+    void setRun(std::size_t index, const Run& run);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a run
+    ///
+    /// \param index Index of the run
+    ///
+    /// \return Run at \a index
+    ///
+    /// \see setRun
+    ///
+    ////////////////////////////////////////////////////////////
+    const Run& getRun(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of runs
+    ///
+    /// \return Number of runs in the text
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getRunCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the runs
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry sharing the same glyph page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Layer
+    {
+        Layer();
+
+        VertexArray fill;         ///< Fill geometry
+        VertexArray outline;      ///< Outline geometry
+        std::size_t fillStart;    ///< First fill vertex of the line being laid out
+        std::size_t outlineStart; ///< First outline vertex of the line being laid out
+    };
+
+    typedef std::map<unsigned int, Layer> LayerTable; ///< Layers indexed by character size
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the text to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the text's geometry is updated
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Run>   m_runs;               ///< Runs composing the text
+    const Font*        m_font;               ///< Font used to display the runs
+    mutable LayerTable m_layers;             ///< Geometry, one layer per glyph page
+    mutable FloatRect  m_bounds;             ///< Bounding rectangle of the text (in local coordinates)
+    mutable bool       m_geometryNeedUpdate; ///< Does the geometry need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_RICHTEXT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::RichText
+/// \ingroup graphics
+///
+/// sf::RichText displays a sequence of runs, each with its
+/// own character size, style, fill color and outline, as a
+/// single entity. Compared to one sf::Text per differently
+/// styled word, the layout is computed once for the whole
+/// text and the geometry is grouped by glyph page: a paragraph
+/// using a single character size is drawn in one call (two
+/// if some runs are outlined), whatever the number of runs.
+///
+/// Runs flow one after another: a run that does not end with
+/// a line break continues on the same line as the next one.
+/// Lines mixing several character sizes share a common baseline,
+/// and their height is given by the largest size they contain.
+///
+/// Like sf::Text, sf::RichText doesn't copy its font, so the
+/// font must remain alive as long as the text uses it.
+///
+/// Usage example:
+/// \code
+/// sf::RichText text(font);
+/// text.append("Press ", 24);
+/// text.append("Start", 24, sf::Text::Bold, sf::Color::Yellow);
+/// text.append(" to continue\n", 24);
+/// text.append("www.sfml-dev.org", 16, sf::Text::Underlined, sf::Color::Cyan);
+///
+/// window.draw(text);
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
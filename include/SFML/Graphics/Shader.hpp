@@ -36,6 +36,7 @@
 #include <SFML/System/Vector3.hpp>
 #include <map>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -45,6 +46,11 @@ class InputStream;
 class Texture;
 class Transform;
 
+namespace priv
+{
+    class ProgramState;
+}
+
 ////////////////////////////////////////////////////////////
 /// \brief Shader class (vertex, geometry and fragment)
 ///
@@ -81,6 +87,17 @@ public:
     ////////////////////////////////////////////////////////////
     static CurrentTextureType CurrentTexture;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Handle to a uniform variable of the shader
+    ///
+    /// A valid handle is positive or zero; -1 refers to a
+    /// variable which doesn't exist, and setting it does nothing.
+    ///
+    /// \see getUniformHandle
+    ///
+    ////////////////////////////////////////////////////////////
+    typedef int UniformHandle;
+
 public:
 
     ////////////////////////////////////////////////////////////
@@ -545,6 +562,174 @@ public:
     ////////////////////////////////////////////////////////////
     void setUniformArray(const std::string& name, const Glsl::Mat4* matrixArray, std::size_t length);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a handle to a uniform variable
+    ///
+    /// Setting a uniform through its name costs a lookup in a
+    /// table of names. The handle returned by this function
+    /// refers directly to the variable, so objects that update
+    /// the same uniforms every frame should look them up once
+    /// and use the setUniform overloads which take a handle.
+    ///
+    /// The handle remains valid until the shader is loaded again.
+    ///
+    /// \param name Name of the uniform variable in GLSL
+    ///
+    /// \return Handle to the uniform, or -1 if the shader doesn't have it
+    ///
+    ////////////////////////////////////////////////////////////
+    UniformHandle getUniformHandle(const std::string& name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p float uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param x      Value of the float scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, float x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec2 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the vec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec3 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the vec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p vec4 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the vec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Vec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p int uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param x      Value of the int scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, int x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec2 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the ivec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec3 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the ivec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p ivec4 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the ivec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Ivec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bool uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param x      Value of the bool scalar
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, bool x);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec2 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the bvec2 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec2& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec3 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the bvec3 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec3& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p bvec4 uniform
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param vector Value of the bvec4 vector
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Bvec4& vector);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat3 matrix
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param matrix Value of the mat3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat3& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify value for \p mat4 matrix
+    ///
+    /// \param handle Handle of the uniform variable, see getUniformHandle
+    /// \param matrix Value of the mat4 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Glsl::Mat4& matrix);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify a texture as \p sampler2D uniform
+    ///
+    /// \a texture must remain alive as long as the shader
+    /// uses it, no copy is made internally.
+    ///
+    /// \param handle  Handle of the texture in the shader, see getUniformHandle
+    /// \param texture Texture to assign
+    ///
+    /// \see setUniform(const std::string&, const Texture&)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Specify current texture as \p sampler2D uniform
+    ///
+    /// \param handle Handle of the texture in the shader, see getUniformHandle
+    ///
+    /// \see setUniform(const std::string&, CurrentTextureType)
+    ///
+    ////////////////////////////////////////////////////////////
+    void setUniform(UniformHandle handle, CurrentTextureType);
+
     ////////////////////////////////////////////////////////////
     /// \brief Change a float parameter of the shader
     ///
@@ -655,6 +840,9 @@ public:
     /// // draw OpenGL stuff that use no shader...
     /// \endcode
     ///
+    /// The uniforms which were set since the shader was last
+    /// bound are uploaded at this time.
+    ///
     /// \param shader Shader to bind, can be null to use no shader
     ///
     ////////////////////////////////////////////////////////////
@@ -691,8 +879,33 @@ public:
     ////////////////////////////////////////////////////////////
     static bool isGeometryAvailable();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable the program binary cache
+    ///
+    /// When the cache is enabled, the program that the driver
+    /// links from the sources of a shader is saved to a file of
+    /// \a directory. The next time the same sources are loaded,
+    /// with the same driver, the program is loaded from this file
+    /// instead of being compiled and linked again, which can
+    /// noticeably reduce the startup time of applications that
+    /// use many shaders.
+    ///
+    /// If the driver rejects a cached binary (for example after
+    /// it was updated), or doesn't support program binaries, the
+    /// sources are compiled as usual.
+    ///
+    /// The directory must exist and be writable. The cache is
+    /// disabled by default.
+    ///
+    /// \param directory Directory of the cache files, or an empty string to disable the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    static void setBinaryCacheDirectory(const std::string& directory);
+
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -711,12 +924,46 @@ private:
     ////////////////////////////////////////////////////////////
     /// \brief Bind all the textures used by the shader
     ///
-    /// This function each texture to a different unit, and
-    /// updates the corresponding variables in the shader accordingly.
+    /// This function binds each texture to a different unit; the
+    /// corresponding variables in the shader are regular uniforms
+    /// holding the unit number.
     ///
     ////////////////////////////////////////////////////////////
     void bindTextures() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the uniforms which changed since the last bind
+    ///
+    /// The program must be the current one.
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadUniforms() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the value of a uniform in the uniform block
+    ///
+    /// The uniform is marked for upload if its value changed.
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param type   Type of the value
+    /// \param floats Components of the value, for float types
+    /// \param ints   Components of the value, for integer types
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeUniform(UniformHandle handle, int type, const float* floats, const int* ints);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store the values of an array uniform in the uniform block
+    ///
+    /// The uniform is marked for upload if its values changed.
+    ///
+    /// \param handle Handle of the uniform variable
+    /// \param type   Type of the elements of the array
+    /// \param values Components of all the elements (swapped with the stored ones)
+    ///
+    ////////////////////////////////////////////////////////////
+    void storeUniformArray(UniformHandle handle, int type, std::vector<float>& values);
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the location ID of a shader uniform
     ///
@@ -728,27 +975,39 @@ private:
     int getUniformLocation(const std::string& name);
 
     ////////////////////////////////////////////////////////////
-    /// \brief RAII object to save and restore the program
-    ///        binding while uniforms are being set
-    ///
-    /// Implementation is private in the .cpp file.
+    /// \brief CPU-side copy of a uniform variable
     ///
     ////////////////////////////////////////////////////////////
-    struct UniformBinder;
+    struct Uniform
+    {
+        int                location; ///< Location of the variable in the program
+        int                type;     ///< Type of the value (of the elements, for arrays), or 0 if it was never set
+        int                texture;  ///< Index of the texture assigned to the variable in the texture table, or -1
+        bool               dirty;    ///< Must the value be uploaded at the next bind?
+        union
+        {
+            float floats[16];
+            int   ints[4];
+        } value;                     ///< Components of the value
+        std::vector<float> array;    ///< Components of all the elements, if the value was set by setUniformArray
+    };
 
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    typedef std::map<int, const Texture*> TextureTable;
-    typedef std::map<std::string, int> UniformTable;
+    typedef std::vector<std::pair<int, const Texture*> > TextureTable;
+    typedef std::map<std::string, UniformHandle> UniformTable;
+    typedef std::vector<Uniform> UniformBlock;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  ///< OpenGL identifier for the program
-    int          m_currentTexture; ///< Location of the current texture in the shader
-    TextureTable m_textures;       ///< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       ///< Parameters location cache
+    unsigned int                       m_shaderProgram; ///< OpenGL identifier for the program
+    TextureTable                       m_textures;      ///< Texture variables in the shader, with their location; the texture unit is the index + 1
+    UniformTable                       m_uniforms;      ///< Uniform handles, mapped to their name
+    mutable UniformBlock               m_uniformBlock;  ///< Values of the uniforms, indexed by handle
+    mutable std::vector<UniformHandle> m_dirtyUniforms; ///< Uniforms to upload at the next bind
+    mutable priv::ProgramState*        m_programState;  ///< Matrix uniforms last uploaded to the program (OpenGL ES 2 only)
 };
 
 } // namespace sf
@@ -814,6 +1073,18 @@ private:
 /// shader.setUniform("current", sf::Shader::CurrentTexture);
 /// \endcode
 ///
+/// Uniform values (arrays included) are kept on the CPU side
+/// and uploaded all at once when the shader is bound for
+/// drawing, and only if they changed. Looking up a uniform by
+/// its name still has a cost; getUniformHandle() does it once,
+/// and the handle can then be passed to setUniform() instead
+/// of the name:
+/// \code
+/// sf::Shader::UniformHandle offset = shader.getUniformHandle("offset");
+/// ...
+/// shader.setUniform(offset, 2.f); // every frame
+/// \endcode
+///
 /// The old setParameter() overloads are deprecated and will be removed in a
 /// future version. You should use their setUniform() equivalents instead.
 ///
@@ -870,6 +1141,35 @@ private:
 /// sf::Shader::bind(NULL);
 /// \endcode
 ///
+/// When SFML is built with its OpenGL ES 2 backend, shaders
+/// must be written in GLSL ES 1.00, which has no fixed-function
+/// built-ins such as gl_Vertex or gl_TexCoord. Render targets
+/// provide the same data through the following variables:
+/// \code
+/// // vertex shader
+/// attribute vec4 sf_Vertex;          // position of the vertex
+/// attribute vec4 sf_Color;           // color of the vertex
+/// attribute vec4 sf_MultiTexCoord0;  // texture coordinates of the vertex
+/// uniform mat4 sf_ProjectionMatrix;  // view
+/// uniform mat4 sf_ModelViewMatrix;   // transform of the entity
+/// uniform mat4 sf_TextureMatrix;     // converts texture coordinates from pixels
+/// \endcode
+/// If one of the two stages is omitted, the stage of SFML's
+/// default program is used. Its vertex stage outputs
+/// \p varying \p vec4 \p sf_FrontColor and \p sf_TexCoord,
+/// so a fragment-only shader looks like this:
+/// \code
+/// precision mediump float;
+/// uniform sampler2D texture;
+/// varying vec4 sf_FrontColor;
+/// varying vec4 sf_TexCoord;
+/// void main()
+/// {
+///     gl_FragColor = sf_FrontColor * texture2D(texture, sf_TexCoord.xy);
+/// }
+/// \endcode
+/// Geometry shaders are not available on OpenGL ES 2.
+///
 /// \see sf::Glsl
 ///
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,262 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SOFTWARERENDERTARGET_HPP
+#define SFML_SOFTWARERENDERTARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <map>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Target for 2D rendering on the CPU, into an image
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SoftwareRenderTarget : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty target. You must call create to
+    /// be able to draw to it.
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the target
+    ///
+    /// Its pixels are initialized to transparent black, and its
+    /// view is reset to the default view of the new size.
+    ///
+    /// \param width  Width of the target, in pixels
+    /// \param height Height of the target, in pixels
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the maximum number of threads used to draw
+    ///
+    /// Large draw calls are split in bands of rows which are
+    /// rasterized in parallel; the result doesn't depend on
+    /// the number of threads. The default is 4.
+    ///
+    /// \param count Maximum number of threads, 1 to draw on the calling thread only
+    ///
+    /// \see getThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    void setThreadCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of threads used to draw
+    ///
+    /// \return Maximum number of threads
+    ///
+    /// \see setThreadCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Release the copies of the textures drawn so far
+    ///
+    /// The target keeps a copy of the pixels of the textures it
+    /// draws, and drops the least recently used ones when they
+    /// exceed 64 MB. Call this function to release them all
+    /// immediately, or to force a render-texture that was drawn
+    /// to since its last use by this target to be read again.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearTextureCache();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the entire target with a single color
+    ///
+    /// \param color Fill color to use to clear the target
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void clear(const Color& color = Color(0, 0, 0, 255));
+
+    using RenderTarget::draw;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices
+    ///
+    /// Shaders are not supported, states.shader is ignored.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(const Vertex* vertices, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the target
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the target for rendering
+    ///
+    /// A software target has no OpenGL context, so this function
+    /// does nothing and always returns false.
+    ///
+    /// \param active Ignored
+    ///
+    /// \return Always false
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual bool setActive(bool active = true);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the rendered image
+    ///
+    /// The image is in RGBA8 format and is directly the
+    /// storage of the target: drawing is visible immediately,
+    /// there's no display function to call.
+    ///
+    /// \return Read-only reference to the image
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pixels of a texture, in RGBA8 format
+    ///
+    /// The pixels are read back once and reused until the
+    /// texture is updated, or until the copy is dropped from
+    /// the cache.
+    ///
+    /// \param texture Texture to read
+    ///
+    /// \return Image containing the pixels of the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getTextureImage(const Texture& texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Copy of the pixels of a texture
+    ///
+    ////////////////////////////////////////////////////////////
+    struct TextureImage
+    {
+        Uint64 lastUse; ///< Value of the use counter when the copy was last drawn
+        Image  image;   ///< Pixels of the texture
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Image                          m_image;            ///< Rendered pixels
+    unsigned int                   m_threadCount;      ///< Maximum number of threads used to draw
+    std::map<Uint64, TextureImage> m_textureImages;    ///< Pixels of the textures used recently, by cache identifier
+    std::size_t                    m_textureCacheSize; ///< Total size of the copies of the textures, in bytes
+    Uint64                         m_textureUseCount;  ///< Counter incremented at each use of a copy
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERENDERTARGET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoftwareRenderTarget
+/// \ingroup graphics
+///
+/// sf::SoftwareRenderTarget is a render target which draws
+/// on the CPU, into an sf::Image, instead of using OpenGL.
+/// It works on machines without any graphics hardware, like
+/// servers producing map tiles or charts, and all the
+/// drawables of SFML (shapes, sprites, texts, vertex
+/// arrays, ...) can be drawn to it as to any other target.
+///
+/// The rasterization rules are those of OpenGL: pixels whose
+/// center is covered by a triangle are filled, pixels on edges
+/// shared by two triangles are filled only once, and textures
+/// are sampled with nearest or bilinear filtering depending on
+/// Texture::isSmooth. Vertex colors, blend modes, views and
+/// viewports are supported; shaders are not.
+///
+/// The rasterizer works with fixed-point integers after the
+/// vertices are transformed, so its output is deterministic:
+/// drawing the same thing always produces exactly the same
+/// pixels, whatever the number of threads. This makes it
+/// suitable for pixel-exact tests of geometry. It is not
+/// meant to reproduce the output of a GPU bit for bit.
+///
+/// Textures still live in OpenGL: the pixels of each texture
+/// are read back the first time it is drawn and after each
+/// update, which requires an OpenGL implementation (a
+/// software one is enough). The copies are kept in a cache
+/// limited to 64 MB, see clearTextureCache. Rendering into a
+/// render-texture doesn't count as an update: a texture of a
+/// render-texture that is redrawn after being drawn to a
+/// software target keeps its old pixels in this target,
+/// until clearTextureCache is called.
+///
+/// Usage example:
+/// \code
+/// sf::SoftwareRenderTarget target;
+/// target.create(256, 256);
+///
+/// target.clear(sf::Color::White);
+///
+/// sf::CircleShape circle(100);
+/// circle.setFillColor(sf::Color::Red);
+/// circle.setPosition(28, 28);
+/// target.draw(circle);
+///
+/// target.getImage().saveToFile("tile.png");
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
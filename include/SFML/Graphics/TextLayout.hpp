@@ -0,0 +1,427 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTLAYOUT_HPP
+#define SFML_TEXTLAYOUT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/String.hpp>
+#include <deque>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Large multi-line text that only builds the geometry
+///        of its visible lines
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextLayout : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty layout without font.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextLayout();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct an empty layout from a font and size
+    ///
+    /// \param font          Font used to draw the text
+    /// \param characterSize Size of the characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    TextLayout(const Font& font, unsigned int characterSize = 30);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Replace the whole text
+    ///
+    /// The string is split into paragraphs at each line break.
+    ///
+    /// \param string New text
+    ///
+    ////////////////////////////////////////////////////////////
+    void setString(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add paragraphs at the end of the text
+    ///
+    /// Each line break contained in \a string starts a new
+    /// paragraph. Only the added paragraphs are laid out, so
+    /// the cost doesn't depend on the size of the text.
+    ///
+    /// \param string Text of the paragraph(s) to append
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendParagraph(const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Insert a paragraph before an existing one
+    ///
+    /// \param index  Index of the new paragraph
+    /// \param string Text of the paragraph, without line break
+    ///
+    ////////////////////////////////////////////////////////////
+    void insertParagraph(std::size_t index, const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the text of a paragraph
+    ///
+    /// Only this paragraph is laid out again.
+    ///
+    /// \param index  Index of the paragraph
+    /// \param string New text of the paragraph, without line break
+    ///
+    /// \see getParagraph
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParagraph(std::size_t index, const String& string);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove paragraphs
+    ///
+    /// \param index Index of the first paragraph to remove
+    /// \param count Number of paragraphs to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeParagraphs(std::size_t index, std::size_t count = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the paragraphs
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text of a paragraph
+    ///
+    /// \param index Index of the paragraph
+    ///
+    /// \return Text of the paragraph
+    ///
+    /// \see setParagraph
+    ///
+    ////////////////////////////////////////////////////////////
+    const String& getParagraph(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of paragraphs
+    ///
+    /// \return Number of paragraphs
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParagraphCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of displayed lines
+    ///
+    /// This accounts for the lines created by word wrapping.
+    ///
+    /// \return Number of lines
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getLineCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the font
+    ///
+    /// \param font New font
+    ///
+    /// \see getFont
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFont(const Font& font);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the character size
+    ///
+    /// The default size is 30.
+    ///
+    /// \param size New character size, in pixels
+    ///
+    /// \see getCharacterSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setCharacterSize(unsigned int size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the text style
+    ///
+    /// Only sf::Text::Bold and sf::Text::Italic are supported.
+    ///
+    /// \param style New style
+    ///
+    /// \see getStyle
+    ///
+    ////////////////////////////////////////////////////////////
+    void setStyle(Uint32 style);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the fill color of the text
+    ///
+    /// \param color New fill color
+    ///
+    /// \see getFillColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setFillColor(const Color& color);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the width at which lines are wrapped
+    ///
+    /// Lines are broken after the last whitespace that fits,
+    /// or before the first character that doesn't fit if the
+    /// line has no whitespace. A width of 0 (the default)
+    /// disables word wrapping.
+    ///
+    /// \param width Maximum width of a line, in pixels
+    ///
+    /// \see getWrapWidth
+    ///
+    ////////////////////////////////////////////////////////////
+    void setWrapWidth(float width);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the font
+    ///
+    /// \return Pointer to the font, or NULL if none is set
+    ///
+    ////////////////////////////////////////////////////////////
+    const Font* getFont() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the character size
+    ///
+    /// \return Size of the characters, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getCharacterSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text style
+    ///
+    /// \return Text style
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint32 getStyle() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the fill color of the text
+    ///
+    /// \return Fill color
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getFillColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the width at which lines are wrapped
+    ///
+    /// \return Maximum width of a line, 0 if wrapping is disabled
+    ///
+    ////////////////////////////////////////////////////////////
+    float getWrapWidth() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local position of the top of a line
+    ///
+    /// Useful to scroll a view to a given line.
+    ///
+    /// \param line Index of the line
+    ///
+    /// \return Vertical offset of the line, in local coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    float getLineTop(std::size_t line) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the entity
+    ///
+    /// The rectangle covers all the lines: its width is the
+    /// one of the widest line and its height is the number of
+    /// lines times the line spacing.
+    ///
+    /// \return Local bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the entity
+    ///
+    /// \return Global bounding rectangle of the entity
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Range of characters displayed on one line
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Line
+    {
+        std::size_t begin; ///< Index of the first character in the paragraph
+        std::size_t end;   ///< Index past the last character in the paragraph
+        float       width; ///< Width of the line, trailing whitespace excluded
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Text between two line breaks and its cached layout
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Paragraph
+    {
+        Paragraph();
+
+        String            string;        ///< Text of the paragraph
+        std::vector<Line> lines;         ///< Lines produced by word wrapping
+        std::size_t       firstLine;     ///< Index of the first line in the whole text
+        float             width;         ///< Width of the widest line
+        bool              needUpdate;    ///< Must the lines be computed again?
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible lines to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(RenderTarget& target, RenderStates states) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark a paragraph and the following ones as modified
+    ///
+    /// \param index Index of the first modified paragraph
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidate(std::size_t index);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Mark the layout of all the paragraphs as outdated
+    ///
+    ////////////////////////////////////////////////////////////
+    void invalidateAll();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the lines of a paragraph
+    ///
+    /// \param paragraph Paragraph to lay out
+    ///
+    ////////////////////////////////////////////////////////////
+    void layoutParagraph(Paragraph& paragraph) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the lines of the modified paragraphs are updated
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureLayoutUpdate() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make sure the geometry covers the given lines
+    ///
+    /// \param first First visible line
+    /// \param last  Line past the last visible one
+    ///
+    ////////////////////////////////////////////////////////////
+    void ensureGeometryUpdate(std::size_t first, std::size_t last) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable std::deque<Paragraph> m_paragraphs;         ///< Paragraphs composing the text
+    const Font*                   m_font;               ///< Font used to display the text
+    unsigned int                  m_characterSize;      ///< Base size of characters, in pixels
+    Uint32                        m_style;              ///< Text style (see sf::Text::Style)
+    Color                         m_fillColor;          ///< Text fill color
+    float                         m_wrapWidth;          ///< Maximum width of a line, 0 to disable wrapping
+    mutable std::size_t           m_firstModified;      ///< First paragraph whose lines or position changed
+    mutable std::size_t           m_lineCount;          ///< Total number of lines
+    mutable VertexArray           m_vertices;           ///< Geometry of the visible lines
+    mutable std::size_t           m_firstVisible;       ///< First line contained in the geometry
+    mutable std::size_t           m_lastVisible;        ///< Line past the last one contained in the geometry
+    mutable bool                  m_geometryNeedUpdate; ///< Must the geometry be rebuilt?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTLAYOUT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextLayout
+/// \ingroup graphics
+///
+/// sf::TextLayout is meant for long documents such as logs,
+/// terminals or text editors, where sf::Text would lay out
+/// and rebuild the geometry of the whole string each time it
+/// changes.
+///
+/// The text is stored as a list of paragraphs. The line breaks
+/// of each paragraph (including the ones created by word wrapping)
+/// are computed once and cached; editing, inserting or appending
+/// a paragraph only lays out that paragraph again. When drawn,
+/// the layout finds the lines that intersect the current view
+/// of the render target and only builds vertices for them, so
+/// the cost of scrolling and drawing depends on the size of
+/// the view, not on the size of the document.
+///
+/// All the text shares the same font, character size, style
+/// and color; use sf::RichText for mixed styles.
+///
+/// Usage example:
+/// \code
+/// sf::TextLayout log(font, 14);
+/// log.setWrapWidth(800);
+///
+/// // Append new lines as they arrive
+/// log.appendParagraph("[info] connection established");
+///
+/// // Scroll to the bottom
+/// sf::View view = window.getDefaultView();
+/// view.setCenter(400, log.getLocalBounds().height - 300);
+/// window.setView(view);
+///
+/// window.draw(log);
+/// \endcode
+///
+/// \see sf::Text, sf::RichText
+///
+////////////////////////////////////////////////////////////
@@ -85,15 +85,27 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Create the texture
     ///
+    /// The texture stores its pixels in the given \a format, and
+    /// the pixels given to update() must be in this format too.
+    /// Formats smaller than RGBA8 save video memory and upload
+    /// bandwidth. When drawn, the color of L8 textures is grey,
+    /// and A8 textures (stored in a single alpha channel) are white
+    /// with the alpha of their pixels, so they take their color
+    /// from the vertices. Shaders sample A8 textures as white too,
+    /// except on OpenGL ES 2 contexts older than OpenGL ES 3.0,
+    /// where their color is black and only their alpha should be
+    /// used. sRGB conversion only applies to RGBA8 textures.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param width  Width of the texture
     /// \param height Height of the texture
+    /// \param format Format of the pixels stored by the texture
     ///
     /// \return True if creation was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height);
+    bool create(unsigned int width, unsigned int height, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
@@ -198,6 +210,9 @@ public:
     /// If the \a area rectangle crosses the bounds of the image, it
     /// is adjusted to fit the image size.
     ///
+    /// The texture is created with the pixel format of the image,
+    /// and its pixels are uploaded without conversion.
+    ///
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
@@ -213,6 +228,25 @@ public:
     ////////////////////////////////////////////////////////////
     bool loadFromImage(const Image& image, const IntRect& area = IntRect());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from a view of pixels
+    ///
+    /// The texture is created with the size and pixel format of
+    /// the view, and the pixels are uploaded directly from it.
+    /// This is the cheapest way to load a part of an image, for
+    /// example a frame of a sprite sheet.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param view View of the pixels to load into the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadFromImage
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadFromImage(const ImageView& view);
+
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the texture
     ///
@@ -221,6 +255,16 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the format of the pixels stored by the texture
+    ///
+    /// \return Format of the pixels
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -228,6 +272,10 @@ public:
     /// the texture's pixels from the graphics card and copies
     /// them to a new image, potentially applying transformations
     /// to pixels if necessary (texture may be padded or flipped).
+    /// The image has the pixel format of the texture. On OpenGL ES,
+    /// L8 and A8 textures can't be read back and an empty image is
+    /// returned, except for the textures of sf::Font, which are
+    /// copied from the pixels that the font keeps in memory.
     ///
     /// \return Image containing the texture's pixels
     ///
@@ -240,7 +288,8 @@ public:
     /// \brief Update the whole texture from an array of pixels
     ///
     /// The \a pixel array is assumed to have the same size as
-    /// the \a area rectangle, and to contain 32-bits RGBA pixels.
+    /// the \a area rectangle, and to contain pixels in the format
+    /// of the texture (32-bits RGBA pixels by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array, passing invalid arguments will lead to an undefined
@@ -258,7 +307,8 @@ public:
     /// \brief Update a part of the texture from an array of pixels
     ///
     /// The size of the \a pixel array must match the \a width and
-    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    /// \a height arguments, and it must contain pixels in the format
+    /// of the texture (32-bits RGBA pixels by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array or the bounds of the area to update, passing invalid
@@ -276,6 +326,29 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from an array of pixels with a row stride
+    ///
+    /// This is the same as the other overload, but the rows of
+    /// \a pixels are \a rowStride bytes apart instead of being
+    /// contiguous, so that a sub-rectangle of a bigger array can
+    /// be uploaded without repacking it first.
+    ///
+    /// The pixels are uploaded with a single call when the OpenGL
+    /// implementation can skip the end of the rows by itself;
+    /// otherwise (OpenGL ES 2), they are repacked into a scratch
+    /// buffer, a chunk of rows at a time.
+    ///
+    /// \param pixels    Array of pixels to copy to the texture
+    /// \param width     Width of the pixel region contained in \a pixels
+    /// \param height    Height of the pixel region contained in \a pixels
+    /// \param x         X offset in the texture where to copy the source pixels
+    /// \param y         Y offset in the texture where to copy the source pixels
+    /// \param rowStride Number of bytes between the starts of two rows (0 if the rows are contiguous)
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, std::size_t rowStride);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update a part of this texture from another texture
     ///
@@ -325,6 +398,9 @@ public:
     /// passing an image bigger than the texture will lead to an
     /// undefined behavior.
     ///
+    /// The pixels are converted if the image has another format
+    /// than the texture.
+    ///
     /// This function does nothing if the texture was not
     /// previously created.
     ///
@@ -340,6 +416,9 @@ public:
     /// passing an invalid combination of image size and offset
     /// will lead to an undefined behavior.
     ///
+    /// The pixels are converted if the image has another format
+    /// than the texture.
+    ///
     /// This function does nothing if the texture was not
     /// previously created.
     ///
@@ -350,6 +429,47 @@ public:
     ////////////////////////////////////////////////////////////
     void update(const Image& image, unsigned int x, unsigned int y);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from a sub-rectangle of an image
+    ///
+    /// The rectangle is clipped to the bounds of the image; if it
+    /// is empty, the whole image is used. The pixels are uploaded
+    /// directly from the image, see the overload taking a row stride.
+    ///
+    /// \param image      Image to copy to the texture
+    /// \param sourceRect Sub-rectangle of the image to copy
+    /// \param x          X offset in the texture where to copy the source pixels
+    /// \param y          Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const Image& image, const IntRect& sourceRect, unsigned int x, unsigned int y);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the texture from a view of pixels
+    ///
+    /// This is the same as update(const Image&), but the source
+    /// can be any rectangle of pixels, including a part of an
+    /// image whose rows are not contiguous.
+    ///
+    /// \param view View of the pixels to copy to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& view);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the texture from a view of pixels
+    ///
+    /// This is the same as update(const Image&, unsigned int, unsigned int),
+    /// but the source can be any rectangle of pixels, including
+    /// a part of an image whose rows are not contiguous.
+    ///
+    /// \param view View of the pixels to copy to the texture
+    /// \param x    X offset in the texture where to copy the source pixels
+    /// \param y    Y offset in the texture where to copy the source pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(const ImageView& view, unsigned int x, unsigned int y);
+
     ////////////////////////////////////////////////////////////
     /// \brief Update the texture from the contents of a window
     ///
@@ -564,6 +684,11 @@ public:
     /// coordinates more intuitive for the high-level API, users don't need
     /// to compute normalized values.
     ///
+    /// OpenGL ES 2 has no texture matrix, so with the OpenGL ES 2
+    /// backend this function only binds the texture and the
+    /// coordinates must be normalized. Render targets pass the
+    /// equivalent matrix to shaders instead (see sf::Shader).
+    ///
     /// \param texture Pointer to the texture to bind, can be null to use no texture
     /// \param coordinateType Type of texture coordinates to use
     ///
@@ -586,6 +711,8 @@ private:
 
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class SoftwareRenderTarget;
+    friend class Font;
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -611,19 +738,34 @@ private:
     ////////////////////////////////////////////////////////////
     void invalidateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the texture matrix used to bind the texture
+    ///
+    /// The matrix converts texture coordinates of the given type
+    /// to normalized ones, and flips them if the pixels are
+    /// stored upside down.
+    ///
+    /// \param matrix         Array of 16 floats receiving the 4x4 matrix
+    /// \param coordinateType Type of texture coordinates to convert
+    ///
+    ////////////////////////////////////////////////////////////
+    void getMatrix(float* matrix, CoordinateType coordinateType) const;
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    Vector2u     m_size;          ///< Public texture size
-    Vector2u     m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
-    unsigned int m_texture;       ///< Internal texture identifier
-    bool         m_isSmooth;      ///< Status of the smooth filter
-    bool         m_sRgb;          ///< Should the texture source be converted from sRGB?
-    bool         m_isRepeated;    ///< Is the texture in repeat mode?
-    mutable bool m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
-    bool         m_fboAttachment; ///< Is this texture owned by a framebuffer object?
-    bool         m_hasMipmap;     ///< Has the mipmap been generated?
-    Uint64       m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    Vector2u                  m_size;          ///< Public texture size
+    Vector2u                  m_actualSize;    ///< Actual texture size (can be greater than public size because of padding)
+    unsigned int              m_texture;       ///< Internal texture identifier
+    bool                      m_isSmooth;      ///< Status of the smooth filter
+    bool                      m_sRgb;          ///< Should the texture source be converted from sRGB?
+    bool                      m_isRepeated;    ///< Is the texture in repeat mode?
+    mutable bool              m_pixelsFlipped; ///< To work around the inconsistency in Y orientation
+    bool                      m_fboAttachment; ///< Is this texture owned by a framebuffer object?
+    bool                      m_hasMipmap;     ///< Has the mipmap been generated?
+    PixelFormat               m_format;        ///< Format of the pixels stored by the texture
+    Uint64                    m_cacheId;       ///< Unique number that identifies the texture to the render target's cache
+    const std::vector<Uint8>* m_pixelCopy;     ///< Pixels kept in memory by the owner of the texture (see Font), to read it back without OpenGL
 };
 
 } // namespace sf
@@ -445,6 +445,13 @@ SFML_GRAPHICS_API Vector2f operator *(const Transform& left, const Vector2f& rig
 /// sf::FloatRect rect = transform.transformRect(sf::FloatRect(0, 0, 10, 100));
 /// \endcode
 ///
-/// \see sf::Transformable, sf::RenderStates
+/// Affine transforms, whose last row is (0, 0, 1), are handled
+/// by faster code: combining two of them only multiplies their
+/// 2x3 upper parts, and their inverse only needs the determinant
+/// of their 2x2 upper left part. All the transforms built with
+/// translate, rotate and scale, and the ones of sf::Transformable
+/// and sf::View, are affine.
+///
+/// \see sf::Transformable, sf::TransformHierarchy, sf::RenderStates
 ///
 ////////////////////////////////////////////////////////////
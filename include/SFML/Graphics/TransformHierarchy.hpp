@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TRANSFORMHIERARCHY_HPP
+#define SFML_TRANSFORMHIERARCHY_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Config.hpp>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Flat tree of transforms, combined with the ones of their parents
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TransformHierarchy
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty hierarchy.
+    ///
+    ////////////////////////////////////////////////////////////
+    TransformHierarchy();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a node to the hierarchy
+    ///
+    /// Nodes are numbered in the order they are added, starting
+    /// from 0. The parent must already be in the hierarchy, so
+    /// that parents always come before their children.
+    ///
+    /// Only the affine part of \a transform is used, its last
+    /// row is considered to be (0, 0, 1).
+    ///
+    /// \param parent    Index of the parent node, or NoParent for a root node
+    /// \param transform Local transform of the node, relative to its parent
+    ///
+    /// \return Index of the new node
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t addNode(std::size_t parent = NoParent, const Transform& transform = Transform::Identity);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of nodes of the hierarchy
+    ///
+    /// \return Number of nodes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getNodeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of a node
+    ///
+    /// \param node Index of the node
+    ///
+    /// \return Index of the parent node, or NoParent for a root node
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParent(std::size_t node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the nodes
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change the local transform of a node
+    ///
+    /// The world transforms of the node and of all its
+    /// descendants are recomputed the next time one of them
+    /// is requested.
+    ///
+    /// Only the affine part of \a transform is used, its last
+    /// row is considered to be (0, 0, 1).
+    ///
+    /// \param node      Index of the node
+    /// \param transform New local transform of the node, relative to its parent
+    ///
+    /// \see getLocalTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLocalTransform(std::size_t node, const Transform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local transform of a node
+    ///
+    /// \param node Index of the node
+    ///
+    /// \return Local transform of the node, relative to its parent
+    ///
+    /// \see setLocalTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform getLocalTransform(std::size_t node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the world transform of a node
+    ///
+    /// The world transform is the combination of the local
+    /// transforms of the node and of all its ancestors, starting
+    /// from the root. If local transforms changed since the last
+    /// call, all the world transforms that depend on them are
+    /// updated first, in a single pass over the hierarchy.
+    ///
+    /// \param node Index of the node
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    Transform getWorldTransform(std::size_t node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform a point from the local coordinates of a node to world coordinates
+    ///
+    /// This function is equivalent to getWorldTransform(node).transformPoint(point),
+    /// without building the 4x4 matrix of the world transform.
+    ///
+    /// \param node  Index of the node
+    /// \param point Point to transform, in local coordinates of the node
+    ///
+    /// \return Transformed point, in world coordinates
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f transformPoint(std::size_t node, const Vector2f& point) const;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const std::size_t NoParent; ///< Parent index of the root nodes
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief 2D affine transform, stored as the 2x3 upper part of its matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Affine
+    {
+        float a00, a01, a02;
+        float a10, a11, a12;
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the world transforms of the changed nodes
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::size_t>    m_parents;     ///< Parent of each node
+    std::vector<Affine>         m_locals;      ///< Local transform of each node
+    mutable std::vector<Affine> m_worlds;      ///< World transform of each node
+    mutable std::vector<Uint8>  m_changed;     ///< Does the world transform of each node need to be recomputed?
+    mutable bool                m_needUpdate;  ///< Does any world transform need to be recomputed?
+};
+
+} // namespace sf
+
+
+#endif // SFML_TRANSFORMHIERARCHY_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TransformHierarchy
+/// \ingroup graphics
+///
+/// sf::TransformHierarchy computes the world transforms of
+/// a scene graph, where each node is placed relative to its
+/// parent. Instead of a tree of objects, the nodes are stored
+/// in flat arrays indexed by node, with parents always before
+/// their children: the world transforms are all updated in a
+/// single linear pass, that visits each node once and only
+/// recomputes the nodes whose local transform, or the one of an
+/// ancestor, changed.
+///
+/// Transforms are stored in a compact form, the 6 floats that
+/// define a 2D affine transform, so combining a node with its
+/// parent is a 2x3 multiplication. The results are exactly the
+/// same as combining the equivalent sf::Transform objects.
+///
+/// Usage example:
+/// \code
+/// // Build the hierarchy once
+/// sf::TransformHierarchy hierarchy;
+/// std::size_t body = hierarchy.addNode();
+/// std::size_t arm  = hierarchy.addNode(body);
+/// std::size_t hand = hierarchy.addNode(arm);
+///
+/// // Each frame, update the local transforms that changed...
+/// hierarchy.setLocalTransform(body, bodyTransformable.getTransform());
+/// hierarchy.setLocalTransform(arm, armTransformable.getTransform());
+///
+/// // ... and draw the nodes with their world transforms
+/// window.draw(handSprite, hierarchy.getWorldTransform(hand));
+/// \endcode
+///
+/// \see sf::Transform, sf::Transformable
+///
+////////////////////////////////////////////////////////////
@@ -47,7 +47,10 @@
 
 #elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
 
-    #if defined(SFML_OPENGL_ES)
+    #if defined(SFML_OPENGL_ES2)
+        #include <GLES2/gl2.h>
+        #include <GLES2/gl2ext.h>
+    #elif defined(SFML_OPENGL_ES)
         #include <GLES/gl.h>
         #include <GLES/glext.h>
     #else
@@ -32,6 +32,7 @@
 #include <SFML/Window/GlResource.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
 
 
 namespace sf
@@ -51,6 +52,19 @@ class SFML_WINDOW_API Context : GlResource, NonCopyable
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Time spent setting up OpenGL
+    ///
+    ////////////////////////////////////////////////////////////
+    struct StartupTimings
+    {
+        Time         sharedContextCreation; ///< Creation of the hidden shared context, including the extensions query
+        Time         extensionsQuery;       ///< Retrieval of the list of supported extensions
+        Time         configSelection;       ///< Selection of pixel formats, visuals or EGL configs, for all the contexts
+        Time         contextCreation;       ///< Creation and initialization of all the other contexts
+        unsigned int contextCount;          ///< Number of contexts created, not counting the shared one
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -117,6 +131,19 @@ public:
     ////////////////////////////////////////////////////////////
     static const Context* getActiveContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time spent so far setting up OpenGL
+    ///
+    /// The durations are accumulated since the program started,
+    /// they are meant to find what makes the first frame slow
+    /// to appear: context creation, driver initialization or
+    /// selection of the framebuffer configuration.
+    ///
+    /// \return Accumulated startup timings
+    ///
+    ////////////////////////////////////////////////////////////
+    static StartupTimings getStartupTimings();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -177,4 +204,13 @@ private:
 /// // by the sf::Context destructor
 /// \endcode
 ///
+/// The time spent creating contexts can be inspected with
+/// getStartupTimings(), for example to log it once the first
+/// frame has been displayed:
+/// \code
+/// sf::Context::StartupTimings timings = sf::Context::getStartupTimings();
+/// std::cout << "Shared context: " << timings.sharedContextCreation.asMilliseconds() << " ms, "
+///           << "config selection: " << timings.configSelection.asMilliseconds() << " ms" << std::endl;
+/// \endcode
+///
 ////////////////////////////////////////////////////////////
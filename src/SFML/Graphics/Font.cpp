@@ -31,6 +31,7 @@
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Thread.hpp>
 #include <SFML/System/Err.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -38,6 +39,8 @@
 #include FT_OUTLINE_H
 #include FT_BITMAP_H
 #include FT_STROKER_H
+#include <algorithm>
+#include <fstream>
 #include <cstdlib>
 #include <cstring>
 
@@ -61,11 +64,154 @@ namespace
     void close(FT_Stream)
     {
     }
+
+    // Build the key of a glyph by combining the code point, bold flag, and outline thickness
+    sf::Uint64 glyphKey(sf::Uint32 codePoint, bool bold, float outlineThickness)
+    {
+        return (static_cast<sf::Uint64>(*reinterpret_cast<sf::Uint32*>(&outlineThickness)) << 32)
+             | (static_cast<sf::Uint64>(bold ? 1 : 0) << 31)
+             |  static_cast<sf::Uint64>(codePoint);
+    }
+
+    // Glyph cache file format; every record is a plain array of fixed-size,
+    // 8-byte aligned structures so that the file can be used in place
+    const char       glyphCacheMagic[8]  = {'S', 'F', 'G', 'L', 'Y', 'P', 'H', '\0'};
+    const sf::Uint32 glyphCacheVersion   = 2;
+    const sf::Uint32 glyphCacheByteOrder = 0x01020304;
+
+    struct CacheHeader
+    {
+        char       magic[8];
+        sf::Uint32 version;
+        sf::Uint32 byteOrder;
+        sf::Uint64 fontHash;
+        sf::Uint32 pageCount;
+        sf::Uint32 padding;
+    };
+
+    struct CachePage
+    {
+        sf::Uint32 characterSize;
+        sf::Uint32 textureWidth;
+        sf::Uint32 textureHeight;
+        sf::Uint32 nextRow;
+        sf::Uint32 rowCount;
+        sf::Uint32 glyphCount;
+        sf::Uint32 kerningCount;
+        sf::Uint32 padding;
+    };
+
+    struct CacheRow
+    {
+        sf::Uint32 width;
+        sf::Uint32 top;
+        sf::Uint32 height;
+        sf::Uint32 padding;
+    };
+
+    struct CacheGlyph
+    {
+        sf::Uint64 key;
+        float      advance;
+        float      bounds[4];
+        sf::Int32  textureRect[4];
+        sf::Uint32 padding;
+    };
+
+    struct CacheKerning
+    {
+        sf::Uint64 key;
+        float      value;
+        sf::Uint32 padding;
+    };
+
+    // Skip the given number of records of a glyph cache page, if the
+    // remaining bytes hold them; counts come from the file, so the
+    // size is checked with a division that can't overflow
+    bool skipRecords(std::size_t& remaining, std::size_t count, std::size_t recordSize)
+    {
+        if ((recordSize > 0) && (count > remaining / recordSize))
+            return false;
+
+        remaining -= count * recordSize;
+        return true;
+    }
+
+    // Add data to a 64-bits FNV-1a hash
+    void hash(sf::Uint64& value, const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            value ^= bytes[i];
+            value *= 1099511628211ULL;
+        }
+    }
+
+    // Compute the key identifying the glyphs that a face produces: the
+    // contents of the font file, and the version of the rasterizer
+    sf::Uint64 getFontHash(FT_Library library, FT_Face face)
+    {
+        sf::Uint64 value = 14695981039346656037ULL;
+
+        FT_Int version[3] = {0, 0, 0};
+        FT_Library_Version(library, &version[0], &version[1], &version[2]);
+        hash(value, version, sizeof(version));
+
+        // Memory and memory-mapped fonts are hashed in place; streams with a
+        // read function are read by chunks (their base is only the buffer of
+        // the current frame, and our stream callbacks seek first)
+        FT_Stream stream = face->stream;
+        if (!stream->read)
+        {
+            hash(value, stream->base, stream->size);
+        }
+        else
+        {
+            unsigned char buffer[4096];
+            for (unsigned long offset = 0; offset < stream->size;)
+            {
+                unsigned long count = std::min<unsigned long>(sizeof(buffer), stream->size - offset);
+                if (stream->read(stream, offset, buffer, count) != count)
+                    break;
+
+                hash(value, buffer, count);
+                offset += count;
+            }
+        }
+
+        return value;
+    }
+
+    // Status of a glyph within a rasterization batch
+    enum GlyphStatus
+    {
+        GlyphPending,    // not rasterized by a worker, must be loaded by the owning thread
+        GlyphRasterized, // rasterized by a worker, ready to be packed
+        GlyphFailed      // FreeType failed to load the glyph
+    };
 }
 
 
 namespace sf
 {
+////////////////////////////////////////////////////////////
+struct Font::GlyphBatch
+{
+    std::string                sourceFile;       ///< Path of the font file, if loaded from a file
+    const void*                sourceData;       ///< Pointer to the font data, if loaded from memory
+    std::size_t                sourceSize;       ///< Size of the font data, if loaded from memory
+    unsigned int               characterSize;    ///< Reference character size
+    bool                       bold;             ///< Rasterize the bold version?
+    float                      outlineThickness; ///< Thickness of outline
+    const std::vector<Uint32>* codePoints;       ///< Code points of all the glyphs to rasterize
+    std::vector<GlyphBitmap>*  bitmaps;          ///< Rasterized glyphs, one per code point
+    std::vector<Uint8>*        status;           ///< Status of each glyph (see GlyphStatus)
+    std::size_t                first;            ///< Index of the first glyph handled by this batch
+    std::size_t                step;             ///< Distance between two glyphs handled by this batch
+};
+
+
 ////////////////////////////////////////////////////////////
 Font::Font() :
 m_library  (NULL),
@@ -73,7 +219,9 @@ m_face     (NULL),
 m_streamRec(NULL),
 m_stroker  (NULL),
 m_refCount (NULL),
-m_info     ()
+m_info     (),
+m_sourceData(NULL),
+m_sourceSize(0)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -90,7 +238,10 @@ m_stroker    (copy.m_stroker),
 m_refCount   (copy.m_refCount),
 m_info       (copy.m_info),
 m_pages      (copy.m_pages),
-m_pixelBuffer(copy.m_pixelBuffer)
+m_pixelBuffer(copy.m_pixelBuffer),
+m_sourceFile (copy.m_sourceFile),
+m_sourceData (copy.m_sourceData),
+m_sourceSize (copy.m_sourceSize)
 {
     #ifdef SFML_SYSTEM_ANDROID
         m_stream = NULL;
@@ -168,6 +319,9 @@ bool Font::loadFromFile(const std::string& filename)
     m_stroker = stroker;
     m_face = face;
 
+    // Remember where the font comes from, so that worker threads can open their own face
+    m_sourceFile = filename;
+
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
@@ -233,6 +387,10 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     m_stroker = stroker;
     m_face = face;
 
+    // Remember where the font comes from, so that worker threads can open their own face
+    m_sourceData = data;
+    m_sourceSize = sizeInBytes;
+
     // Store the font information
     m_info.family = face->family_name ? face->family_name : std::string();
 
@@ -332,9 +490,7 @@ const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool b
     GlyphTable& glyphs = m_pages[characterSize].glyphs;
 
     // Build the key by combining the code point, bold flag, and outline thickness
-    Uint64 key = (static_cast<Uint64>(*reinterpret_cast<Uint32*>(&outlineThickness)) << 32)
-               | (static_cast<Uint64>(bold ? 1 : 0) << 31)
-               |  static_cast<Uint64>(codePoint);
+    Uint64 key = glyphKey(codePoint, bold, outlineThickness);
 
     // Search the glyph into the cache
     GlyphTable::const_iterator it = glyphs.find(key);
@@ -361,8 +517,24 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 
     FT_Face face = static_cast<FT_Face>(m_face);
 
-    if (face && FT_HAS_KERNING(face) && setCurrentSize(characterSize))
+    if (face && FT_HAS_KERNING(face))
     {
+        // Search the pair into the cache of the page; there is no page (and
+        // nothing is cached) until glyphs of this size are requested, since
+        // creating one creates its texture
+        PageTable::iterator page = m_pages.find(characterSize);
+        KerningTable* table = (page != m_pages.end()) ? &page->second.kerning : NULL;
+        Uint64 key = (static_cast<Uint64>(first) << 32) | static_cast<Uint64>(second);
+        if (table)
+        {
+            KerningTable::const_iterator it = table->find(key);
+            if (it != table->end())
+                return it->second;
+        }
+
+        if (!setCurrentSize(characterSize))
+            return 0.f;
+
         // Convert the characters to indices
         FT_UInt index1 = FT_Get_Char_Index(face, first);
         FT_UInt index2 = FT_Get_Char_Index(face, second);
@@ -372,11 +544,14 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
         FT_Get_Kerning(face, index1, index2, FT_KERNING_DEFAULT, &kerning);
 
         // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+        float offset = static_cast<float>(kerning.x);
+        if (FT_IS_SCALABLE(face))
+            offset /= static_cast<float>(1 << 6);
 
-        // Return the X advance
-        return static_cast<float>(kerning.x) / static_cast<float>(1 << 6);
+        if (table)
+            table->insert(std::make_pair(key, offset));
+
+        return offset;
     }
     else
     {
@@ -386,6 +561,102 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize)
 }
 
 
+////////////////////////////////////////////////////////////
+bool Font::preloadGlyphs(const String& characters, unsigned int characterSize, bool bold, float outlineThickness, unsigned int threadCount) const
+{
+    if (!m_face)
+        return false;
+
+    // Collect the glyphs which are not loaded yet
+    Page& page = m_pages[characterSize];
+    std::vector<Uint32> codePoints;
+    for (String::ConstIterator it = characters.begin(); it != characters.end(); ++it)
+    {
+        if (page.glyphs.find(glyphKey(*it, bold, outlineThickness)) == page.glyphs.end())
+            codePoints.push_back(*it);
+    }
+
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+
+    if (codePoints.empty())
+        return true;
+
+    std::vector<GlyphBitmap> bitmaps(codePoints.size());
+    std::vector<Uint8> status(codePoints.size(), GlyphPending);
+
+    // Fonts loaded from a stream can't be opened a second time, so the worker
+    // threads can only be used if we know where the font data comes from
+    bool canOpenFace = m_sourceData || !m_sourceFile.empty();
+    if (canOpenFace && (threadCount > 1) && (codePoints.size() > 1))
+    {
+        threadCount = static_cast<unsigned int>(std::min<std::size_t>(threadCount, codePoints.size()));
+
+        std::vector<GlyphBatch> batches(threadCount);
+        std::vector<Thread*> threads(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            GlyphBatch& batch = batches[i];
+            batch.sourceFile       = m_sourceFile;
+            batch.sourceData       = m_sourceData;
+            batch.sourceSize       = m_sourceSize;
+            batch.characterSize    = characterSize;
+            batch.bold             = bold;
+            batch.outlineThickness = outlineThickness;
+            batch.codePoints       = &codePoints;
+            batch.bitmaps          = &bitmaps;
+            batch.status           = &status;
+            batch.first            = i;
+            batch.step             = threadCount;
+
+            threads[i] = new Thread(&Font::rasterizeGlyphBatch, &batch);
+            threads[i]->launch();
+        }
+
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            threads[i]->wait();
+            delete threads[i];
+        }
+    }
+
+    // Pack the glyphs on the calling thread, the page and its texture are not thread-safe;
+    // glyphs that no worker could rasterize are loaded the usual way
+    unsigned int top = page.texture.getSize().y;
+    unsigned int bottom = 0;
+    for (std::size_t i = 0; i < codePoints.size(); ++i)
+    {
+        Glyph glyph;
+        if (status[i] == GlyphRasterized)
+        {
+            glyph = placeGlyph(page, bitmaps[i], false);
+
+            // Extend the band of rows to upload (including the padding around the glyph)
+            if (glyph.textureRect.width > 0)
+            {
+                top = std::min(top, static_cast<unsigned int>(glyph.textureRect.top - 1));
+                bottom = std::max(bottom, static_cast<unsigned int>(glyph.textureRect.top + glyph.textureRect.height + 1));
+            }
+        }
+        else if (status[i] == GlyphPending)
+        {
+            glyph = loadGlyph(codePoints[i], characterSize, bold, outlineThickness);
+        }
+
+        page.glyphs.insert(std::make_pair(glyphKey(codePoints[i], bold, outlineThickness), glyph));
+    }
+
+    // Upload all the new glyphs at once: rows of the page's pixels are contiguous
+    if (top < bottom)
+    {
+        unsigned int width = page.texture.getSize().x;
+        page.texture.update(&page.pixels[top * width], width, bottom - top, 0, top);
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 float Font::getLineSpacing(unsigned int characterSize) const
 {
@@ -449,6 +720,218 @@ const Texture& Font::getTexture(unsigned int characterSize) const
 }
 
 
+////////////////////////////////////////////////////////////
+bool Font::saveGlyphCache(const std::string& filename) const
+{
+    if (!m_face)
+    {
+        err() << "Failed to save glyph cache \"" << filename << "\" (no font loaded)" << std::endl;
+        return false;
+    }
+
+    std::ofstream file(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+    if (!file)
+    {
+        err() << "Failed to save glyph cache \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, glyphCacheMagic, sizeof(header.magic));
+    header.version   = glyphCacheVersion;
+    header.byteOrder = glyphCacheByteOrder;
+    header.fontHash  = getFontHash(static_cast<FT_Library>(m_library), static_cast<FT_Face>(m_face));
+    header.pageCount = static_cast<Uint32>(m_pages.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (PageTable::const_iterator it = m_pages.begin(); it != m_pages.end(); ++it)
+    {
+        const Page& page = it->second;
+
+        CachePage pageRecord;
+        std::memset(&pageRecord, 0, sizeof(pageRecord));
+        pageRecord.characterSize = it->first;
+        pageRecord.textureWidth  = page.texture.getSize().x;
+        pageRecord.textureHeight = page.texture.getSize().y;
+        pageRecord.nextRow       = page.nextRow;
+        pageRecord.rowCount      = static_cast<Uint32>(page.rows.size());
+        pageRecord.glyphCount    = static_cast<Uint32>(page.glyphs.size());
+        pageRecord.kerningCount  = static_cast<Uint32>(page.kerning.size());
+        file.write(reinterpret_cast<const char*>(&pageRecord), sizeof(pageRecord));
+
+        for (std::vector<Row>::const_iterator row = page.rows.begin(); row != page.rows.end(); ++row)
+        {
+            CacheRow record = {row->width, row->top, row->height, 0};
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+
+        for (GlyphTable::const_iterator glyph = page.glyphs.begin(); glyph != page.glyphs.end(); ++glyph)
+        {
+            const Glyph& g = glyph->second;
+            CacheGlyph record = {glyph->first, g.advance,
+                                 {g.bounds.left, g.bounds.top, g.bounds.width, g.bounds.height},
+                                 {g.textureRect.left, g.textureRect.top, g.textureRect.width, g.textureRect.height}, 0};
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+
+        for (KerningTable::const_iterator kerning = page.kerning.begin(); kerning != page.kerning.end(); ++kerning)
+        {
+            CacheKerning record = {kerning->first, kerning->second, 0};
+            file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        }
+
+        if (!page.pixels.empty())
+            file.write(reinterpret_cast<const char*>(&page.pixels[0]), page.pixels.size());
+    }
+
+    if (!file)
+    {
+        err() << "Failed to save glyph cache \"" << filename << "\" (failed to write the file)" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::loadGlyphCache(const std::string& filename)
+{
+    if (!m_face)
+    {
+        err() << "Failed to load glyph cache \"" << filename << "\" (no font loaded)" << std::endl;
+        return false;
+    }
+
+    // Read the whole file at once, the records are then used in place
+    std::ifstream file(filename.c_str(), std::ios_base::binary);
+    if (!file)
+    {
+        err() << "Failed to load glyph cache \"" << filename << "\" (failed to open the file)" << std::endl;
+        return false;
+    }
+
+    file.seekg(0, std::ios_base::end);
+    std::size_t size = static_cast<std::size_t>(file.tellg());
+    file.seekg(0, std::ios_base::beg);
+
+    std::vector<char> buffer(size);
+    if ((size < sizeof(CacheHeader)) || !file.read(&buffer[0], size))
+    {
+        err() << "Failed to load glyph cache \"" << filename << "\" (failed to read the file)" << std::endl;
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, &buffer[0], sizeof(header));
+    if ((std::memcmp(header.magic, glyphCacheMagic, sizeof(header.magic)) != 0) ||
+        (header.version != glyphCacheVersion) || (header.byteOrder != glyphCacheByteOrder))
+    {
+        err() << "Failed to load glyph cache \"" << filename << "\" (unsupported format)" << std::endl;
+        return false;
+    }
+
+    if (header.fontHash != getFontHash(static_cast<FT_Library>(m_library), static_cast<FT_Face>(m_face)))
+    {
+        err() << "Failed to load glyph cache \"" << filename << "\" (it was saved for another font)" << std::endl;
+        return false;
+    }
+
+    // Validate the whole file before touching any page
+    std::size_t remaining = size - sizeof(CacheHeader);
+    std::vector<std::size_t> pageOffsets;
+    for (Uint32 i = 0; i < header.pageCount; ++i)
+    {
+        std::size_t offset = size - remaining;
+
+        CachePage pageRecord;
+        if (!skipRecords(remaining, 1, sizeof(pageRecord)))
+            break;
+        std::memcpy(&pageRecord, &buffer[offset], sizeof(pageRecord));
+
+        // The texture is skipped as textureWidth columns of textureHeight bytes
+        if (!skipRecords(remaining, pageRecord.rowCount, sizeof(CacheRow)) ||
+            !skipRecords(remaining, pageRecord.glyphCount, sizeof(CacheGlyph)) ||
+            !skipRecords(remaining, pageRecord.kerningCount, sizeof(CacheKerning)) ||
+            !skipRecords(remaining, pageRecord.textureWidth, pageRecord.textureHeight))
+            break;
+
+        pageOffsets.push_back(offset);
+    }
+
+    if ((pageOffsets.size() != header.pageCount) || (remaining != 0))
+    {
+        err() << "Failed to load glyph cache \"" << filename << "\" (the file is corrupt)" << std::endl;
+        return false;
+    }
+
+    for (std::size_t i = 0; i < pageOffsets.size(); ++i)
+    {
+        const char* data = &buffer[pageOffsets[i]];
+
+        CachePage pageRecord;
+        std::memcpy(&pageRecord, data, sizeof(pageRecord));
+        data += sizeof(pageRecord);
+
+        Page& page = m_pages[pageRecord.characterSize];
+        page.glyphs.clear();
+        page.kerning.clear();
+        page.rows.clear();
+        page.nextRow = pageRecord.nextRow;
+
+        for (Uint32 j = 0; j < pageRecord.rowCount; ++j)
+        {
+            CacheRow record;
+            std::memcpy(&record, data, sizeof(record));
+            data += sizeof(record);
+
+            Row row(record.top, record.height);
+            row.width = record.width;
+            page.rows.push_back(row);
+        }
+
+        for (Uint32 j = 0; j < pageRecord.glyphCount; ++j)
+        {
+            CacheGlyph record;
+            std::memcpy(&record, data, sizeof(record));
+            data += sizeof(record);
+
+            Glyph glyph;
+            glyph.advance     = record.advance;
+            glyph.bounds      = FloatRect(record.bounds[0], record.bounds[1], record.bounds[2], record.bounds[3]);
+            glyph.textureRect = IntRect(record.textureRect[0], record.textureRect[1], record.textureRect[2], record.textureRect[3]);
+            page.glyphs.insert(page.glyphs.end(), std::make_pair(record.key, glyph));
+        }
+
+        for (Uint32 j = 0; j < pageRecord.kerningCount; ++j)
+        {
+            CacheKerning record;
+            std::memcpy(&record, data, sizeof(record));
+            data += sizeof(record);
+
+            page.kerning.insert(page.kerning.end(), std::make_pair(record.key, record.value));
+        }
+
+        // Upload the whole atlas at once
+        if (pageRecord.textureWidth && pageRecord.textureHeight)
+        {
+            if (!page.texture.create(pageRecord.textureWidth, pageRecord.textureHeight, A8))
+            {
+                err() << "Failed to load glyph cache \"" << filename << "\" (failed to create the texture)" << std::endl;
+                m_pages.erase(pageRecord.characterSize);
+                return false;
+            }
+
+            page.pixels.assign(data, data + static_cast<std::size_t>(pageRecord.textureWidth) * pageRecord.textureHeight);
+            page.texture.update(&page.pixels[0]);
+        }
+    }
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator =(const Font& right)
 {
@@ -462,6 +945,9 @@ Font& Font::operator =(const Font& right)
     std::swap(m_info,        temp.m_info);
     std::swap(m_pages,       temp.m_pages);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
+    std::swap(m_sourceFile,  temp.m_sourceFile);
+    std::swap(m_sourceData,  temp.m_sourceData);
+    std::swap(m_sourceSize,  temp.m_sourceSize);
 
     #ifdef SFML_SYSTEM_ANDROID
         std::swap(m_stream, temp.m_stream);
@@ -512,35 +998,50 @@ void Font::cleanup()
     m_refCount  = NULL;
     m_pages.clear();
     std::vector<Uint8>().swap(m_pixelBuffer);
+    m_sourceFile.clear();
+    m_sourceData = NULL;
+    m_sourceSize = 0;
 }
 
 
 ////////////////////////////////////////////////////////////
 Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
-    // The glyph to return
-    Glyph glyph;
-
-    // First, transform our ugly void* to a FT_Face
-    FT_Face face = static_cast<FT_Face>(m_face);
-    if (!face)
-        return glyph;
+    // Make sure that a font is loaded
+    if (!m_face)
+        return Glyph();
 
     // Set the character size
     if (!setCurrentSize(characterSize))
-        return glyph;
+        return Glyph();
+
+    // Rasterize the glyph with our own FreeType objects
+    GlyphBitmap bitmap;
+    if (!rasterizeGlyph(m_library, m_face, m_stroker, codePoint, bold, outlineThickness, bitmap))
+        return Glyph();
+
+    // Insert it into the page corresponding to the character size
+    return placeGlyph(m_pages[characterSize], bitmap, true);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::rasterizeGlyph(void* library, void* face, void* stroker, Uint32 codePoint, bool bold, float outlineThickness, GlyphBitmap& bitmap)
+{
+    // First, transform our ugly void* to a FT_Face
+    FT_Face ftFace = static_cast<FT_Face>(face);
 
     // Load the glyph corresponding to the code point
     FT_Int32 flags = FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT;
     if (outlineThickness != 0)
         flags |= FT_LOAD_NO_BITMAP;
-    if (FT_Load_Char(face, codePoint, flags) != 0)
-        return glyph;
+    if (FT_Load_Char(ftFace, codePoint, flags) != 0)
+        return false;
 
     // Retrieve the glyph
     FT_Glyph glyphDesc;
-    if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
-        return glyph;
+    if (FT_Get_Glyph(ftFace->glyph, &glyphDesc) != 0)
+        return false;
 
     // Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
     FT_Pos weight = 1 << 6;
@@ -555,46 +1056,133 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
 
         if (outlineThickness != 0)
         {
-            FT_Stroker stroker = static_cast<FT_Stroker>(m_stroker);
+            FT_Stroker ftStroker = static_cast<FT_Stroker>(stroker);
 
-            FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
-            FT_Glyph_Stroke(&glyphDesc, stroker, false);
+            FT_Stroker_Set(ftStroker, static_cast<FT_Fixed>(outlineThickness * static_cast<float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+            FT_Glyph_Stroke(&glyphDesc, ftStroker, false);
         }
     }
 
     // Convert the glyph to a bitmap (i.e. rasterize it)
     FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1);
-    FT_Bitmap& bitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
+    FT_Bitmap& ftBitmap = reinterpret_cast<FT_BitmapGlyph>(glyphDesc)->bitmap;
 
     // Apply bold if necessary -- fallback technique using bitmap (lower quality)
     if (!outline)
     {
         if (bold)
-            FT_Bitmap_Embolden(static_cast<FT_Library>(m_library), &bitmap, weight, weight);
+            FT_Bitmap_Embolden(static_cast<FT_Library>(library), &ftBitmap, weight, weight);
 
+        // Reported by placeGlyph, this function may run on a worker thread
         if (outlineThickness != 0)
-            err() << "Failed to outline glyph (no fallback available)" << std::endl;
+            bitmap.outlineFailed = true;
     }
 
     // Compute the glyph's advance offset
-    glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
+    Glyph& glyph = bitmap.glyph;
+    glyph.advance = static_cast<float>(ftFace->glyph->metrics.horiAdvance) / static_cast<float>(1 << 6);
     if (bold)
         glyph.advance += static_cast<float>(weight) / static_cast<float>(1 << 6);
 
-    int width  = bitmap.width;
-    int height = bitmap.rows;
+    bitmap.width  = ftBitmap.width;
+    bitmap.height = ftBitmap.rows;
 
-    if ((width > 0) && (height > 0))
+    if ((bitmap.width > 0) && (bitmap.height > 0))
+    {
+        // Compute the glyph's bounding box
+        glyph.bounds.left   =  static_cast<float>(ftFace->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
+        glyph.bounds.top    = -static_cast<float>(ftFace->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
+        glyph.bounds.width  =  static_cast<float>(ftFace->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
+        glyph.bounds.height =  static_cast<float>(ftFace->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
+
+        // Extract the glyph's coverage from the bitmap
+        bitmap.pixels.resize(bitmap.width * bitmap.height);
+        const Uint8* pixels = ftBitmap.buffer;
+        Uint8* coverage = &bitmap.pixels[0];
+        if (ftBitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+        {
+            // Pixels are 1 bit monochrome values
+            for (unsigned int y = 0; y < bitmap.height; ++y)
+            {
+                for (unsigned int x = 0; x < bitmap.width; ++x)
+                    *coverage++ = (pixels[x / 8] & (1 << (7 - (x % 8)))) ? 255 : 0;
+                pixels += ftBitmap.pitch;
+            }
+        }
+        else
+        {
+            // Pixels are 8 bits gray levels
+            for (unsigned int y = 0; y < bitmap.height; ++y)
+            {
+                std::memcpy(coverage, pixels, bitmap.width);
+                coverage += bitmap.width;
+                pixels += ftBitmap.pitch;
+            }
+        }
+    }
+
+    // Delete the FT glyph
+    FT_Done_Glyph(glyphDesc);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Font::rasterizeGlyphBatch(GlyphBatch* batch)
+{
+    // Open a private face on the font data: FreeType objects
+    // must not be used by several threads at the same time
+    FT_Library library;
+    if (FT_Init_FreeType(&library) != 0)
+        return;
+
+    FT_Face face = NULL;
+    FT_Error error;
+    if (batch->sourceData)
+        error = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(batch->sourceData), static_cast<FT_Long>(batch->sourceSize), 0, &face);
+    else
+        error = FT_New_Face(library, batch->sourceFile.c_str(), 0, &face);
+
+    FT_Stroker stroker = NULL;
+    if ((error == 0) &&
+        (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0) &&
+        (FT_Stroker_New(library, &stroker) == 0) &&
+        (FT_Set_Pixel_Sizes(face, 0, batch->characterSize) == 0))
+    {
+        // Rasterize our share of the glyphs; each element is written by a single thread
+        for (std::size_t i = batch->first; i < batch->codePoints->size(); i += batch->step)
+        {
+            bool rasterized = rasterizeGlyph(library, face, stroker, (*batch->codePoints)[i], batch->bold, batch->outlineThickness, (*batch->bitmaps)[i]);
+            (*batch->status)[i] = rasterized ? GlyphRasterized : GlyphFailed;
+        }
+    }
+
+    // Glyphs left pending (if anything failed above) will be loaded by the owning thread
+    if (stroker)
+        FT_Stroker_Done(stroker);
+    if (face)
+        FT_Done_Face(face);
+    FT_Done_FreeType(library);
+}
+
+
+////////////////////////////////////////////////////////////
+Glyph Font::placeGlyph(Page& page, const GlyphBitmap& bitmap, bool upload) const
+{
+    Glyph glyph = bitmap.glyph;
+
+    if (bitmap.outlineFailed)
+        err() << "Failed to outline glyph (no fallback available)" << std::endl;
+
+    if ((bitmap.width > 0) && (bitmap.height > 0))
     {
         // Leave a small padding around characters, so that filtering doesn't
         // pollute them with pixels from neighbors
         const unsigned int padding = 1;
 
-        width += 2 * padding;
-        height += 2 * padding;
-
-        // Get the glyphs page corresponding to the character size
-        Page& page = m_pages[characterSize];
+        unsigned int width  = bitmap.width + 2 * padding;
+        unsigned int height = bitmap.height + 2 * padding;
 
         // Find a good position for the new glyph into the texture
         glyph.textureRect = findGlyphRect(page, width, height);
@@ -606,69 +1194,35 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         glyph.textureRect.width -= 2 * padding;
         glyph.textureRect.height -= 2 * padding;
 
-        // Compute the glyph's bounding box
-        glyph.bounds.left   =  static_cast<float>(face->glyph->metrics.horiBearingX) / static_cast<float>(1 << 6);
-        glyph.bounds.top    = -static_cast<float>(face->glyph->metrics.horiBearingY) / static_cast<float>(1 << 6);
-        glyph.bounds.width  =  static_cast<float>(face->glyph->metrics.width)        / static_cast<float>(1 << 6) + outlineThickness * 2;
-        glyph.bounds.height =  static_cast<float>(face->glyph->metrics.height)       / static_cast<float>(1 << 6) + outlineThickness * 2;
-
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(width * height * 4);
+        // The page is full (an error has already been reported)
+        if ((glyph.textureRect.width != static_cast<int>(bitmap.width)) || (glyph.textureRect.height != static_cast<int>(bitmap.height)))
+            return glyph;
 
-        Uint8* current = &m_pixelBuffer[0];
-        Uint8* end = current + width * height * 4;
-
-        while (current != end)
+        // Copy the glyph's coverage to the pixels of the page; the
+        // padding around it is never written, so it stays transparent
+        unsigned int pageWidth = page.texture.getSize().x;
+        const Uint8* coverage = &bitmap.pixels[0];
+        for (unsigned int y = 0; y < bitmap.height; ++y)
         {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
+            std::size_t index = glyph.textureRect.left + (glyph.textureRect.top + y) * pageWidth;
+            std::memcpy(&page.pixels[index], coverage, bitmap.width);
+            coverage += bitmap.width;
         }
 
-        // Extract the glyph's pixels from the bitmap
-        const Uint8* pixels = bitmap.buffer;
-        if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
-        {
-            // Pixels are 1 bit monochrome values
-            for (int y = padding; y < height - padding; ++y)
-            {
-                for (int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
-                pixels += bitmap.pitch;
-            }
-        }
-        else
+        if (upload)
         {
-            // Pixels are 8 bits gray levels
-            for (int y = padding; y < height - padding; ++y)
-            {
-                for (int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
-                pixels += bitmap.pitch;
-            }
-        }
+            // Gather the glyph and its padding in a contiguous buffer, and write it to the texture
+            unsigned int x = glyph.textureRect.left - padding;
+            unsigned int y = glyph.textureRect.top - padding;
 
-        // Write the pixels to the texture
-        unsigned int x = glyph.textureRect.left - padding;
-        unsigned int y = glyph.textureRect.top - padding;
-        unsigned int w = glyph.textureRect.width + 2 * padding;
-        unsigned int h = glyph.textureRect.height + 2 * padding;
-        page.texture.update(&m_pixelBuffer[0], w, h, x, y);
-    }
+            m_pixelBuffer.resize(width * height);
+            for (unsigned int row = 0; row < height; ++row)
+                std::memcpy(&m_pixelBuffer[row * width], &page.pixels[x + (y + row) * pageWidth], width);
 
-    // Delete the FT glyph
-    FT_Done_Glyph(glyphDesc);
+            page.texture.update(&m_pixelBuffer[0], width, height, x, y);
+        }
+    }
 
-    // Done :)
     return glyph;
 }
 
@@ -711,11 +1265,17 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
             unsigned int textureHeight = page.texture.getSize().y;
             if ((textureWidth * 2 <= Texture::getMaximumSize()) && (textureHeight * 2 <= Texture::getMaximumSize()))
             {
-                // Make the texture 2 times bigger
+                // Make the texture 2 times bigger, and upload the existing glyphs to it
+                std::vector<Uint8> newPixels(textureWidth * 2 * textureHeight * 2, 0);
+                for (unsigned int y = 0; y < textureHeight; ++y)
+                    std::memcpy(&newPixels[y * textureWidth * 2], &page.pixels[y * textureWidth], textureWidth);
+
                 Texture newTexture;
-                newTexture.create(textureWidth * 2, textureHeight * 2);
-                newTexture.update(page.texture);
+                newTexture.create(textureWidth * 2, textureHeight * 2, A8);
+                newTexture.setSmooth(true);
+                newTexture.update(&newPixels[0]);
                 page.texture.swap(newTexture);
+                page.pixels.swap(newPixels);
             }
             else
             {
@@ -779,20 +1339,36 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 
 ////////////////////////////////////////////////////////////
 Font::Page::Page() :
-nextRow(3)
+nextRow(3),
+pixels (128 * 128, 0)
 {
-    // Make sure that the texture is initialized by default
-    sf::Image image;
-    image.create(128, 128, Color(255, 255, 255, 0));
-
     // Reserve a 2x2 white square for texturing underlines
     for (int x = 0; x < 2; ++x)
         for (int y = 0; y < 2; ++y)
-            image.setPixel(x, y, Color(255, 255, 255, 255));
+            pixels[x + y * 128] = 255;
+
+    // Create the texture, which reads back from our copy of its pixels
+    texture.create(128, 128, A8);
+    texture.update(&pixels[0]);
+    texture.setSmooth(true);
+    texture.m_pixelCopy = &pixels;
+}
+
 
-    // Create the texture
-    texture.loadFromImage(image);
+////////////////////////////////////////////////////////////
+Font::Page::Page(const Page& copy) :
+glyphs (copy.glyphs),
+kerning(copy.kerning),
+nextRow(copy.nextRow),
+rows   (copy.rows),
+pixels (copy.pixels)
+{
+    // Alpha-only textures can't be copied on the GPU,
+    // so the texture is rebuilt from our copy of its pixels
+    texture.create(copy.texture.getSize().x, copy.texture.getSize().y, A8);
+    texture.update(&pixels[0]);
     texture.setSmooth(true);
+    texture.m_pixelCopy = &pixels;
 }
 
 } // namespace sf
@@ -70,6 +70,9 @@ void glCheckError(const char* file, unsigned int line, const char* expression)
                 break;
             }
 
+        #ifndef SFML_OPENGL_ES2
+
+            // OpenGL ES 2 has no matrix or attribute stacks
             case GL_STACK_OVERFLOW:
             {
                 error = "GL_STACK_OVERFLOW";
@@ -84,6 +87,8 @@ void glCheckError(const char* file, unsigned int line, const char* expression)
                 break;
             }
 
+        #endif
+
             case GL_OUT_OF_MEMORY:
             {
                 error = "GL_OUT_OF_MEMORY";
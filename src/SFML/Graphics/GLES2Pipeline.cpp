@@ -0,0 +1,244 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLES2Pipeline.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+
+
+namespace
+{
+    const char* defaultVertexShader =
+        "uniform mat4 sf_ProjectionMatrix;\n"
+        "uniform mat4 sf_ModelViewMatrix;\n"
+        "uniform mat4 sf_TextureMatrix;\n"
+        "attribute vec4 sf_Vertex;\n"
+        "attribute vec4 sf_Color;\n"
+        "attribute vec4 sf_MultiTexCoord0;\n"
+        "varying vec4 sf_FrontColor;\n"
+        "varying vec4 sf_TexCoord;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_Position = sf_ProjectionMatrix * (sf_ModelViewMatrix * sf_Vertex);\n"
+        "    sf_FrontColor = sf_Color;\n"
+        "    sf_TexCoord = sf_TextureMatrix * sf_MultiTexCoord0;\n"
+        "}\n";
+
+    const char* texturedFragmentShader =
+        "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+        "precision highp float;\n"
+        "#else\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "uniform sampler2D sf_Texture;\n"
+        "varying vec4 sf_FrontColor;\n"
+        "varying vec4 sf_TexCoord;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = sf_FrontColor * texture2D(sf_Texture, sf_TexCoord.xy);\n"
+        "}\n";
+
+    const char* alphaTexturedFragmentShader =
+        "#ifdef GL_FRAGMENT_PRECISION_HIGH\n"
+        "precision highp float;\n"
+        "#else\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "uniform sampler2D sf_Texture;\n"
+        "varying vec4 sf_FrontColor;\n"
+        "varying vec4 sf_TexCoord;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = vec4(sf_FrontColor.rgb, sf_FrontColor.a * texture2D(sf_Texture, sf_TexCoord.xy).a);\n"
+        "}\n";
+
+    const char* untexturedFragmentShader =
+        "precision mediump float;\n"
+        "varying vec4 sf_FrontColor;\n"
+        "void main()\n"
+        "{\n"
+        "    gl_FragColor = sf_FrontColor;\n"
+        "}\n";
+
+    // Names of the matrix uniforms, in the order of the arguments of uploadMatrices
+    const char* matrixNames[] = {"sf_ProjectionMatrix", "sf_ModelViewMatrix", "sf_TextureMatrix"};
+
+    // Compile one stage of a default program
+    GLuint compileShader(GLenum type, const char* source)
+    {
+        GLuint shader;
+        glCheck(shader = glCreateShader(type));
+        glCheck(glShaderSource(shader, 1, &source, NULL));
+        glCheck(glCompileShader(shader));
+
+        GLint success;
+        glCheck(glGetShaderiv(shader, GL_COMPILE_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            char log[1024];
+            glCheck(glGetShaderInfoLog(shader, sizeof(log), 0, log));
+            sf::err() << "Failed to compile default shader:" << std::endl
+                      << log << std::endl;
+            glCheck(glDeleteShader(shader));
+            return 0;
+        }
+
+        return shader;
+    }
+
+    // Create a default program from the default vertex program and the given fragment program
+    GLuint createProgram(const char* fragmentShaderCode)
+    {
+        GLuint vertexShader = compileShader(GL_VERTEX_SHADER, defaultVertexShader);
+        GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderCode);
+
+        GLuint program = 0;
+        if (vertexShader && fragmentShader)
+        {
+            glCheck(program = glCreateProgram());
+            glCheck(glAttachShader(program, vertexShader));
+            glCheck(glAttachShader(program, fragmentShader));
+            sf::priv::bindVertexAttributes(program);
+            glCheck(glLinkProgram(program));
+
+            GLint success;
+            glCheck(glGetProgramiv(program, GL_LINK_STATUS, &success));
+            if (success == GL_FALSE)
+            {
+                char log[1024];
+                glCheck(glGetProgramInfoLog(program, sizeof(log), 0, log));
+                sf::err() << "Failed to link default shader:" << std::endl
+                          << log << std::endl;
+                glCheck(glDeleteProgram(program));
+                program = 0;
+            }
+        }
+
+        // The shaders are kept alive by the program they are attached to
+        if (vertexShader)
+            glCheck(glDeleteShader(vertexShader));
+        if (fragmentShader)
+            glCheck(glDeleteShader(fragmentShader));
+
+        return program;
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+const char* getDefaultVertexShader()
+{
+    return defaultVertexShader;
+}
+
+
+////////////////////////////////////////////////////////////
+const char* getDefaultFragmentShader()
+{
+    return texturedFragmentShader;
+}
+
+
+////////////////////////////////////////////////////////////
+void bindVertexAttributes(GLuint program)
+{
+    glCheck(glBindAttribLocation(program, PositionAttribute, "sf_Vertex"));
+    glCheck(glBindAttribLocation(program, ColorAttribute, "sf_Color"));
+    glCheck(glBindAttribLocation(program, TexCoordsAttribute, "sf_MultiTexCoord0"));
+}
+
+
+////////////////////////////////////////////////////////////
+ProgramState::ProgramState(GLuint program, bool ownsProgram) :
+m_program    (program),
+m_ownsProgram(ownsProgram)
+{
+    for (int i = 0; i < MatrixCount; ++i)
+    {
+        glCheck(m_locations[i] = glGetUniformLocation(program, matrixNames[i]));
+        m_uploaded[i] = false;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ProgramState::~ProgramState()
+{
+    if (m_ownsProgram)
+    {
+        TransientContextLock lock;
+
+        glCheck(glDeleteProgram(m_program));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ProgramState* ProgramState::createDefault(DefaultProgram type)
+{
+    const char* fragmentShaders[DefaultProgramCount] = {untexturedFragmentShader, texturedFragmentShader, alphaTexturedFragmentShader};
+    GLuint program = createProgram(fragmentShaders[type]);
+
+    return program ? new ProgramState(program, true) : NULL;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint ProgramState::getProgram() const
+{
+    return m_program;
+}
+
+
+////////////////////////////////////////////////////////////
+void ProgramState::uploadMatrices(const float* projectionMatrix, const float* modelViewMatrix, const float* textureMatrix)
+{
+    // Upload the matrices that changed since they were last uploaded to the program
+    const float* matrices[MatrixCount] = {projectionMatrix, modelViewMatrix, textureMatrix};
+    for (int i = 0; i < MatrixCount; ++i)
+    {
+        if (m_locations[i] == -1)
+            continue;
+
+        if (!m_uploaded[i] || (std::memcmp(m_matrices[i], matrices[i], sizeof(m_matrices[i])) != 0))
+        {
+            glCheck(glUniformMatrix4fv(m_locations[i], 1, GL_FALSE, matrices[i]));
+            std::memcpy(m_matrices[i], matrices[i], sizeof(m_matrices[i]));
+            m_uploaded[i] = true;
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
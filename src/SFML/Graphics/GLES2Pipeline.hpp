@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLES2PIPELINE_HPP
+#define SFML_GLES2PIPELINE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// OpenGL ES 2 has no fixed-function pipeline: vertices are
+// fed through generic attributes, and the matrices that
+// sf::RenderTarget loads with glLoadMatrixf on the other
+// backends become uniforms. The default programs and the
+// custom sf::Shader programs share the same interface:
+//
+// attribute vec4 sf_Vertex;          // location 0
+// attribute vec4 sf_Color;           // location 1
+// attribute vec4 sf_MultiTexCoord0;  // location 2
+// uniform mat4 sf_ProjectionMatrix;
+// uniform mat4 sf_ModelViewMatrix;
+// uniform mat4 sf_TextureMatrix;
+//
+// The default vertex program passes the color and the
+// texture coordinates to the fragment program through
+// "varying vec4 sf_FrontColor" and "varying vec4 sf_TexCoord".
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \brief Locations of the vertex attributes
+///
+////////////////////////////////////////////////////////////
+enum VertexAttribute
+{
+    PositionAttribute  = 0, ///< sf_Vertex, 2 floats
+    ColorAttribute     = 1, ///< sf_Color, 4 normalized bytes
+    TexCoordsAttribute = 2  ///< sf_MultiTexCoord0, 2 floats
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Get the source of the default vertex program
+///
+/// \return GLSL ES source code
+///
+////////////////////////////////////////////////////////////
+const char* getDefaultVertexShader();
+
+////////////////////////////////////////////////////////////
+/// \brief Get the source of the default textured fragment program
+///
+/// The color is modulated by the texture bound to unit 0.
+///
+/// \return GLSL ES source code
+///
+////////////////////////////////////////////////////////////
+const char* getDefaultFragmentShader();
+
+////////////////////////////////////////////////////////////
+/// \brief Assign the SFML attribute locations to a program
+///
+/// This function must be called before the program is linked.
+///
+/// \param program Program to prepare
+///
+////////////////////////////////////////////////////////////
+void bindVertexAttributes(GLuint program);
+
+////////////////////////////////////////////////////////////
+/// \brief Program used to draw, with the value of its matrix uniforms
+///
+/// Uniform values belong to the program, so every program
+/// has a single state, kept by the owner of the program:
+/// sf::Shader keeps the state of its program, and each
+/// sf::RenderTarget creates its own default programs in its
+/// own context. Drawing thus never takes a lock, and targets
+/// drawn from different threads don't overwrite the matrices
+/// of each other's default programs.
+///
+////////////////////////////////////////////////////////////
+class ProgramState : GlResource, NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Kinds of default programs
+    ///
+    ////////////////////////////////////////////////////////////
+    enum DefaultProgram
+    {
+        Untextured,    ///< Color of the vertices
+        Textured,      ///< Color of the vertices times the texture
+        AlphaTextured, ///< Color of the vertices times the alpha of the texture (A8 textures sample as black)
+
+        DefaultProgramCount ///< Keep last -- the total number of default programs
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the state of a linked program
+    ///
+    /// The locations of the matrix uniforms are looked up, so
+    /// a context must be active.
+    ///
+    /// \param program     Linked program
+    /// \param ownsProgram Must the program be deleted with the state?
+    ///
+    ////////////////////////////////////////////////////////////
+    ProgramState(GLuint program, bool ownsProgram);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ProgramState();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a default program
+    ///
+    /// \param type Kind of default program to create
+    ///
+    /// \return New program state owning the program, or NULL on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static ProgramState* createDefault(DefaultProgram type);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the program
+    ///
+    /// \return OpenGL name of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    GLuint getProgram() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload the matrices to the program
+    ///
+    /// The program must be the current one. A matrix is only
+    /// uploaded when its value differs from the one last
+    /// uploaded to the program.
+    ///
+    /// \param projectionMatrix 4x4 projection matrix
+    /// \param modelViewMatrix  4x4 model-view matrix
+    /// \param textureMatrix    4x4 texture matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    void uploadMatrices(const float* projectionMatrix, const float* modelViewMatrix, const float* textureMatrix);
+
+private:
+
+    enum {MatrixCount = 3};
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    GLuint m_program;                   ///< OpenGL name of the program
+    bool   m_ownsProgram;               ///< Must the program be deleted with the state?
+    GLint  m_locations[MatrixCount];    ///< Locations of the matrix uniforms, -1 if unused
+    bool   m_uploaded[MatrixCount];     ///< Was each matrix uploaded yet?
+    float  m_matrices[MatrixCount][16]; ///< Values last uploaded
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLES2PIPELINE_HPP
@@ -28,6 +28,7 @@
 #include <SFML/Graphics/GLExtensions.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
+#include <cstring>
 
 #if !defined(GL_MAJOR_VERSION)
     #define GL_MAJOR_VERSION 0x821B
@@ -38,6 +39,18 @@
 #endif
 
 
+#if defined(SFML_OPENGL_ES2)
+
+namespace
+{
+    PFNGLGETPROGRAMBINARYOESPROC glGetProgramBinaryOESFunction = NULL;
+    PFNGLPROGRAMBINARYOESPROC    glProgramBinaryOESFunction    = NULL;
+    bool                         textureSwizzle                = false;
+}
+
+#endif
+
+
 namespace sf
 {
 namespace priv
@@ -85,9 +98,100 @@ void ensureExtensionsInit()
             err() << "Ensure that hardware acceleration is enabled if available" << std::endl;
         }
     }
+#elif defined(SFML_OPENGL_ES2)
+    static bool initialized = false;
+    if (!initialized)
+    {
+        initialized = true;
+
+        // The functions of OES_get_program_binary are not exported by every library
+        if (Context::isExtensionAvailable("GL_OES_get_program_binary"))
+        {
+            glGetProgramBinaryOESFunction = reinterpret_cast<PFNGLGETPROGRAMBINARYOESPROC>(Context::getFunction("glGetProgramBinaryOES"));
+            glProgramBinaryOESFunction = reinterpret_cast<PFNGLPROGRAMBINARYOESPROC>(Context::getFunction("glProgramBinaryOES"));
+        }
+
+        // Texture swizzles are core since OpenGL ES 3.0, and the
+        // version string always begins with "OpenGL ES major.minor"
+        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+        textureSwizzle = version && (std::strncmp(version, "OpenGL ES ", 10) == 0) && (version[10] >= '3') && (version[10] <= '9');
+    }
 #endif
 }
 
+
+#if defined(SFML_OPENGL_ES2)
+
+////////////////////////////////////////////////////////////
+void deleteObject(GLuint object)
+{
+    // Shaders and programs share the same namespace
+    if (glIsProgram(object))
+        glDeleteProgram(object);
+    else
+        glDeleteShader(object);
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint getHandle(GLenum binding)
+{
+    GLint handle = 0;
+    glGetIntegerv(binding, &handle);
+
+    return static_cast<GLuint>(handle);
+}
+
+
+////////////////////////////////////////////////////////////
+void getObjectParameteriv(GLuint object, GLenum name, GLint* value)
+{
+    if (glIsProgram(object))
+        glGetProgramiv(object, name, value);
+    else
+        glGetShaderiv(object, name, value);
+}
+
+
+////////////////////////////////////////////////////////////
+void getInfoLog(GLuint object, GLsizei maxLength, GLsizei* length, GLchar* log)
+{
+    if (glIsProgram(object))
+        glGetProgramInfoLog(object, maxLength, length, log);
+    else
+        glGetShaderInfoLog(object, maxLength, length, log);
+}
+
+
+////////////////////////////////////////////////////////////
+bool isProgramBinaryAvailable()
+{
+    return glGetProgramBinaryOESFunction && glProgramBinaryOESFunction;
+}
+
+
+////////////////////////////////////////////////////////////
+bool isTextureSwizzleAvailable()
+{
+    return textureSwizzle;
+}
+
+
+////////////////////////////////////////////////////////////
+void getProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary)
+{
+    glGetProgramBinaryOESFunction(program, bufferSize, length, format, binary);
+}
+
+
+////////////////////////////////////////////////////////////
+void programBinary(GLuint program, GLenum format, const void* binary, GLint length)
+{
+    glProgramBinaryOESFunction(program, format, binary, length);
+}
+
+#endif
+
 } // namespace priv
 
 } // namespace sf
@@ -30,7 +30,152 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
 
-#ifdef SFML_OPENGL_ES
+#if defined(SFML_OPENGL_ES2)
+
+    #include <SFML/OpenGL.hpp>
+
+    // The programmable backend requires OpenGL ES 2.0
+    // Most of the extensions needed by SFML are core in OpenGL ES 2.0,
+    // the functions which were merged or split when shader objects
+    // became core are wrapped in sf::priv (see below)
+
+    // Core since 2.0
+    #define GLEXT_multitexture                        true
+    #define GLEXT_texture_edge_clamp                  true
+    #define GLEXT_EXT_texture_edge_clamp              true
+    #define GLEXT_blend_minmax                        true
+    #define GLEXT_glActiveTexture                     glActiveTexture
+    #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE
+    #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
+    #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             GL_UNSIGNED_SHORT_5_6_5
+    #define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4           GL_UNSIGNED_SHORT_4_4_4_4
+    #define GLEXT_GL_BLEND_SRC                        GL_BLEND_SRC_RGB
+    #define GLEXT_GL_BLEND_DST                        GL_BLEND_DST_RGB
+
+    // Core since 2.0 - OES_blend_subtract
+    #define GLEXT_blend_subtract                      true
+    #define GLEXT_glBlendEquation                     glBlendEquation
+    #define GLEXT_GL_BLEND_EQUATION                   GL_BLEND_EQUATION
+    #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD
+    #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT
+    #define GLEXT_GL_FUNC_REVERSE_SUBTRACT            GL_FUNC_REVERSE_SUBTRACT
+
+    // Core since 2.0 - OES_blend_func_separate
+    #define GLEXT_blend_func_separate                 true
+    #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparate
+    #define GLEXT_GL_BLEND_SRC_RGB                    GL_BLEND_SRC_RGB
+    #define GLEXT_GL_BLEND_DST_RGB                    GL_BLEND_DST_RGB
+    #define GLEXT_GL_BLEND_SRC_ALPHA                  GL_BLEND_SRC_ALPHA
+    #define GLEXT_GL_BLEND_DST_ALPHA                  GL_BLEND_DST_ALPHA
+
+    // Core since 2.0 - OES_blend_equation_separate
+    #define GLEXT_blend_equation_separate             true
+    #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparate
+    #define GLEXT_GL_BLEND_EQUATION_ALPHA             GL_BLEND_EQUATION_ALPHA
+
+    // Core since 2.0 - OES_texture_npot
+    // (only the limited version: no mipmaps and no repeat wrapping)
+    #define GLEXT_texture_non_power_of_two            false
+
+    // Core since 2.0 - OES_framebuffer_object
+    #define GLEXT_framebuffer_object                  true
+    #define GLEXT_glBindRenderbuffer                  glBindRenderbuffer
+    #define GLEXT_glDeleteRenderbuffers               glDeleteRenderbuffers
+    #define GLEXT_glGenRenderbuffers                  glGenRenderbuffers
+    #define GLEXT_glRenderbufferStorage               glRenderbufferStorage
+    #define GLEXT_glBindFramebuffer                   glBindFramebuffer
+    #define GLEXT_glDeleteFramebuffers                glDeleteFramebuffers
+    #define GLEXT_glGenFramebuffers                   glGenFramebuffers
+    #define GLEXT_glCheckFramebufferStatus            glCheckFramebufferStatus
+    #define GLEXT_glFramebufferTexture2D              glFramebufferTexture2D
+    #define GLEXT_glFramebufferRenderbuffer           glFramebufferRenderbuffer
+    #define GLEXT_glGenerateMipmap                    glGenerateMipmap
+    #define GLEXT_GL_FRAMEBUFFER                      GL_FRAMEBUFFER
+    #define GLEXT_GL_RENDERBUFFER                     GL_RENDERBUFFER
+    #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT16
+    #define GLEXT_GL_COLOR_ATTACHMENT0                GL_COLOR_ATTACHMENT0
+    #define GLEXT_GL_DEPTH_ATTACHMENT                 GL_DEPTH_ATTACHMENT
+    #define GLEXT_GL_FRAMEBUFFER_COMPLETE             GL_FRAMEBUFFER_COMPLETE
+    #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING
+    #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION
+
+    // Core since 2.0 - shading language, shader objects, vertex and fragment shaders
+    #define GLEXT_shading_language_100                true
+    #define GLEXT_shader_objects                      true
+    #define GLEXT_glDeleteObject                      sf::priv::deleteObject
+    #define GLEXT_glGetHandle                         sf::priv::getHandle
+    #define GLEXT_glCreateShaderObject                glCreateShader
+    #define GLEXT_glShaderSource                      glShaderSource
+    #define GLEXT_glCompileShader                     glCompileShader
+    #define GLEXT_glCreateProgramObject               glCreateProgram
+    #define GLEXT_glAttachObject                      glAttachShader
+    #define GLEXT_glLinkProgram                       glLinkProgram
+    #define GLEXT_glUseProgramObject                  glUseProgram
+    #define GLEXT_glUniform1f                         glUniform1f
+    #define GLEXT_glUniform2f                         glUniform2f
+    #define GLEXT_glUniform3f                         glUniform3f
+    #define GLEXT_glUniform4f                         glUniform4f
+    #define GLEXT_glUniform1i                         glUniform1i
+    #define GLEXT_glUniform2i                         glUniform2i
+    #define GLEXT_glUniform3i                         glUniform3i
+    #define GLEXT_glUniform4i                         glUniform4i
+    #define GLEXT_glUniform1fv                        glUniform1fv
+    #define GLEXT_glUniform2fv                        glUniform2fv
+    #define GLEXT_glUniform2iv                        glUniform2iv
+    #define GLEXT_glUniform3fv                        glUniform3fv
+    #define GLEXT_glUniform4fv                        glUniform4fv
+    #define GLEXT_glUniformMatrix3fv                  glUniformMatrix3fv
+    #define GLEXT_glUniformMatrix4fv                  glUniformMatrix4fv
+    #define GLEXT_glGetObjectParameteriv              sf::priv::getObjectParameteriv
+    #define GLEXT_glGetInfoLog                        sf::priv::getInfoLog
+    #define GLEXT_glGetUniformLocation                glGetUniformLocation
+    #define GLEXT_GL_PROGRAM_OBJECT                   GL_CURRENT_PROGRAM
+    #define GLEXT_GL_OBJECT_COMPILE_STATUS            GL_COMPILE_STATUS
+    #define GLEXT_GL_OBJECT_LINK_STATUS               GL_LINK_STATUS
+    #define GLEXT_GLhandle                            GLuint
+    #define GLEXT_vertex_shader                       true
+    #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER
+    #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS
+    #define GLEXT_fragment_shader                     true
+    #define GLEXT_GL_FRAGMENT_SHADER                  GL_FRAGMENT_SHADER
+
+    // Core since 3.0
+    #define GLEXT_framebuffer_blit                    false
+
+    // Core since 3.0 - EXT_sRGB
+    #ifdef GL_EXT_sRGB
+        #define GLEXT_texture_sRGB                        GL_EXT_sRGB
+        #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
+    #else
+        #define GLEXT_texture_sRGB                        false
+        #define GLEXT_GL_SRGB8_ALPHA8                     0
+    #endif
+
+    // Core since 3.2 - not available
+    #define GLEXT_geometry_shader4                    false
+    #define GLEXT_GL_GEOMETRY_SHADER                  0
+
+    // Core since 3.0 - OES_get_program_binary
+    // (the functions are not exported by every library, they are loaded at runtime)
+    #define GLEXT_get_program_binary                  sf::priv::isProgramBinaryAvailable()
+    #define GLEXT_glGetProgramBinary                  sf::priv::getProgramBinary
+    #define GLEXT_glProgramBinary                     sf::priv::programBinary
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH_OES
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS_OES
+
+    // Core since 3.0 - checked at runtime from the version of the context
+    #define GLEXT_texture_swizzle                     sf::priv::isTextureSwizzleAvailable()
+    #define GLEXT_GL_TEXTURE_SWIZZLE_R                0x8E42
+    #define GLEXT_GL_TEXTURE_SWIZZLE_G                0x8E43
+    #define GLEXT_GL_TEXTURE_SWIZZLE_B                0x8E44
+    #define GLEXT_GL_TEXTURE_SWIZZLE_A                0x8E45
+    #define GLEXT_GL_RED                              0x1903
+    #define GLEXT_GL_GREEN                            0x1904
+    #define GLEXT_GL_BLUE                             0x1905
+
+#elif defined(SFML_OPENGL_ES)
 
     // Raspberry Pi specific hackery...
     //
@@ -70,8 +215,14 @@
     #define GLEXT_glClientActiveTexture               glClientActiveTexture
     #define GLEXT_glActiveTexture                     glActiveTexture
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE
+    #define GLEXT_GL_CLIENT_ACTIVE_TEXTURE            GL_CLIENT_ACTIVE_TEXTURE
     #define GLEXT_GL_CLAMP                            GL_CLAMP_TO_EDGE
     #define GLEXT_GL_CLAMP_TO_EDGE                    GL_CLAMP_TO_EDGE
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             GL_UNSIGNED_SHORT_5_6_5
+    #define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4           GL_UNSIGNED_SHORT_4_4_4_4
+    #define GLEXT_GL_BLEND_SRC                        GL_BLEND_SRC
+    #define GLEXT_GL_BLEND_DST                        GL_BLEND_DST
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -82,6 +233,7 @@
     // Core since 2.0 - OES_blend_subtract
     #define GLEXT_blend_subtract                      GL_OES_blend_subtract
     #define GLEXT_glBlendEquation                     glBlendEquationOES
+    #define GLEXT_GL_BLEND_EQUATION                   GL_BLEND_EQUATION_OES
     #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD_OES
     #define GLEXT_GL_FUNC_SUBTRACT                    GL_FUNC_SUBTRACT_OES
     #define GLEXT_GL_FUNC_REVERSE_SUBTRACT            GL_FUNC_REVERSE_SUBTRACT_OES
@@ -96,6 +248,10 @@
         #define GLEXT_blend_func_separate                 GL_OES_blend_func_separate
     #endif
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateOES
+    #define GLEXT_GL_BLEND_SRC_RGB                    GL_BLEND_SRC_RGB_OES
+    #define GLEXT_GL_BLEND_DST_RGB                    GL_BLEND_DST_RGB_OES
+    #define GLEXT_GL_BLEND_SRC_ALPHA                  GL_BLEND_SRC_ALPHA_OES
+    #define GLEXT_GL_BLEND_DST_ALPHA                  GL_BLEND_DST_ALPHA_OES
 
     // Core since 2.0 - OES_blend_equation_separate
     #ifdef SFML_SYSTEM_ANDROID
@@ -105,6 +261,7 @@
         #define GLEXT_blend_equation_separate             GL_OES_blend_equation_separate
     #endif
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateOES
+    #define GLEXT_GL_BLEND_EQUATION_ALPHA             GL_BLEND_EQUATION_ALPHA_OES
 
     // Core since 2.0 - OES_texture_npot
     #define GLEXT_texture_non_power_of_two            false
@@ -143,6 +300,16 @@
         #define GLEXT_GL_SRGB8_ALPHA8                     0
     #endif
 
+    // Core since 3.0
+    #define GLEXT_texture_swizzle                     false
+    #define GLEXT_GL_TEXTURE_SWIZZLE_R                0
+    #define GLEXT_GL_TEXTURE_SWIZZLE_G                0
+    #define GLEXT_GL_TEXTURE_SWIZZLE_B                0
+    #define GLEXT_GL_TEXTURE_SWIZZLE_A                0
+    #define GLEXT_GL_RED                              0
+    #define GLEXT_GL_GREEN                            0
+    #define GLEXT_GL_BLUE                             0
+
 #else
 
     #include <SFML/Graphics/GLLoader.hpp>
@@ -154,6 +321,13 @@
     // Core since 1.1
     #define GLEXT_GL_DEPTH_COMPONENT                  GL_DEPTH_COMPONENT
     #define GLEXT_GL_CLAMP                            GL_CLAMP
+    #define GLEXT_GL_BLEND_SRC                        GL_BLEND_SRC
+    #define GLEXT_GL_BLEND_DST                        GL_BLEND_DST
+
+    // Core since 1.2 - packed pixel types, supported by every 1.2 implementation
+    // (tokens only, the 1.1 headers of some platforms don't define them)
+    #define GLEXT_GL_UNSIGNED_SHORT_5_6_5             0x8363
+    #define GLEXT_GL_UNSIGNED_SHORT_4_4_4_4           0x8033
 
     // The following extensions are listed chronologically
     // Extension macro first, followed by tokens then
@@ -171,6 +345,7 @@
     // Core since 1.2 - EXT_blend_minmax
     #define GLEXT_blend_minmax                        sfogl_ext_EXT_blend_minmax
     #define GLEXT_glBlendEquation                     glBlendEquationEXT
+    #define GLEXT_GL_BLEND_EQUATION                   GL_BLEND_EQUATION_EXT
     #define GLEXT_GL_FUNC_ADD                         GL_FUNC_ADD_EXT
 
     // Core since 1.2 - EXT_blend_subtract
@@ -183,10 +358,16 @@
     #define GLEXT_glClientActiveTexture               glClientActiveTextureARB
     #define GLEXT_glActiveTexture                     glActiveTextureARB
     #define GLEXT_GL_TEXTURE0                         GL_TEXTURE0_ARB
+    #define GLEXT_GL_ACTIVE_TEXTURE                   GL_ACTIVE_TEXTURE_ARB
+    #define GLEXT_GL_CLIENT_ACTIVE_TEXTURE            GL_CLIENT_ACTIVE_TEXTURE_ARB
 
     // Core since 1.4 - EXT_blend_func_separate
     #define GLEXT_blend_func_separate                 sfogl_ext_EXT_blend_func_separate
     #define GLEXT_glBlendFuncSeparate                 glBlendFuncSeparateEXT
+    #define GLEXT_GL_BLEND_SRC_RGB                    GL_BLEND_SRC_RGB_EXT
+    #define GLEXT_GL_BLEND_DST_RGB                    GL_BLEND_DST_RGB_EXT
+    #define GLEXT_GL_BLEND_SRC_ALPHA                  GL_BLEND_SRC_ALPHA_EXT
+    #define GLEXT_GL_BLEND_DST_ALPHA                  GL_BLEND_DST_ALPHA_EXT
 
     // Core since 2.0 - ARB_shading_language_100
     #define GLEXT_shading_language_100                sfogl_ext_ARB_shading_language_100
@@ -240,6 +421,7 @@
     // Core since 2.0 - EXT_blend_equation_separate
     #define GLEXT_blend_equation_separate             sfogl_ext_EXT_blend_equation_separate
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateEXT
+    #define GLEXT_GL_BLEND_EQUATION_ALPHA             GL_BLEND_EQUATION_ALPHA_EXT
 
     // Core since 2.1 - EXT_texture_sRGB
     #define GLEXT_texture_sRGB                        sfogl_ext_EXT_texture_sRGB
@@ -278,6 +460,30 @@
     #define GLEXT_geometry_shader4                    sfogl_ext_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
 
+    // Core since 4.1 - ARB_get_program_binary
+    #define GLEXT_get_program_binary                  sfogl_ext_ARB_get_program_binary
+    #define GLEXT_glGetProgramBinary                  glGetProgramBinary
+    #define GLEXT_glProgramBinary                     glProgramBinary
+    #define GLEXT_glProgramParameteri                 glProgramParameteri
+    #define GLEXT_GL_PROGRAM_BINARY_LENGTH            GL_PROGRAM_BINARY_LENGTH
+    #define GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS       GL_NUM_PROGRAM_BINARY_FORMATS
+    #define GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT  GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+
+    // Core since 4.1 - ARB_ES2_compatibility
+    // (only the RGB565 internal format is used, the functions are not loaded)
+    #define GLEXT_ES2_compatibility                   sfogl_ext_ARB_ES2_compatibility
+    #define GLEXT_GL_RGB565                           GL_RGB565
+
+    // Core since 3.3 - ARB_texture_swizzle
+    #define GLEXT_texture_swizzle                     sfogl_ext_ARB_texture_swizzle
+    #define GLEXT_GL_TEXTURE_SWIZZLE_R                GL_TEXTURE_SWIZZLE_R
+    #define GLEXT_GL_TEXTURE_SWIZZLE_G                GL_TEXTURE_SWIZZLE_G
+    #define GLEXT_GL_TEXTURE_SWIZZLE_B                GL_TEXTURE_SWIZZLE_B
+    #define GLEXT_GL_TEXTURE_SWIZZLE_A                GL_TEXTURE_SWIZZLE_A
+    #define GLEXT_GL_RED                              GL_RED
+    #define GLEXT_GL_GREEN                            GL_GREEN
+    #define GLEXT_GL_BLUE                             GL_BLUE
+
 #endif
 
 namespace sf
@@ -288,9 +494,95 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Make sure that extensions are initialized
 ///
+/// The function pointers of all the available extensions
+/// are loaded by the first call, so a context must be
+/// active. GLEXT_ flags are plain variables which must not
+/// be tested before this function was called.
+///
 ////////////////////////////////////////////////////////////
 void ensureExtensionsInit();
 
+#if defined(SFML_OPENGL_ES2)
+
+////////////////////////////////////////////////////////////
+/// \brief Delete a shader or a program object
+///
+/// \param object Shader or program to delete
+///
+////////////////////////////////////////////////////////////
+void deleteObject(GLuint object);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the object bound to a binding point
+///
+/// \param binding Binding point, e.g. GL_CURRENT_PROGRAM
+///
+/// \return Name of the bound object
+///
+////////////////////////////////////////////////////////////
+GLuint getHandle(GLenum binding);
+
+////////////////////////////////////////////////////////////
+/// \brief Query a parameter of a shader or a program object
+///
+/// \param object Shader or program to query
+/// \param name   Parameter to query
+/// \param value  Receives the value of the parameter
+///
+////////////////////////////////////////////////////////////
+void getObjectParameteriv(GLuint object, GLenum name, GLint* value);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the info log of a shader or a program object
+///
+/// \param object    Shader or program to query
+/// \param maxLength Size of the destination buffer
+/// \param length    Receives the length of the log, can be null
+/// \param log       Destination buffer
+///
+////////////////////////////////////////////////////////////
+void getInfoLog(GLuint object, GLsizei maxLength, GLsizei* length, GLchar* log);
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether program binaries can be retrieved and loaded
+///
+/// The functions of OES_get_program_binary are loaded by
+/// ensureExtensionsInit.
+///
+/// \return True if getProgramBinary and programBinary can be used
+///
+////////////////////////////////////////////////////////////
+bool isProgramBinaryAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief Check whether textures can swizzle their components
+///
+/// Texture swizzles are core since OpenGL ES 3.0, the
+/// version of the context is checked by ensureExtensionsInit.
+///
+/// \return True if GL_TEXTURE_SWIZZLE_* can be set
+///
+////////////////////////////////////////////////////////////
+bool isTextureSwizzleAvailable();
+
+////////////////////////////////////////////////////////////
+/// \brief Retrieve the binary of a linked program
+///
+/// Same as glGetProgramBinaryOES.
+///
+////////////////////////////////////////////////////////////
+void getProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary);
+
+////////////////////////////////////////////////////////////
+/// \brief Load a program from a binary
+///
+/// Same as glProgramBinaryOES.
+///
+////////////////////////////////////////////////////////////
+void programBinary(GLuint program, GLenum format, const void* binary, GLint length);
+
+#endif
+
 } // namespace priv
 
 } // namespace sf
@@ -49,6 +49,9 @@ int sfogl_ext_EXT_texture_sRGB = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
 int sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
 int sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_ES2_compatibility = sfogl_LOAD_FAILED;
+int sfogl_ext_ARB_texture_swizzle = sfogl_LOAD_FAILED;
 
 void (GL_FUNCPTR *sf_ptrc_glBlendEquationEXT)(GLenum) = NULL;
 
@@ -842,6 +845,29 @@ static int Load_ARB_geometry_shader4()
     return numFailed;
 }
 
+void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei) = NULL;
+void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint) = NULL;
+
+static int Load_ARB_get_program_binary()
+{
+    int numFailed = 0;
+
+    sf_ptrc_glGetProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLsizei, GLsizei*, GLenum*, void*)>(glLoaderGetProcAddress("glGetProgramBinary"));
+    if (!sf_ptrc_glGetProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramBinary = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, const void*, GLsizei)>(glLoaderGetProcAddress("glProgramBinary"));
+    if (!sf_ptrc_glProgramBinary)
+        numFailed++;
+
+    sf_ptrc_glProgramParameteri = reinterpret_cast<void (GL_FUNCPTR *)(GLuint, GLenum, GLint)>(glLoaderGetProcAddress("glProgramParameteri"));
+    if (!sf_ptrc_glProgramParameteri)
+        numFailed++;
+
+    return numFailed;
+}
+
 typedef int (*PFN_LOADFUNCPOINTERS)();
 typedef struct sfogl_StrToExtMap_s
 {
@@ -850,7 +876,7 @@ typedef struct sfogl_StrToExtMap_s
     PFN_LOADFUNCPOINTERS LoadExtension;
 } sfogl_StrToExtMap;
 
-static sfogl_StrToExtMap ExtensionMap[16] = {
+static sfogl_StrToExtMap ExtensionMap[19] = {
     {"GL_SGIS_texture_edge_clamp", &sfogl_ext_SGIS_texture_edge_clamp, NULL},
     {"GL_EXT_texture_edge_clamp", &sfogl_ext_EXT_texture_edge_clamp, NULL},
     {"GL_EXT_blend_minmax", &sfogl_ext_EXT_blend_minmax, Load_EXT_blend_minmax},
@@ -866,10 +892,13 @@ static sfogl_StrToExtMap ExtensionMap[16] = {
     {"GL_EXT_texture_sRGB", &sfogl_ext_EXT_texture_sRGB, NULL},
     {"GL_EXT_framebuffer_object", &sfogl_ext_EXT_framebuffer_object, Load_EXT_framebuffer_object},
     {"GL_EXT_framebuffer_blit", &sfogl_ext_EXT_framebuffer_blit, Load_EXT_framebuffer_blit},
-    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4}
+    {"GL_ARB_geometry_shader4", &sfogl_ext_ARB_geometry_shader4, Load_ARB_geometry_shader4},
+    {"GL_ARB_get_program_binary", &sfogl_ext_ARB_get_program_binary, Load_ARB_get_program_binary},
+    {"GL_ARB_ES2_compatibility", &sfogl_ext_ARB_ES2_compatibility, NULL},
+    {"GL_ARB_texture_swizzle", &sfogl_ext_ARB_texture_swizzle, NULL}
 };
 
-static int g_extensionMapSize = 16;
+static int g_extensionMapSize = 19;
 
 
 static void ClearExtensionVars()
@@ -890,6 +919,9 @@ static void ClearExtensionVars()
     sfogl_ext_EXT_framebuffer_object = sfogl_LOAD_FAILED;
     sfogl_ext_EXT_framebuffer_blit = sfogl_LOAD_FAILED;
     sfogl_ext_ARB_geometry_shader4 = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_get_program_binary = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_ES2_compatibility = sfogl_LOAD_FAILED;
+    sfogl_ext_ARB_texture_swizzle = sfogl_LOAD_FAILED;
 }
 
 
@@ -186,6 +186,9 @@ extern int sfogl_ext_EXT_texture_sRGB;
 extern int sfogl_ext_EXT_framebuffer_object;
 extern int sfogl_ext_EXT_framebuffer_blit;
 extern int sfogl_ext_ARB_geometry_shader4;
+extern int sfogl_ext_ARB_get_program_binary;
+extern int sfogl_ext_ARB_ES2_compatibility;
+extern int sfogl_ext_ARB_texture_swizzle;
 
 #define GL_CLAMP_TO_EDGE_SGIS 0x812F
 
@@ -406,6 +409,19 @@ extern int sfogl_ext_ARB_geometry_shader4;
 #define GL_TRIANGLES_ADJACENCY_ARB 0x000C
 #define GL_TRIANGLE_STRIP_ADJACENCY_ARB 0x000D
 
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_PROGRAM_BINARY_FORMATS 0x87FF
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+
+#define GL_RGB565 0x8D62
+
+#define GL_TEXTURE_SWIZZLE_R 0x8E42
+#define GL_TEXTURE_SWIZZLE_G 0x8E43
+#define GL_TEXTURE_SWIZZLE_B 0x8E44
+#define GL_TEXTURE_SWIZZLE_A 0x8E45
+#define GL_TEXTURE_SWIZZLE_RGBA 0x8E46
+
 #define GL_2D 0x0600
 #define GL_2_BYTES 0x1407
 #define GL_3D 0x0601
@@ -1266,6 +1282,16 @@ extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteriARB)(GLuint, GLenum, GLint);
 #define glProgramParameteriARB sf_ptrc_glProgramParameteriARB
 #endif // GL_ARB_geometry_shader4
 
+#ifndef GL_ARB_get_program_binary
+#define GL_ARB_get_program_binary 1
+extern void (GL_FUNCPTR *sf_ptrc_glGetProgramBinary)(GLuint, GLsizei, GLsizei*, GLenum*, void*);
+#define glGetProgramBinary sf_ptrc_glGetProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramBinary)(GLuint, GLenum, const void*, GLsizei);
+#define glProgramBinary sf_ptrc_glProgramBinary
+extern void (GL_FUNCPTR *sf_ptrc_glProgramParameteri)(GLuint, GLenum, GLint);
+#define glProgramParameteri sf_ptrc_glProgramParameteri
+#endif // GL_ARB_get_program_binary
+
 GLAPI void APIENTRY glAccum(GLenum, GLfloat);
 GLAPI void APIENTRY glAlphaFunc(GLenum, GLfloat);
 GLAPI void APIENTRY glBegin(GLenum);
@@ -27,19 +27,297 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/ImageResampler.hpp>
+#include <SFML/Graphics/ImageStorage.hpp>
+#include <SFML/Graphics/PixelConverter.hpp>
+#include <SFML/Graphics/PixelKernels.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Sleep.hpp>
+#include <SFML/System/Thread.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
 #include <algorithm>
 #include <cstring>
+#include <deque>
+
+
+namespace
+{
+    // Clip the area copied from a source image to the bounds of both images;
+    // returns false if there is nothing left to copy
+    bool clipCopyArea(const sf::Vector2u& sourceSize, const sf::Vector2u& destSize, unsigned int destX, unsigned int destY, sf::IntRect& area)
+    {
+        // Make sure that both images are valid
+        if ((sourceSize.x == 0) || (sourceSize.y == 0) || (destSize.x == 0) || (destSize.y == 0))
+            return false;
+
+        // Adjust the source rectangle
+        if (area.width == 0 || (area.height == 0))
+        {
+            area.left   = 0;
+            area.top    = 0;
+            area.width  = sourceSize.x;
+            area.height = sourceSize.y;
+        }
+        else
+        {
+            if (area.left   < 0) area.left = 0;
+            if (area.top    < 0) area.top  = 0;
+            if (area.width  > static_cast<int>(sourceSize.x)) area.width  = sourceSize.x;
+            if (area.height > static_cast<int>(sourceSize.y)) area.height = sourceSize.y;
+        }
+
+        // Then find the valid bounds of the destination rectangle
+        if (destX + area.width  > destSize.x) area.width  = destSize.x - destX;
+        if (destY + area.height > destSize.y) area.height = destSize.y - destY;
+
+        // Make sure the destination area is valid
+        return (area.width > 0) && (area.height > 0);
+    }
+
+    // Blend rows of pixels with one of the RGBA kernels, converting
+    // the rows of other formats to RGBA8 and back on the way
+    typedef void (*BlendFunction)(sf::Uint8*, const sf::Uint8*, std::size_t);
+    void blendRows(const sf::Uint8* source, sf::PixelFormat sourceFormat, std::size_t sourceStride,
+                   sf::Uint8* destination, sf::PixelFormat destinationFormat, std::size_t destinationStride,
+                   int width, int rows, BlendFunction blend)
+    {
+        std::vector<sf::Uint8> sourceRow(sourceFormat != sf::RGBA8 ? width * 4 : 0);
+        std::vector<sf::Uint8> destinationRow(destinationFormat != sf::RGBA8 ? width * 4 : 0);
+
+        for (int i = 0; i < rows; ++i)
+        {
+            const sf::Uint8* src = source;
+            sf::Uint8* dst = destination;
+
+            if (!sourceRow.empty())
+            {
+                sf::priv::convertPixels(source, sourceFormat, &sourceRow[0], sf::RGBA8, width);
+                src = &sourceRow[0];
+            }
+
+            if (!destinationRow.empty())
+            {
+                sf::priv::convertPixels(destination, destinationFormat, &destinationRow[0], sf::RGBA8, width);
+                dst = &destinationRow[0];
+            }
+
+            blend(dst, src, width);
+
+            if (!destinationRow.empty())
+                sf::priv::convertPixels(dst, sf::RGBA8, destination, destinationFormat, width);
+
+            source += sourceStride;
+            destination += destinationStride;
+        }
+    }
+
+    // Save pixels of any format; the image writers expect RGBA pixels
+    bool saveImagePixels(const std::string& filename, const std::vector<sf::Uint8>& pixels, sf::PixelFormat format,
+                         const sf::Vector2u& size, const sf::Image::SaveOptions& options)
+    {
+        if ((format == sf::RGBA8) || pixels.empty())
+            return sf::priv::ImageLoader::getInstance().saveImageToFile(filename, pixels, size, options);
+
+        std::vector<sf::Uint8> converted(size.x * size.y * 4);
+        sf::priv::convertPixels(&pixels[0], format, &converted[0], sf::RGBA8, size.x * size.y);
+        return sf::priv::ImageLoader::getInstance().saveImageToFile(filename, converted, size, options);
+    }
+
+    // Queue of the images saved by Image::saveToFileAsync; a background thread
+    // processes the saves in order, and exits when there are none left
+    class AsyncSaveQueue
+    {
+    public:
+
+        static AsyncSaveQueue& getInstance()
+        {
+            static AsyncSaveQueue instance;
+            return instance;
+        }
+
+        ~AsyncSaveQueue()
+        {
+            wait();
+
+            // The thread has left its loop, it only needs to be collected
+            if (m_thread)
+            {
+                m_thread->wait();
+                delete m_thread;
+            }
+        }
+
+        void push(const std::string& filename, const sf::Image& image, const sf::Image::SaveOptions& options)
+        {
+            sf::Lock lock(m_mutex);
+
+            // The saved copy shares the pixels of the image; if the caller
+            // modifies the image in the meantime, it gets its own pixels
+            m_saves.push_back(Save());
+            Save& save = m_saves.back();
+            save.filename = filename;
+            save.image = image;
+            save.options = options;
+            m_pending++;
+
+            if (!m_running)
+            {
+                // The previous thread has left its loop, it only needs to be collected
+                if (m_thread)
+                {
+                    m_thread->wait();
+                    delete m_thread;
+                }
+
+                m_running = true;
+                m_thread = new sf::Thread(&AsyncSaveQueue::run, this);
+                m_thread->launch();
+            }
+        }
+
+        void wait()
+        {
+            // Several threads may wait at the same time, so the thread is not
+            // joined here: the saves are finished when none are pending
+            for (;;)
+            {
+                {
+                    sf::Lock lock(m_mutex);
+                    if (m_pending == 0)
+                        return;
+                }
+
+                sf::sleep(sf::milliseconds(1));
+            }
+        }
+
+    private:
+
+        struct Save
+        {
+            std::string            filename;
+            sf::Image              image;
+            sf::Image::SaveOptions options;
+        };
+
+        AsyncSaveQueue() :
+        m_thread (NULL),
+        m_pending(0),
+        m_running(false)
+        {
+            // The queue saves images until it is destroyed, so the loader is
+            // constructed first, to be destroyed after the queue
+            sf::priv::ImageLoader::getInstance();
+        }
+
+        void run()
+        {
+            for (;;)
+            {
+                Save save;
+                {
+                    sf::Lock lock(m_mutex);
+                    if (m_saves.empty())
+                    {
+                        m_running = false;
+                        return;
+                    }
+
+                    save.filename.swap(m_saves.front().filename);
+                    save.image = m_saves.front().image;
+                    save.options = m_saves.front().options;
+                    m_saves.pop_front();
+                }
+
+                save.image.saveToFile(save.filename, save.options);
+
+                sf::Lock lock(m_mutex);
+                m_pending--;
+            }
+        }
+
+        std::deque<Save> m_saves;
+        sf::Thread*      m_thread;
+        std::size_t      m_pending; // Saves queued or in progress
+        bool             m_running;
+        sf::Mutex        m_mutex;
+    };
+
+    // Work shared by the threads of Image::loadBatch
+    struct BatchWork
+    {
+        const std::vector<std::string>* filenames;
+        std::vector<sf::Image>*         images;
+        std::size_t                     next;     // Index of the next file to load
+        std::vector<std::size_t>        finished; // Images loaded but not reported yet
+        std::vector<char>               success;
+        sf::Mutex                       mutex;
+    };
+
+    // Load the next file of a batch; returns false if there are none left
+    bool loadNextBatchImage(BatchWork& work)
+    {
+        std::size_t index;
+        {
+            sf::Lock lock(work.mutex);
+            if (work.next >= work.filenames->size())
+                return false;
+            index = work.next++;
+        }
+
+        bool success = (*work.images)[index].loadFromFile((*work.filenames)[index]);
+
+        sf::Lock lock(work.mutex);
+        work.success[index] = success;
+        work.finished.push_back(index);
+        return true;
+    }
+
+    // Thread function loading files until the batch is done
+    void loadBatchImages(BatchWork* work)
+    {
+        while (loadNextBatchImage(*work))
+        {
+        }
+    }
+
+    // Report the images loaded since the last call; returns the number of successes
+    std::size_t reportBatchImages(BatchWork& work, sf::Image::BatchCallback callback, void* userData)
+    {
+        std::vector<std::size_t> finished;
+        {
+            sf::Lock lock(work.mutex);
+            finished.swap(work.finished);
+        }
+
+        std::size_t count = 0;
+        for (std::vector<std::size_t>::const_iterator i = finished.begin(); i != finished.end(); ++i)
+        {
+            bool success = work.success[*i] != 0;
+            if (success)
+                ++count;
+
+            // Workers never touch an image again once it's finished, so no lock is needed here
+            if (callback)
+                callback(*i, (*work.images)[*i], success, userData);
+        }
+
+        return count;
+    }
+}
 
 
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size   (0, 0),
+m_format (RGBA8),
+m_storage(NULL)
 {
     #ifdef SFML_SYSTEM_ANDROID
 
@@ -49,9 +327,30 @@ m_size(0, 0)
 }
 
 
+////////////////////////////////////////////////////////////
+Image::Image(const Image& copy) :
+m_size   (copy.m_size),
+m_format (copy.m_format),
+m_storage(copy.m_storage)
+{
+    if (m_storage)
+        m_storage->addReference();
+
+    #ifdef SFML_SYSTEM_ANDROID
+
+    // The asset stream is only needed while loading, it stays with the original
+    m_stream = NULL;
+
+    #endif
+}
+
+
 ////////////////////////////////////////////////////////////
 Image::~Image()
 {
+    if (m_storage)
+        m_storage->removeReference();
+
     #ifdef SFML_SYSTEM_ANDROID
 
         if (m_stream)
@@ -62,76 +361,107 @@ Image::~Image()
 
 
 ////////////////////////////////////////////////////////////
-void Image::create(unsigned int width, unsigned int height, const Color& color)
+void Image::create(unsigned int width, unsigned int height, const Color& color, PixelFormat format)
 {
     if (width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(width * height * 4);
+        std::size_t pixelSize = priv::getPixelSize(format);
+        std::vector<Uint8> newPixels(width * height * pixelSize);
     
         // Fill it with the specified color
-        Uint8* ptr = &newPixels[0];
-        Uint8* end = ptr + newPixels.size();
-        while (ptr < end)
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        if (format == RGBA8)
+        {
+            priv::fillPixels(&newPixels[0], width * height, components);
+        }
+        else
         {
-            *ptr++ = color.r;
-            *ptr++ = color.g;
-            *ptr++ = color.b;
-            *ptr++ = color.a;
+            // Fill the first row pixel by pixel, then copy it to the other rows
+            Uint8 pixel[4];
+            priv::convertPixels(components, RGBA8, pixel, format, 1);
+
+            std::size_t rowSize = width * pixelSize;
+            for (std::size_t i = 0; i < rowSize; i += pixelSize)
+                std::memcpy(&newPixels[i], pixel, pixelSize);
+            for (std::size_t i = rowSize; i < newPixels.size(); i += rowSize)
+                std::memcpy(&newPixels[i], &newPixels[0], rowSize);
         }
     
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
+        commitPixels(newPixels);
         
-        // Assign the new size
+        // Assign the new size and format
         m_size.x = width;
         m_size.y = height;
+        m_format = format;
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
+        std::vector<Uint8> empty;
+        commitPixels(empty);
         
         // Assign the new size
         m_size.x = 0;
         m_size.y = 0;
+        m_format = format;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
+void Image::create(unsigned int width, unsigned int height, const Uint8* pixels, PixelFormat format)
 {
     if (pixels && width && height)
     {
         // Create a new pixel buffer first for exception safety's sake
-        std::vector<Uint8> newPixels(pixels, pixels + width * height * 4);
+        std::vector<Uint8> newPixels(pixels, pixels + width * height * priv::getPixelSize(format));
         
         // Commit the new pixel buffer
-        m_pixels.swap(newPixels);
+        commitPixels(newPixels);
         
-        // Assign the new size
+        // Assign the new size and format
         m_size.x = width;
         m_size.y = height;
+        m_format = format;
     }
     else
     {
         // Dump the pixel buffer
-        std::vector<Uint8>().swap(m_pixels);
+        std::vector<Uint8> empty;
+        commitPixels(empty);
         
         // Assign the new size
         m_size.x = 0;
         m_size.y = 0;
+        m_format = format;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromFile(const std::string& filename)
+{
+    return loadFromFile(filename, Vector2u(0, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromFile(const std::string& filename, const Vector2u& targetSize)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        // Decode into new pixels, so that the image is left unchanged on failure
+        std::vector<Uint8> pixels;
+        Vector2u size;
+        if (!priv::ImageLoader::getInstance().loadImageFromFile(filename, pixels, size, targetSize))
+            return false;
+
+        commitPixels(pixels);
+        m_size = size;
+        m_format = RGBA8;
+        return true;
 
     #else
 
@@ -139,7 +469,7 @@ bool Image::loadFromFile(const std::string& filename)
             delete (priv::ResourceStream*)m_stream;
 
         m_stream = new priv::ResourceStream(filename);
-        return loadFromStream(*(priv::ResourceStream*)m_stream);
+        return loadFromStream(*(priv::ResourceStream*)m_stream, targetSize);
 
     #endif
 }
@@ -148,21 +478,129 @@ bool Image::loadFromFile(const std::string& filename)
 ////////////////////////////////////////////////////////////
 bool Image::loadFromMemory(const void* data, std::size_t size)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    return loadFromMemory(data, size, Vector2u(0, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromMemory(const void* data, std::size_t size, const Vector2u& targetSize)
+{
+    // Decode into new pixels, so that the image is left unchanged on failure
+    std::vector<Uint8> pixels;
+    Vector2u imageSize;
+    if (!priv::ImageLoader::getInstance().loadImageFromMemory(data, size, pixels, imageSize, targetSize))
+        return false;
+
+    commitPixels(pixels);
+    m_size = imageSize;
+    m_format = RGBA8;
+    return true;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::loadFromStream(InputStream& stream)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    return loadFromStream(stream, Vector2u(0, 0));
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromStream(InputStream& stream, const Vector2u& targetSize)
+{
+    // Decode into new pixels, so that the image is left unchanged on failure
+    std::vector<Uint8> pixels;
+    Vector2u size;
+    if (!priv::ImageLoader::getInstance().loadImageFromStream(stream, pixels, size, targetSize))
+        return false;
+
+    commitPixels(pixels);
+    m_size = size;
+    m_format = RGBA8;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t Image::loadBatch(const std::vector<std::string>& filenames, std::vector<Image>& images, unsigned int threadCount,
+                             BatchCallback callback, void* userData)
+{
+    images.clear();
+    images.resize(filenames.size());
+    if (filenames.empty())
+        return 0;
+
+    BatchWork work;
+    work.filenames = &filenames;
+    work.images    = &images;
+    work.next      = 0;
+    work.success.resize(filenames.size(), 0);
+
+    // Make sure that the loader exists before the threads use it
+    priv::ImageLoader::getInstance();
+
+    // A thread can't load less than one file
+    threadCount = std::max(1u, std::min(threadCount, static_cast<unsigned int>(filenames.size())));
+
+    std::vector<Thread*> threads(threadCount, NULL);
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads[i] = new Thread(&loadBatchImages, &work);
+        threads[i]->launch();
+    }
+
+    // The calling thread loads files too, and reports the finished images in between
+    std::size_t count = 0;
+    while (loadNextBatchImage(work))
+        count += reportBatchImages(work, callback, userData);
+
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+
+    count += reportBatchImages(work, callback, userData);
+
+    return count;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Image::saveToFile(const std::string& filename) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    return saveToFile(filename, SaveOptions());
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToFile(const std::string& filename, const SaveOptions& options) const
+{
+    if (!m_storage)
+        return saveImagePixels(filename, std::vector<Uint8>(), m_format, m_size, options);
+
+    return saveImagePixels(filename, m_storage->pixels, m_format, m_size, options);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::saveToFileAsync(const std::string& filename, const SaveOptions& options) const
+{
+    if (!m_storage)
+    {
+        err() << "Failed to save image \"" << filename << "\", the image is empty" << std::endl;
+        return false;
+    }
+
+    AsyncSaveQueue::getInstance().push(filename, *this, options);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::waitForAsyncSaves()
+{
+    AsyncSaveQueue::getInstance().wait();
 }
 
 
@@ -173,21 +611,43 @@ Vector2u Image::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat Image::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::convert(PixelFormat format)
+{
+    if ((format != m_format) && m_storage)
+    {
+        std::vector<Uint8> newPixels(m_size.x * m_size.y * priv::getPixelSize(format));
+        priv::convertPixels(&m_storage->pixels[0], m_format, &newPixels[0], format, m_size.x * m_size.y);
+        commitPixels(newPixels);
+    }
+
+    m_format = format;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
-    // Make sure that the image is not empty
-    if (!m_pixels.empty())
+    // Make sure that the image is not empty, and has an alpha channel
+    if (m_storage && (m_format != RGB8) && (m_format != RGB565) && (m_format != L8))
     {
+        // Other formats are masked in RGBA8
+        PixelFormat format = m_format;
+        convert(RGBA8);
+        detach();
+
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = &m_pixels[0];
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
-        {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        priv::maskPixels(&m_storage->pixels[0], m_storage->pixels.size() / 4, components, alpha);
+
+        convert(format);
     }
 }
 
@@ -195,107 +655,148 @@ void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 ////////////////////////////////////////////////////////////
 void Image::copy(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect, bool applyAlpha)
 {
-    // Make sure that both images are valid
-    if ((source.m_size.x == 0) || (source.m_size.y == 0) || (m_size.x == 0) || (m_size.y == 0))
+    // Find the area that can actually be copied
+    IntRect srcRect = sourceRect;
+    if (!clipCopyArea(source.m_size, m_size, destX, destY, srcRect))
         return;
 
-    // Adjust the source rectangle
-    IntRect srcRect = sourceRect;
-    if (srcRect.width == 0 || (srcRect.height == 0))
-    {
-        srcRect.left   = 0;
-        srcRect.top    = 0;
-        srcRect.width  = source.m_size.x;
-        srcRect.height = source.m_size.y;
-    }
-    else
-    {
-        if (srcRect.left   < 0) srcRect.left = 0;
-        if (srcRect.top    < 0) srcRect.top  = 0;
-        if (srcRect.width  > static_cast<int>(source.m_size.x)) srcRect.width  = source.m_size.x;
-        if (srcRect.height > static_cast<int>(source.m_size.y)) srcRect.height = source.m_size.y;
-    }
+    copy(ImageView(source, srcRect), destX, destY, applyAlpha);
+}
 
-    // Then find the valid bounds of the destination rectangle
-    int width  = srcRect.width;
-    int height = srcRect.height;
-    if (destX + width  > m_size.x) width  = m_size.x - destX;
-    if (destY + height > m_size.y) height = m_size.y - destY;
 
-    // Make sure the destination area is valid
-    if ((width <= 0) || (height <= 0))
+////////////////////////////////////////////////////////////
+void Image::copy(const ImageView& source, unsigned int destX, unsigned int destY, bool applyAlpha)
+{
+    // Find the area that can actually be copied
+    IntRect srcRect;
+    if (!source.getPixelsPtr() || !clipCopyArea(source.getSize(), m_size, destX, destY, srcRect))
         return;
 
+    // The source may point to the pixels of this image; if they are shared,
+    // detaching leaves them untouched with the other images, which may
+    // release them meanwhile, so they are kept alive until the copy is done
+    priv::ImageStorage* previousStorage = (m_storage && m_storage->isShared()) ? m_storage : NULL;
+    if (previousStorage)
+        previousStorage->addReference();
+    detach();
+
     // Precompute as much as possible
-    int          pitch     = width * 4;
-    int          rows      = height;
-    int          srcStride = source.m_size.x * 4;
-    int          dstStride = m_size.x * 4;
-    const Uint8* srcPixels = &source.m_pixels[0] + (srcRect.left + srcRect.top * source.m_size.x) * 4;
-    Uint8*       dstPixels = &m_pixels[0] + (destX + destY * m_size.x) * 4;
+    PixelFormat  srcFormat = source.getPixelFormat();
+    std::size_t  dstSize   = priv::getPixelSize(m_format);
+    int          width     = srcRect.width;
+    int          rows      = srcRect.height;
+    std::size_t  srcStride = source.getStride();
+    std::size_t  dstStride = m_size.x * dstSize;
+    const Uint8* srcPixels = source.getPixelsPtr();
+    Uint8*       dstPixels = &m_storage->pixels[0] + (destX + destY * m_size.x) * dstSize;
 
     // Copy the pixels
     if (applyAlpha)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
-        for (int i = 0; i < rows; ++i)
-        {
-            for (int j = 0; j < width; ++j)
-            {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha value of the source pixel
-                Uint8 alpha = src[3];
-                dst[0] = (src[0] * alpha + dst[0] * (255 - alpha)) / 255;
-                dst[1] = (src[1] * alpha + dst[1] * (255 - alpha)) / 255;
-                dst[2] = (src[2] * alpha + dst[2] * (255 - alpha)) / 255;
-                dst[3] = alpha + dst[3] * (255 - alpha) / 255;
-            }
-
-            srcPixels += srcStride;
-            dstPixels += dstStride;
-        }
+        blendRows(srcPixels, srcFormat, srcStride, dstPixels, m_format, dstStride, width, rows, priv::blendPixels);
     }
     else
     {
         // Optimized copy ignoring alpha values, row by row (faster)
         for (int i = 0; i < rows; ++i)
         {
-            std::memcpy(dstPixels, srcPixels, pitch);
+            priv::convertPixels(srcPixels, srcFormat, dstPixels, m_format, width);
             srcPixels += srcStride;
             dstPixels += dstStride;
         }
     }
+
+    if (previousStorage)
+        previousStorage->removeReference();
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::blendPremultiplied(const Image& source, unsigned int destX, unsigned int destY, const IntRect& sourceRect)
+{
+    // Find the area that can actually be blended
+    IntRect srcRect = sourceRect;
+    if (!clipCopyArea(source.m_size, m_size, destX, destY, srcRect))
+        return;
+
+    // Take the source pixels before detaching, in case the source is this image,
+    // and keep them alive until they are blended (see copy)
+    ImageView    view(source, srcRect);
+    priv::ImageStorage* previousStorage = (m_storage && m_storage->isShared()) ? m_storage : NULL;
+    if (previousStorage)
+        previousStorage->addReference();
+    detach();
+
+    std::size_t  dstSize   = priv::getPixelSize(m_format);
+    Uint8*       dstPixels = &m_storage->pixels[0] + (destX + destY * m_size.x) * dstSize;
+
+    blendRows(view.getPixelsPtr(), source.m_format, view.getStride(), dstPixels, m_format, m_size.x * dstSize,
+              view.getSize().x, view.getSize().y, priv::blendPremultipliedPixels);
+
+    if (previousStorage)
+        previousStorage->removeReference();
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::premultiplyAlpha()
+{
+    // Colors of pixels without alpha are unchanged
+    if (m_storage && (m_format != RGB8) && (m_format != RGB565) && (m_format != L8))
+    {
+        PixelFormat format = m_format;
+        convert(RGBA8);
+        detach();
+
+        priv::premultiplyPixels(&m_storage->pixels[0], m_storage->pixels.size() / 4);
+
+        convert(format);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
-    Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    *pixel++ = color.r;
-    *pixel++ = color.g;
-    *pixel++ = color.b;
-    *pixel++ = color.a;
+    detach();
+
+    Uint8* pixel = &m_storage->pixels[(x + y * m_size.x) * priv::getPixelSize(m_format)];
+
+    if (m_format == RGBA8)
+    {
+        *pixel++ = color.r;
+        *pixel++ = color.g;
+        *pixel++ = color.b;
+        *pixel++ = color.a;
+    }
+    else
+    {
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        priv::convertPixels(components, RGBA8, pixel, m_format, 1);
+    }
 }
 
 
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
-    const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
-    return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+    const Uint8* pixel = &m_storage->pixels[(x + y * m_size.x) * priv::getPixelSize(m_format)];
+
+    if (m_format == RGBA8)
+        return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
+
+    Uint8 components[4];
+    priv::convertPixels(pixel, m_format, components, RGBA8, 1);
+    return Color(components[0], components[1], components[2], components[3]);
 }
 
 
 ////////////////////////////////////////////////////////////
 const Uint8* Image::getPixelsPtr() const
 {
-    if (!m_pixels.empty())
+    if (m_storage)
     {
-        return &m_pixels[0];
+        return &m_storage->pixels[0];
     }
     else
     {
@@ -308,21 +809,28 @@ const Uint8* Image::getPixelsPtr() const
 ////////////////////////////////////////////////////////////
 void Image::flipHorizontally()
 {
-    if (!m_pixels.empty())
+    if (m_storage)
     {
-        std::size_t rowSize = m_size.x * 4;
+        detach();
+
+        std::size_t pixelSize = priv::getPixelSize(m_format);
+        std::size_t rowSize = m_size.x * pixelSize;
 
         for (std::size_t y = 0; y < m_size.y; ++y)
         {
-            std::vector<Uint8>::iterator left = m_pixels.begin() + y * rowSize;
-            std::vector<Uint8>::iterator right = m_pixels.begin() + (y + 1) * rowSize - 4;
+            Uint8* row = &m_storage->pixels[y * rowSize];
 
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
+            if (pixelSize == 4)
             {
-                std::swap_ranges(left, left + 4, right);
+                priv::reversePixels(row, m_size.x);
+            }
+            else
+            {
+                Uint8* left = row;
+                Uint8* right = row + rowSize - pixelSize;
 
-                left += 4;
-                right -= 4;
+                for (; left < right; left += pixelSize, right -= pixelSize)
+                    std::swap_ranges(left, left + pixelSize, right);
             }
         }
     }
@@ -332,12 +840,14 @@ void Image::flipHorizontally()
 ////////////////////////////////////////////////////////////
 void Image::flipVertically()
 {
-    if (!m_pixels.empty())
+    if (m_storage)
     {
-        std::size_t rowSize = m_size.x * 4;
+        detach();
+
+        std::size_t rowSize = m_size.x * priv::getPixelSize(m_format);
 
-        std::vector<Uint8>::iterator top = m_pixels.begin();
-        std::vector<Uint8>::iterator bottom = m_pixels.end() - rowSize;
+        std::vector<Uint8>::iterator top = m_storage->pixels.begin();
+        std::vector<Uint8>::iterator bottom = m_storage->pixels.end() - rowSize;
 
         for (std::size_t y = 0; y < m_size.y / 2; ++y)
         {
@@ -349,4 +859,89 @@ void Image::flipVertically()
     }
 }
 
+
+////////////////////////////////////////////////////////////
+void Image::resize(unsigned int width, unsigned int height, ResizeFilter filter, unsigned int threadCount)
+{
+    *this = scaled(width, height, filter, threadCount);
+}
+
+
+////////////////////////////////////////////////////////////
+Image Image::scaled(unsigned int width, unsigned int height, ResizeFilter filter, unsigned int threadCount) const
+{
+    Image result;
+
+    if (width && height && m_storage)
+    {
+        std::vector<Uint8> pixels(width * height * 4);
+
+        if (m_format == RGBA8)
+        {
+            priv::resampleImage(&m_storage->pixels[0], m_size.x, m_size.y, &pixels[0], width, height, filter, threadCount);
+        }
+        else
+        {
+            // The resampler works on RGBA8 pixels
+            std::vector<Uint8> source(m_size.x * m_size.y * 4);
+            priv::convertPixels(&m_storage->pixels[0], m_format, &source[0], RGBA8, m_size.x * m_size.y);
+            priv::resampleImage(&source[0], m_size.x, m_size.y, &pixels[0], width, height, filter, threadCount);
+        }
+
+        result.commitPixels(pixels);
+        result.m_size = Vector2u(width, height);
+        result.convert(m_format);
+    }
+
+    result.m_format = m_format;
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+Image& Image::operator =(const Image& right)
+{
+    Image temp(right);
+
+    std::swap(m_size,    temp.m_size);
+    std::swap(m_format,  temp.m_format);
+    std::swap(m_storage, temp.m_storage);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::detach()
+{
+    if (m_storage && m_storage->isShared())
+    {
+        priv::ImageStorage* storage = new priv::ImageStorage;
+        storage->pixels = m_storage->pixels;
+
+        m_storage->removeReference();
+        m_storage = storage;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::commitPixels(std::vector<Uint8>& pixels)
+{
+    // Keep the storage only if this image is its sole user, to reuse it
+    if (m_storage && (pixels.empty() || m_storage->isShared()))
+    {
+        m_storage->removeReference();
+        m_storage = NULL;
+    }
+
+    if (!pixels.empty())
+    {
+        if (!m_storage)
+            m_storage = new priv::ImageStorage;
+
+        m_storage->pixels.swap(pixels);
+    }
+}
+
 } // namespace sf
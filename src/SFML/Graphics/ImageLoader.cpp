@@ -26,8 +26,85 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/PixelConverter.hpp>
+#include <SFML/System/FileInputStream.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
 #include <SFML/System/Err.hpp>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+    // State of the stb_image decode running on a thread
+    struct StbContext
+    {
+        sf::Uint8*  pixels;        // Pixel array that receives the final image, if known
+        std::size_t size;          // Size of the pixel array, in bytes
+        bool        used;          // Is the pixel array currently allocated to stb_image?
+        const char* failureReason; // Reason of the last failure of stb_image
+    };
+    sf::ThreadLocalPtr<StbContext> stbContext;
+    const char* stbSharedFailureReason = "";
+
+    // Images can be loaded by several threads at once, their errors must not interleave
+    sf::Mutex errorMutex;
+
+    // stb_image allocation functions; the final image is allocated with the exact
+    // size of the RGBA pixels, so the pixel array is handed out for allocations of
+    // that size and the decoded pixels don't have to be copied
+    void* stbMalloc(std::size_t size)
+    {
+        StbContext* context = stbContext;
+        if (context && context->pixels && !context->used && (size == context->size))
+        {
+            context->used = true;
+            return context->pixels;
+        }
+
+        return std::malloc(size);
+    }
+    void stbFree(void* ptr)
+    {
+        StbContext* context = stbContext;
+        if (context && ptr && (ptr == context->pixels))
+            context->used = false;
+        else
+            std::free(ptr);
+    }
+    void* stbRealloc(void* ptr, std::size_t size)
+    {
+        StbContext* context = stbContext;
+        if (!context || !ptr || (ptr != context->pixels))
+            return std::realloc(ptr, size);
+
+        // The pixel array can't be resized, move its content to a regular allocation
+        void* copy = std::malloc(size);
+        if (copy)
+        {
+            std::memcpy(copy, ptr, size < context->size ? size : context->size);
+            context->used = false;
+        }
+        return copy;
+    }
+}
+
+// stb_image stores the reason of its failures in a global variable; it's redirected
+// to the context of the calling thread, so that concurrent loads report their own errors
+static const char** stbFailureReason()
+{
+    StbContext* context = stbContext;
+    return context ? &context->failureReason : &stbSharedFailureReason;
+}
+
+#define stbi__g_failure_reason  *stbFailureReason()
+#define STBI_MALLOC(size)       stbMalloc(size)
+#define STBI_REALLOC(ptr, size) stbRealloc(ptr, size)
+#define STBI_FREE(ptr)          stbFree(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -37,7 +114,10 @@ extern "C"
     #include <jpeglib.h>
     #include <jerror.h>
 }
+#include <algorithm>
 #include <cctype>
+#include <csetjmp>
+#include <cstdio>
 
 
 namespace
@@ -66,6 +146,558 @@ namespace
         sf::InputStream* stream = static_cast<sf::InputStream*>(user);
         return stream->tell() >= stream->getSize();
     }
+
+    // Check whether a stream starts with the JPEG signature, and rewind it
+    bool isJpeg(sf::InputStream& stream)
+    {
+        unsigned char signature[3] = {0, 0, 0};
+        bool jpeg = (stream.read(signature, 3) == 3) && (signature[0] == 0xFF) && (signature[1] == 0xD8) && (signature[2] == 0xFF);
+        stream.seek(0);
+        return jpeg;
+    }
+
+    // libjpeg error manager that returns to the decoder instead of exiting
+    struct JpegErrorManager
+    {
+        jpeg_error_mgr base;
+        std::jmp_buf   jump;
+        char           message[JMSG_LENGTH_MAX];
+    };
+    void jpegErrorExit(j_common_ptr info)
+    {
+        JpegErrorManager* manager = reinterpret_cast<JpegErrorManager*>(info->err);
+        (*info->err->format_message)(info, manager->message);
+        std::longjmp(manager->jump, 1);
+    }
+    void jpegOutputMessage(j_common_ptr)
+    {
+        // Warnings about corrupt data are ignored, like stb_image does
+    }
+
+    // libjpeg source manager that reads from a sf::InputStream
+    struct JpegStreamSource
+    {
+        jpeg_source_mgr  base;
+        sf::InputStream* stream;
+        JOCTET           buffer[4096];
+    };
+    void jpegInitSource(j_decompress_ptr)
+    {
+    }
+    boolean jpegFillInputBuffer(j_decompress_ptr info)
+    {
+        JpegStreamSource* source = reinterpret_cast<JpegStreamSource*>(info->src);
+        sf::Int64 count = source->stream->read(source->buffer, sizeof(source->buffer));
+
+        // Insert a fake end of image marker on premature end of data, as the libjpeg sources do
+        if (count <= 0)
+        {
+            source->buffer[0] = 0xFF;
+            source->buffer[1] = JPEG_EOI;
+            count = 2;
+        }
+
+        source->base.next_input_byte = source->buffer;
+        source->base.bytes_in_buffer = static_cast<std::size_t>(count);
+        return TRUE;
+    }
+    void jpegSkipInputData(j_decompress_ptr info, long count)
+    {
+        JpegStreamSource* source = reinterpret_cast<JpegStreamSource*>(info->src);
+        if (count <= 0)
+            return;
+
+        if (static_cast<std::size_t>(count) <= source->base.bytes_in_buffer)
+        {
+            source->base.next_input_byte += count;
+            source->base.bytes_in_buffer -= count;
+        }
+        else
+        {
+            source->stream->seek(source->stream->tell() + count - static_cast<sf::Int64>(source->base.bytes_in_buffer));
+            source->base.bytes_in_buffer = 0;
+        }
+    }
+    void jpegTermSource(j_decompress_ptr)
+    {
+    }
+
+    // Find the largest DCT scaling (1/2, 1/4 or 1/8) that keeps the image at least as large as the target
+    unsigned int getJpegScale(unsigned int width, unsigned int height, const sf::Vector2u& targetSize)
+    {
+        if ((targetSize.x == 0) && (targetSize.y == 0))
+            return 1;
+
+        unsigned int denominator = 1;
+        while (denominator < 8)
+        {
+            // libjpeg rounds the scaled size up
+            unsigned int next = denominator * 2;
+            if ((targetSize.x && ((width + next - 1) / next < targetSize.x)) ||
+                (targetSize.y && ((height + next - 1) / next < targetSize.y)))
+                break;
+
+            denominator = next;
+        }
+
+        return denominator;
+    }
+
+    // Decode a JPEG image to RGBA pixels with libjpeg, downscaled in the DCT domain if requested
+    bool decodeJpeg(sf::InputStream& stream, std::vector<sf::Uint8>& pixels, sf::Vector2u& size, const sf::Vector2u& targetSize, std::string& error)
+    {
+        jpeg_decompress_struct info;
+        JpegErrorManager errorManager;
+        info.err = jpeg_std_error(&errorManager.base);
+        errorManager.base.error_exit = &jpegErrorExit;
+        errorManager.base.output_message = &jpegOutputMessage;
+
+        // libjpeg jumps back here on error; nothing with a destructor must be created below
+        if (setjmp(errorManager.jump))
+        {
+            jpeg_destroy_decompress(&info);
+            pixels.clear();
+            error = errorManager.message;
+            return false;
+        }
+
+        jpeg_create_decompress(&info);
+
+        JpegStreamSource* source = static_cast<JpegStreamSource*>((*info.mem->alloc_small)(reinterpret_cast<j_common_ptr>(&info), JPOOL_PERMANENT, sizeof(JpegStreamSource)));
+        source->base.init_source       = &jpegInitSource;
+        source->base.fill_input_buffer = &jpegFillInputBuffer;
+        source->base.skip_input_data   = &jpegSkipInputData;
+        source->base.resync_to_restart = &jpeg_resync_to_restart;
+        source->base.term_source       = &jpegTermSource;
+        source->base.next_input_byte   = NULL;
+        source->base.bytes_in_buffer   = 0;
+        source->stream                 = &stream;
+        info.src = &source->base;
+
+        jpeg_read_header(&info, TRUE);
+
+        info.scale_num = 1;
+        info.scale_denom = getJpegScale(info.image_width, info.image_height, targetSize);
+
+        // CMYK images are converted by hand, everything else is decoded straight to
+        // RGBA by libjpeg-turbo, or to RGB / greyscale by other versions of libjpeg
+        bool cmyk = (info.jpeg_color_space == JCS_CMYK) || (info.jpeg_color_space == JCS_YCCK);
+        sf::PixelFormat format = sf::RGBA8;
+        if (cmyk)
+        {
+            info.out_color_space = JCS_CMYK;
+        }
+        else
+        {
+#ifdef JCS_ALPHA_EXTENSIONS
+            info.out_color_space = JCS_EXT_RGBA;
+#else
+            info.out_color_space = (info.jpeg_color_space == JCS_GRAYSCALE) ? JCS_GRAYSCALE : JCS_RGB;
+            format = (info.jpeg_color_space == JCS_GRAYSCALE) ? sf::L8 : sf::RGB8;
+#endif
+        }
+
+        jpeg_start_decompress(&info);
+
+        size.x = info.output_width;
+        size.y = info.output_height;
+        pixels.resize(info.output_width * info.output_height * 4);
+        std::size_t pitch = info.output_width * 4;
+
+        if (!cmyk && (format == sf::RGBA8))
+        {
+            // Decode directly into the pixel buffer
+            JSAMPARRAY rows = static_cast<JSAMPARRAY>((*info.mem->alloc_small)(reinterpret_cast<j_common_ptr>(&info), JPOOL_IMAGE, info.output_height * sizeof(JSAMPROW)));
+            for (JDIMENSION i = 0; i < info.output_height; ++i)
+                rows[i] = &pixels[i * pitch];
+
+            while (info.output_scanline < info.output_height)
+                jpeg_read_scanlines(&info, rows + info.output_scanline, info.output_height - info.output_scanline);
+        }
+        else
+        {
+            // Decode row by row into a scratch row, then expand it to RGBA
+            JSAMPARRAY row = (*info.mem->alloc_sarray)(reinterpret_cast<j_common_ptr>(&info), JPOOL_IMAGE, info.output_width * info.output_components, 1);
+            while (info.output_scanline < info.output_height)
+            {
+                sf::Uint8* destination = &pixels[info.output_scanline * pitch];
+                jpeg_read_scanlines(&info, row, 1);
+
+                if (cmyk)
+                {
+                    // Adobe writes inverted CMYK, so each component times K gives the color
+                    const JSAMPLE* components = row[0];
+                    for (JDIMENSION x = 0; x < info.output_width; ++x, components += 4, destination += 4)
+                    {
+                        destination[0] = static_cast<sf::Uint8>((components[0] * components[3] + 127) / 255);
+                        destination[1] = static_cast<sf::Uint8>((components[1] * components[3] + 127) / 255);
+                        destination[2] = static_cast<sf::Uint8>((components[2] * components[3] + 127) / 255);
+                        destination[3] = 255;
+                    }
+                }
+                else
+                {
+                    sf::priv::convertPixels(row[0], format, destination, sf::RGBA8, info.output_width);
+                }
+            }
+        }
+
+        jpeg_finish_decompress(&info);
+        jpeg_destroy_decompress(&info);
+
+        return true;
+    }
+
+    // Check whether a stream starts with the QOI signature, and rewind it
+    bool isQoi(sf::InputStream& stream)
+    {
+        char signature[4] = {0, 0, 0, 0};
+        bool qoi = (stream.read(signature, 4) == 4) && (std::memcmp(signature, "qoif", 4) == 0);
+        stream.seek(0);
+        return qoi;
+    }
+
+    // Hash of a color in the QOI index
+    inline unsigned int getQoiHash(const sf::Uint8* color)
+    {
+        return (color[0] * 3 + color[1] * 5 + color[2] * 7 + color[3] * 11) & 63;
+    }
+
+    // Number of bytes of a QOI operation, including its tag
+    inline std::size_t getQoiOpSize(sf::Uint8 op)
+    {
+        if (op == 0xFE)
+            return 4; // QOI_OP_RGB
+        else if (op == 0xFF)
+            return 5; // QOI_OP_RGBA
+        else if ((op >> 6) == 2)
+            return 2; // QOI_OP_LUMA
+        else
+            return 1;
+    }
+
+    // Read a big endian 32 bits integer
+    inline sf::Uint32 readUint32(const sf::Uint8* data)
+    {
+        return (static_cast<sf::Uint32>(data[0]) << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
+    }
+
+    // Decode a QOI image to RGBA pixels
+    bool decodeQoi(sf::InputStream& stream, std::vector<sf::Uint8>& pixels, sf::Vector2u& size, std::string& error)
+    {
+        // Read and check the header
+        sf::Uint8 header[14];
+        if (stream.read(header, sizeof(header)) != sizeof(header))
+        {
+            error = "Truncated QOI header";
+            return false;
+        }
+
+        sf::Uint32 width = readUint32(header + 4);
+        sf::Uint32 height = readUint32(header + 8);
+        if ((width == 0) || (height == 0) || (header[12] < 3) || (header[12] > 4) || (header[13] > 1) ||
+            (height > 400000000 / width))
+        {
+            error = "Corrupt QOI header";
+            return false;
+        }
+
+        pixels.resize(static_cast<std::size_t>(width) * height * 4);
+        sf::Uint8* output = &pixels[0];
+        sf::Uint8* end = output + pixels.size();
+
+        // The stream is read by blocks; an operation is at most 5 bytes long, so
+        // there's always enough data for one as long as 5 bytes are left in the block
+        std::vector<sf::Uint8> buffer(65536);
+        std::size_t position = 0;
+        std::size_t available = 0;
+        bool endOfStream = false;
+
+        sf::Uint8 index[64 * 4] = {0};
+        sf::Uint8 color[4] = {0, 0, 0, 255};
+
+        while (output < end)
+        {
+            if ((position + 5 > available) && !endOfStream)
+            {
+                // Move the rest of the block to the beginning of the buffer and read the next block
+                std::size_t rest = available - position;
+                std::memmove(&buffer[0], &buffer[position], rest);
+                sf::Int64 count = stream.read(&buffer[rest], 65536 - rest);
+                available = rest + static_cast<std::size_t>(count > 0 ? count : 0);
+                endOfStream = count <= 0;
+                position = 0;
+            }
+
+            // At the end of the stream, the last operation may have been cut
+            if ((position >= available) || (position + getQoiOpSize(buffer[position]) > available))
+            {
+                pixels.clear();
+                error = "Truncated QOI data";
+                return false;
+            }
+
+            const sf::Uint8* data = &buffer[position];
+            sf::Uint8 op = data[0];
+            if (op == 0xFE)
+            {
+                // QOI_OP_RGB
+                color[0] = data[1];
+                color[1] = data[2];
+                color[2] = data[3];
+                position += 4;
+            }
+            else if (op == 0xFF)
+            {
+                // QOI_OP_RGBA
+                std::memcpy(color, data + 1, 4);
+                position += 5;
+            }
+            else
+            {
+                switch (op >> 6)
+                {
+                    case 0:
+                        // QOI_OP_INDEX
+                        std::memcpy(color, index + op * 4, 4);
+                        break;
+
+                    case 1:
+                        // QOI_OP_DIFF
+                        color[0] = static_cast<sf::Uint8>(color[0] + ((op >> 4) & 3) - 2);
+                        color[1] = static_cast<sf::Uint8>(color[1] + ((op >> 2) & 3) - 2);
+                        color[2] = static_cast<sf::Uint8>(color[2] + (op & 3) - 2);
+                        break;
+
+                    case 2:
+                    {
+                        // QOI_OP_LUMA
+                        int green = (op & 63) - 32;
+                        color[0] = static_cast<sf::Uint8>(color[0] + green - 8 + (data[1] >> 4));
+                        color[1] = static_cast<sf::Uint8>(color[1] + green);
+                        color[2] = static_cast<sf::Uint8>(color[2] + green - 8 + (data[1] & 15));
+                        position += 1;
+                        break;
+                    }
+
+                    case 3:
+                    {
+                        // QOI_OP_RUN, the current pixel is written once more below
+                        std::size_t run = op & 63;
+                        for (; (run > 0) && (output + 4 < end); --run, output += 4)
+                            std::memcpy(output, color, 4);
+                        break;
+                    }
+                }
+                position += 1;
+            }
+
+            std::memcpy(index + getQoiHash(color) * 4, color, 4);
+            std::memcpy(output, color, 4);
+            output += 4;
+        }
+
+        size.x = width;
+        size.y = height;
+        return true;
+    }
+
+    // Start a stb_image decode on the calling thread
+    void beginStbDecode(StbContext& context)
+    {
+        context.pixels = NULL;
+        context.size = 0;
+        context.used = false;
+        context.failureReason = "";
+
+        stbContext = &context;
+    }
+
+    // Let stb_image decode into the pixel array, given the size read from the image header
+    void setStbTarget(StbContext& context, std::vector<sf::Uint8>& pixels, int width, int height)
+    {
+        if ((width > 0) && (height > 0))
+        {
+            pixels.resize(static_cast<std::size_t>(width) * height * 4);
+            context.pixels = &pixels[0];
+            context.size = pixels.size();
+        }
+    }
+
+    // Finish a stb_image decode; the pixels are copied only if they were not decoded in place
+    bool endStbDecode(unsigned char* ptr, int width, int height, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        stbContext = NULL;
+
+        if (!ptr)
+        {
+            pixels.clear();
+            return false;
+        }
+
+        // Assign the image properties
+        size.x = width;
+        size.y = height;
+
+        std::size_t count = static_cast<std::size_t>(width) * height * 4;
+        if (pixels.empty() || (ptr != &pixels[0]))
+        {
+            // The decoder didn't use the pixel array: copy the loaded pixels and free them
+            pixels.resize(count);
+            if (count)
+                std::memcpy(&pixels[0], ptr, count);
+            stbi_image_free(ptr);
+        }
+
+        return true;
+    }
+
+    // Paeth predictor of the PNG filters
+    int paeth(int a, int b, int c)
+    {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+
+        if ((pa <= pb) && (pa <= pc))
+            return a;
+        else if (pb <= pc)
+            return b;
+        else
+            return c;
+    }
+
+    // Apply a PNG filter to a row of RGBA pixels; the previous row of the first row is all zeros
+    void filterPngRow(int type, const sf::Uint8* row, const sf::Uint8* previous, std::size_t size, sf::Uint8* output)
+    {
+        const std::size_t bpp = 4;
+        std::size_t i = 0;
+
+        switch (type)
+        {
+            case sf::Image::PngFilterNone:
+                std::memcpy(output, row, size);
+                break;
+
+            case sf::Image::PngFilterSub:
+                for (; i < bpp; ++i)
+                    output[i] = row[i];
+                for (; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - row[i - bpp]);
+                break;
+
+            case sf::Image::PngFilterUp:
+                for (; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - previous[i]);
+                break;
+
+            case sf::Image::PngFilterAverage:
+                for (; i < bpp; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - (previous[i] >> 1));
+                for (; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - ((row[i - bpp] + previous[i]) >> 1));
+                break;
+
+            case sf::Image::PngFilterPaeth:
+                for (; i < bpp; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - previous[i]);
+                for (; i < size; ++i)
+                    output[i] = static_cast<sf::Uint8>(row[i] - paeth(row[i - bpp], previous[i], previous[i - bpp]));
+                break;
+        }
+    }
+
+    // CRC-32 of the PNG chunks, computed 4 bits at a time
+    sf::Uint32 updateCrc(sf::Uint32 crc, const sf::Uint8* data, std::size_t size)
+    {
+        static const sf::Uint32 table[16] =
+        {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+            0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+        };
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc ^= data[i];
+            crc = (crc >> 4) ^ table[crc & 15];
+            crc = (crc >> 4) ^ table[crc & 15];
+        }
+
+        return crc;
+    }
+
+    // Adler-32 checksum of zlib streams
+    sf::Uint32 adler32(const sf::Uint8* data, std::size_t size)
+    {
+        sf::Uint32 a = 1;
+        sf::Uint32 b = 0;
+        while (size > 0)
+        {
+            // 5552 is the largest count that can't overflow the sums before the modulo
+            std::size_t count = size < 5552 ? size : 5552;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += count;
+            size -= count;
+        }
+
+        return (b << 16) | a;
+    }
+
+    // Append a big endian 32 bits integer to a byte array
+    void appendUint32(std::vector<sf::Uint8>& data, sf::Uint32 value)
+    {
+        data.push_back(static_cast<sf::Uint8>(value >> 24));
+        data.push_back(static_cast<sf::Uint8>(value >> 16));
+        data.push_back(static_cast<sf::Uint8>(value >> 8));
+        data.push_back(static_cast<sf::Uint8>(value));
+    }
+
+    // Build a zlib stream of stored (uncompressed) deflate blocks
+    void storeZlib(const sf::Uint8* data, std::size_t size, std::vector<sf::Uint8>& output)
+    {
+        output.reserve(size + size / 65535 * 5 + 11);
+        output.push_back(0x78);
+        output.push_back(0x01);
+
+        std::size_t offset = 0;
+        do
+        {
+            std::size_t length = size - offset < 65535 ? size - offset : 65535;
+            output.push_back((offset + length == size) ? 1 : 0);
+            output.push_back(static_cast<sf::Uint8>(length));
+            output.push_back(static_cast<sf::Uint8>(length >> 8));
+            output.push_back(static_cast<sf::Uint8>(~length));
+            output.push_back(static_cast<sf::Uint8>(~length >> 8));
+            output.insert(output.end(), data + offset, data + offset + length);
+            offset += length;
+        }
+        while (offset < size);
+
+        appendUint32(output, adler32(data, size));
+    }
+
+    // Write a PNG chunk to a file
+    bool writePngChunk(std::FILE* file, const char* type, const sf::Uint8* data, std::size_t size)
+    {
+        std::vector<sf::Uint8> header;
+        appendUint32(header, static_cast<sf::Uint32>(size));
+        header.insert(header.end(), type, type + 4);
+
+        std::vector<sf::Uint8> footer;
+        sf::Uint32 crc = updateCrc(0xFFFFFFFF, &header[4], 4);
+        appendUint32(footer, ~updateCrc(crc, data, size));
+
+        return (std::fwrite(&header[0], 1, header.size(), file) == header.size()) &&
+               ((size == 0) || (std::fwrite(data, 1, size, file) == size)) &&
+               (std::fwrite(&footer[0], 1, footer.size(), file) == footer.size());
+    }
 }
 
 
@@ -85,7 +717,9 @@ ImageLoader& ImageLoader::getInstance()
 ////////////////////////////////////////////////////////////
 ImageLoader::ImageLoader()
 {
-    // Nothing to do
+    // stb_image builds its zlib tables on first use, which isn't safe when several
+    // threads load images at once; build them here, before any thread can load
+    stbi__init_zdefaults();
 }
 
 
@@ -97,39 +731,43 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, const Vector2u& targetSize)
 {
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
+    // JPEG images are decoded by libjpeg, QOI images by our own decoder
+    FileInputStream file;
+    if (file.open(filename) && (isJpeg(file) || isQoi(file)))
+    {
+        std::string error;
+        if (isJpeg(file) ? decodeJpeg(file, pixels, size, targetSize, error) : decodeQoi(file, pixels, size, error))
+            return true;
+
+        Lock lock(errorMutex);
+        err() << "Failed to load image \"" << filename << "\". Reason: " << error << std::endl;
+        return false;
+    }
+
+    // Load the image directly into the pixel array
     int width = 0;
     int height = 0;
     int channels = 0;
+    StbContext context;
+    beginStbDecode(context);
+    if (stbi_info(filename.c_str(), &width, &height, &channels))
+        setStbTarget(context, pixels, width, height);
     unsigned char* ptr = stbi_load(filename.c_str(), &width, &height, &channels, STBI_rgb_alpha);
 
-    if (ptr)
+    if (endStbDecode(ptr, width, height, pixels, size))
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
-
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image \"" << filename << "\". Reason: " << stbi_failure_reason() << std::endl;
+        Lock lock(errorMutex);
+        err() << "Failed to load image \"" << filename << "\". Reason: " << context.failureReason << std::endl;
 
         return false;
     }
@@ -137,7 +775,7 @@ bool ImageLoader::loadImageFromFile(const std::string& filename, std::vector<Uin
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, const Vector2u& targetSize)
 {
     // Check input parameters
     if (data && dataSize)
@@ -145,41 +783,47 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
         // Clear the array (just in case)
         pixels.clear();
 
-        // Load the image and get a pointer to the pixels in memory
+        // JPEG images are decoded by libjpeg, QOI images by our own decoder
+        MemoryInputStream memory;
+        memory.open(data, dataSize);
+        if (isJpeg(memory) || isQoi(memory))
+        {
+            std::string error;
+            if (isJpeg(memory) ? decodeJpeg(memory, pixels, size, targetSize, error) : decodeQoi(memory, pixels, size, error))
+                return true;
+
+            Lock lock(errorMutex);
+            err() << "Failed to load image from memory. Reason: " << error << std::endl;
+            return false;
+        }
+
+        // Load the image directly into the pixel array
         int width = 0;
         int height = 0;
         int channels = 0;
         const unsigned char* buffer = static_cast<const unsigned char*>(data);
+        StbContext context;
+        beginStbDecode(context);
+        if (stbi_info_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels))
+            setStbTarget(context, pixels, width, height);
         unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
 
-        if (ptr)
+        if (endStbDecode(ptr, width, height, pixels, size))
         {
-            // Assign the image properties
-            size.x = width;
-            size.y = height;
-
-            if (width && height)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(width * height * 4);
-                memcpy(&pixels[0], ptr, pixels.size());
-            }
-
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
-
             return true;
         }
         else
         {
             // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
+            Lock lock(errorMutex);
+            err() << "Failed to load image from memory. Reason: " << context.failureReason << std::endl;
 
             return false;
         }
     }
     else
     {
+        Lock lock(errorMutex);
         err() << "Failed to load image from memory, no data provided" << std::endl;
         return false;
     }
@@ -187,7 +831,7 @@ bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, st
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, const Vector2u& targetSize)
 {
     // Clear the array (just in case)
     pixels.clear();
@@ -195,40 +839,45 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     // Make sure that the stream's reading position is at the beginning
     stream.seek(0);
 
+    // JPEG images are decoded by libjpeg, QOI images by our own decoder
+    if (isJpeg(stream) || isQoi(stream))
+    {
+        std::string error;
+        if (isJpeg(stream) ? decodeJpeg(stream, pixels, size, targetSize, error) : decodeQoi(stream, pixels, size, error))
+            return true;
+
+        Lock lock(errorMutex);
+        err() << "Failed to load image from stream. Reason: " << error << std::endl;
+        return false;
+    }
+
     // Setup the stb_image callbacks
     stbi_io_callbacks callbacks;
     callbacks.read = &read;
     callbacks.skip = &skip;
     callbacks.eof  = &eof;
 
-    // Load the image and get a pointer to the pixels in memory
+    // Load the image directly into the pixel array; the header is read first to
+    // know the size of the image, so the stream is rewound afterwards
     int width = 0;
     int height = 0;
     int channels = 0;
+    StbContext context;
+    beginStbDecode(context);
+    if (stbi_info_from_callbacks(&callbacks, &stream, &width, &height, &channels))
+        setStbTarget(context, pixels, width, height);
+    stream.seek(0);
     unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
 
-    if (ptr)
+    if (endStbDecode(ptr, width, height, pixels, size))
     {
-        // Assign the image properties
-        size.x = width;
-        size.y = height;
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(width * height * 4);
-            memcpy(&pixels[0], ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
-
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        Lock lock(errorMutex);
+        err() << "Failed to load image from stream. Reason: " << context.failureReason << std::endl;
 
         return false;
     }
@@ -236,7 +885,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveOptions& options)
 {
     // Make sure the image is not empty
     if (!pixels.empty() && (size.x > 0) && (size.y > 0))
@@ -262,24 +911,31 @@ bool ImageLoader::saveImageToFile(const std::string& filename, const std::vector
         else if (extension == "png")
         {
             // PNG format
-            if (stbi_write_png(filename.c_str(), size.x, size.y, 4, &pixels[0], 0))
+            if (writePng(filename, pixels, size.x, size.y, options))
                 return true;
         }
         else if (extension == "jpg" || extension == "jpeg")
         {
             // JPG format
-            if (writeJpg(filename, pixels, size.x, size.y))
+            if (writeJpg(filename, pixels, size.x, size.y, options))
+                return true;
+        }
+        else if (extension == "qoi")
+        {
+            // QOI format
+            if (writeQoi(filename, pixels, size.x, size.y))
                 return true;
         }
     }
 
+    Lock lock(errorMutex);
     err() << "Failed to save image \"" << filename << "\"" << std::endl;
     return false;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, const Image::SaveOptions& options)
 {
     // Open the file to write in
     FILE* file = fopen(filename.c_str(), "wb");
@@ -288,8 +944,18 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
 
     // Initialize the error handler
     jpeg_compress_struct compressInfos;
-    jpeg_error_mgr errorManager;
-    compressInfos.err = jpeg_std_error(&errorManager);
+    JpegErrorManager errorManager;
+    compressInfos.err = jpeg_std_error(&errorManager.base);
+    errorManager.base.error_exit = &jpegErrorExit;
+    errorManager.base.output_message = &jpegOutputMessage;
+
+    // libjpeg jumps back here on error; nothing with a destructor must be created below
+    if (setjmp(errorManager.jump))
+    {
+        jpeg_destroy_compress(&compressInfos);
+        fclose(file);
+        return false;
+    }
 
     // Initialize all the writing and compression infos
     jpeg_create_compress(&compressInfos);
@@ -299,26 +965,21 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     compressInfos.in_color_space   = JCS_RGB;
     jpeg_stdio_dest(&compressInfos, file);
     jpeg_set_defaults(&compressInfos);
-    jpeg_set_quality(&compressInfos, 90, TRUE);
+    jpeg_set_quality(&compressInfos, static_cast<int>(options.jpegQuality), TRUE);
 
-    // Get rid of the alpha channel
-    std::vector<Uint8> buffer(width * height * 3);
-    for (std::size_t i = 0; i < width * height; ++i)
-    {
-        buffer[i * 3 + 0] = pixels[i * 4 + 0];
-        buffer[i * 3 + 1] = pixels[i * 4 + 1];
-        buffer[i * 3 + 2] = pixels[i * 4 + 2];
-    }
-    Uint8* ptr = &buffer[0];
+    // The chroma subsampling is given by the sampling factors of the luminance
+    compressInfos.comp_info[0].h_samp_factor = (options.jpegSubsampling == Image::Subsampling444) ? 1 : 2;
+    compressInfos.comp_info[0].v_samp_factor = (options.jpegSubsampling == Image::Subsampling420) ? 2 : 1;
 
     // Start compression
     jpeg_start_compress(&compressInfos, TRUE);
 
-    // Write each row of the image
+    // Write each row of the image, without its alpha channel
+    JSAMPARRAY row = (*compressInfos.mem->alloc_sarray)(reinterpret_cast<j_common_ptr>(&compressInfos), JPOOL_IMAGE, width * 3, 1);
     while (compressInfos.next_scanline < compressInfos.image_height)
     {
-        JSAMPROW rawPointer = ptr + (compressInfos.next_scanline * width * 3);
-        jpeg_write_scanlines(&compressInfos, &rawPointer, 1);
+        convertPixels(&pixels[compressInfos.next_scanline * width * 4], RGBA8, row[0], RGB8, width);
+        jpeg_write_scanlines(&compressInfos, row, 1);
     }
 
     // Finish compression
@@ -326,9 +987,203 @@ bool ImageLoader::writeJpg(const std::string& filename, const std::vector<Uint8>
     jpeg_destroy_compress(&compressInfos);
 
     // Close the file
-    fclose(file);
+    return fclose(file) == 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::writePng(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, const Image::SaveOptions& options)
+{
+    // Filter the rows, each one is preceded by the type of its filter
+    std::size_t pitch = width * 4;
+    std::vector<Uint8> filtered((pitch + 1) * height);
+    std::vector<Uint8> zeros(pitch, 0);
+    std::vector<Uint8> candidate(options.pngFilter == Image::PngFilterAdaptive ? pitch : 0);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        const Uint8* row = &pixels[y * pitch];
+        const Uint8* previous = y > 0 ? row - pitch : &zeros[0];
+        Uint8* output = &filtered[y * (pitch + 1)];
+
+        if (options.pngFilter == Image::PngFilterAdaptive)
+        {
+            // Keep the filter whose output has the smallest sum of absolute values (as signed bytes)
+            unsigned long bestCost = 0;
+            for (int type = Image::PngFilterNone; type <= Image::PngFilterPaeth; ++type)
+            {
+                filterPngRow(type, row, previous, pitch, &candidate[0]);
+
+                unsigned long cost = 0;
+                for (std::size_t i = 0; i < pitch; ++i)
+                    cost += std::abs(static_cast<signed char>(candidate[i]));
+
+                if ((type == Image::PngFilterNone) || (cost < bestCost))
+                {
+                    bestCost = cost;
+                    output[0] = static_cast<Uint8>(type);
+                    std::memcpy(output + 1, &candidate[0], pitch);
+                }
+            }
+        }
+        else
+        {
+            output[0] = static_cast<Uint8>(options.pngFilter);
+            filterPngRow(options.pngFilter, row, previous, pitch, output + 1);
+        }
+    }
+
+    // Compress the filtered rows; level 0 stores them as is, the other levels
+    // select the length of the match chains searched by stb_image_write
+    static const int chainLengths[10] = {0, 5, 5, 6, 6, 7, 8, 16, 32, 64};
+    unsigned int level = std::min(options.pngCompression, 9u);
+    std::vector<Uint8> stored;
+    unsigned char* compressed = NULL;
+    int compressedSize = 0;
+    if (level == 0)
+    {
+        storeZlib(&filtered[0], filtered.size(), stored);
+    }
+    else
+    {
+        compressed = stbi_zlib_compress(&filtered[0], static_cast<int>(filtered.size()), &compressedSize, chainLengths[level]);
+        if (!compressed)
+            return false;
+    }
+    std::vector<Uint8>().swap(filtered);
+
+    // Write the file
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+    {
+        std::free(compressed);
+        return false;
+    }
+
+    static const Uint8 signature[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    std::vector<Uint8> header;
+    appendUint32(header, width);
+    appendUint32(header, height);
+    header.push_back(8); // Bits per component
+    header.push_back(6); // RGBA
+    header.push_back(0); // Compression method
+    header.push_back(0); // Filter method
+    header.push_back(0); // No interlacing
+
+    bool success = (std::fwrite(signature, 1, sizeof(signature), file) == sizeof(signature)) &&
+                   writePngChunk(file, "IHDR", &header[0], header.size()) &&
+                   (compressed ? writePngChunk(file, "IDAT", compressed, compressedSize) : writePngChunk(file, "IDAT", &stored[0], stored.size())) &&
+                   writePngChunk(file, "IEND", NULL, 0);
+
+    std::free(compressed);
+    return (std::fclose(file) == 0) && success;
+}
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::writeQoi(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height)
+{
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+        return false;
+
+    // The encoded data is written by blocks; an operation is at most 5 bytes long
+    std::vector<Uint8> buffer;
+    buffer.reserve(65536 + 5);
+    bool success = true;
+
+    appendUint32(buffer, 0x716F6966); // "qoif"
+    appendUint32(buffer, width);
+    appendUint32(buffer, height);
+    buffer.push_back(4); // RGBA
+    buffer.push_back(0); // sRGB with linear alpha
+
+    Uint8 index[64 * 4] = {0};
+    Uint8 previous[4] = {0, 0, 0, 255};
+    unsigned int run = 0;
+
+    const Uint8* pixel = &pixels[0];
+    const Uint8* end = pixel + static_cast<std::size_t>(width) * height * 4;
+    for (; pixel < end; pixel += 4)
+    {
+        if (std::memcmp(pixel, previous, 4) == 0)
+        {
+            // QOI_OP_RUN
+            if (++run == 62)
+            {
+                buffer.push_back(static_cast<Uint8>(0xC0 | (run - 1)));
+                run = 0;
+            }
+        }
+        else
+        {
+            if (run > 0)
+            {
+                buffer.push_back(static_cast<Uint8>(0xC0 | (run - 1)));
+                run = 0;
+            }
+
+            unsigned int hash = getQoiHash(pixel);
+            if (std::memcmp(index + hash * 4, pixel, 4) == 0)
+            {
+                // QOI_OP_INDEX
+                buffer.push_back(static_cast<Uint8>(hash));
+            }
+            else
+            {
+                std::memcpy(index + hash * 4, pixel, 4);
+
+                if (pixel[3] == previous[3])
+                {
+                    int red = static_cast<signed char>(pixel[0] - previous[0]);
+                    int green = static_cast<signed char>(pixel[1] - previous[1]);
+                    int blue = static_cast<signed char>(pixel[2] - previous[2]);
+                    int redGreen = red - green;
+                    int blueGreen = blue - green;
+
+                    if ((red >= -2) && (red <= 1) && (green >= -2) && (green <= 1) && (blue >= -2) && (blue <= 1))
+                    {
+                        // QOI_OP_DIFF
+                        buffer.push_back(static_cast<Uint8>(0x40 | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2)));
+                    }
+                    else if ((green >= -32) && (green <= 31) && (redGreen >= -8) && (redGreen <= 7) && (blueGreen >= -8) && (blueGreen <= 7))
+                    {
+                        // QOI_OP_LUMA
+                        buffer.push_back(static_cast<Uint8>(0x80 | (green + 32)));
+                        buffer.push_back(static_cast<Uint8>(((redGreen + 8) << 4) | (blueGreen + 8)));
+                    }
+                    else
+                    {
+                        // QOI_OP_RGB
+                        buffer.push_back(0xFE);
+                        buffer.insert(buffer.end(), pixel, pixel + 3);
+                    }
+                }
+                else
+                {
+                    // QOI_OP_RGBA
+                    buffer.push_back(0xFF);
+                    buffer.insert(buffer.end(), pixel, pixel + 4);
+                }
+            }
+
+            std::memcpy(previous, pixel, 4);
+        }
+
+        if (buffer.size() >= 65536)
+        {
+            success = success && (std::fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size());
+            buffer.clear();
+        }
+    }
+
+    if (run > 0)
+        buffer.push_back(static_cast<Uint8>(0xC0 | (run - 1)));
+
+    // End marker
+    static const Uint8 padding[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+    buffer.insert(buffer.end(), padding, padding + 8);
+    success = success && (std::fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size());
 
-    return true;
+    return (std::fclose(file) == 0) && success;
 }
 
 } // namespace priv
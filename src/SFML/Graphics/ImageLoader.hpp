@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <string>
@@ -59,39 +60,51 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file on disk
     ///
-    /// \param filename Path of image file to load
-    /// \param pixels   Array of pixels to fill with loaded image
-    /// \param size     Size of loaded image, in pixels
+    /// JPEG images are decoded with libjpeg; if \a targetSize is
+    /// not zero, they are downscaled during decoding by 1/2, 1/4
+    /// or 1/8, as long as they stay at least as large as the
+    /// target. Zero components of the target are ignored.
+    ///
+    /// \param filename   Path of image file to load
+    /// \param pixels     Array of pixels to fill with loaded image
+    /// \param size       Size of loaded image, in pixels
+    /// \param targetSize Smallest size wanted for the image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::string& filename, std::vector<Uint8>& pixels, Vector2u& size, const Vector2u& targetSize);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
     ///
-    /// \param data     Pointer to the file data in memory
-    /// \param dataSize Size of the data to load, in bytes
-    /// \param pixels   Array of pixels to fill with loaded image
-    /// \param size     Size of loaded image, in pixels
+    /// See loadImageFromFile for the meaning of \a targetSize.
+    ///
+    /// \param data       Pointer to the file data in memory
+    /// \param dataSize   Size of the data to load, in bytes
+    /// \param pixels     Array of pixels to fill with loaded image
+    /// \param size       Size of loaded image, in pixels
+    /// \param targetSize Smallest size wanted for the image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size, const Vector2u& targetSize);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
     ///
-    /// \param stream Source stream to read from
-    /// \param pixels Array of pixels to fill with loaded image
-    /// \param size   Size of loaded image, in pixels
+    /// See loadImageFromFile for the meaning of \a targetSize.
+    ///
+    /// \param stream     Source stream to read from
+    /// \param pixels     Array of pixels to fill with loaded image
+    /// \param size       Size of loaded image, in pixels
+    /// \param targetSize Smallest size wanted for the image, in pixels
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size, const Vector2u& targetSize);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -99,11 +112,12 @@ public:
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param options  Options of the encoder
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::string& filename, const std::vector<Uint8>& pixels, const Vector2u& size, const Image::SaveOptions& options);
 
 private:
 
@@ -126,11 +140,39 @@ private:
     /// \param pixels   Array of pixels to save to image
     /// \param width    Width of image to save, in pixels
     /// \param height   Height of image to save, in pixels
+    /// \param options  Options of the encoder
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, const Image::SaveOptions& options);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an image file in PNG format
+    ///
+    /// \param filename Path of image file to save
+    /// \param pixels   Array of pixels to save to image
+    /// \param width    Width of image to save, in pixels
+    /// \param height   Height of image to save, in pixels
+    /// \param options  Options of the encoder
+    ///
+    /// \return True if saving was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool writePng(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height, const Image::SaveOptions& options);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Save an image file in QOI format
+    ///
+    /// \param filename Path of image file to save
+    /// \param pixels   Array of pixels to save to image
+    /// \param width    Width of image to save, in pixels
+    /// \param height   Height of image to save, in pixels
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool writeJpg(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
+    bool writeQoi(const std::string& filename, const std::vector<Uint8>& pixels, unsigned int width, unsigned int height);
 };
 
 } // namespace priv
@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageResampler.hpp>
+#include <SFML/System/Thread.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SFML_IMAGERESAMPLER_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #define SFML_IMAGERESAMPLER_NEON
+    #include <arm_neon.h>
+#endif
+
+
+namespace
+{
+    // Weights are stored as 16-bit fixed point numbers with this many fractional bits
+    const int precisionBits = 14;
+
+    // Filter kernels, evaluated at a distance given in source pixels
+    double box(double x)
+    {
+        return ((x > -0.5) && (x <= 0.5)) ? 1.0 : 0.0;
+    }
+
+    double bilinear(double x)
+    {
+        x = std::fabs(x);
+        return (x < 1.0) ? 1.0 - x : 0.0;
+    }
+
+    double sinc(double x)
+    {
+        if (x == 0.0)
+            return 1.0;
+
+        x *= 3.14159265358979323846;
+        return std::sin(x) / x;
+    }
+
+    double lanczos(double x)
+    {
+        return ((x > -3.0) && (x < 3.0)) ? sinc(x) * sinc(x / 3.0) : 0.0;
+    }
+
+    // Source pixels and weights contributing to each destination pixel along one axis
+    struct Coefficients
+    {
+        std::vector<int>       start;   // First source pixel of each destination pixel
+        std::vector<int>       count;   // Number of source pixels of each destination pixel
+        std::vector<sf::Int16> weights; // Weights of each destination pixel, "stride" apart
+        int                    stride;  // Maximum number of source pixels per destination pixel
+    };
+
+    // Compute the weights mapping inSize source pixels to outSize destination pixels
+    void computeCoefficients(unsigned int inSize, unsigned int outSize, sf::Image::ResizeFilter filter, Coefficients& coefficients)
+    {
+        double (*kernel)(double) = bilinear;
+        double support = 1.0;
+        switch (filter)
+        {
+            case sf::Image::Box:      kernel = box;      support = 0.5; break;
+            case sf::Image::Bilinear: kernel = bilinear; support = 1.0; break;
+            case sf::Image::Lanczos:  kernel = lanczos;  support = 3.0; break;
+        }
+
+        // When downscaling, the kernel is stretched to cover all the source pixels
+        double scale       = static_cast<double>(inSize) / outSize;
+        double filterScale = std::max(scale, 1.0);
+        support *= filterScale;
+
+        coefficients.stride = static_cast<int>(std::ceil(support)) * 2 + 1;
+        coefficients.start.resize(outSize);
+        coefficients.count.resize(outSize);
+        coefficients.weights.assign(outSize * coefficients.stride, 0);
+
+        std::vector<double> weights(coefficients.stride);
+        for (unsigned int i = 0; i < outSize; ++i)
+        {
+            double center = (i + 0.5) * scale;
+            int    first  = std::max(static_cast<int>(center - support + 0.5), 0);
+            int    last   = std::min(static_cast<int>(center + support + 0.5), static_cast<int>(inSize));
+            int    count  = std::min(std::max(last - first, 1), coefficients.stride);
+
+            double total = 0.0;
+            for (int j = 0; j < count; ++j)
+            {
+                weights[j] = kernel((first + j - center + 0.5) / filterScale);
+                total += weights[j];
+            }
+
+            sf::Int16* fixed = &coefficients.weights[i * coefficients.stride];
+            for (int j = 0; j < count; ++j)
+            {
+                double weight = (total != 0.0) ? weights[j] / total : (j == 0 ? 1.0 : 0.0);
+                fixed[j] = static_cast<sf::Int16>(std::floor(weight * (1 << precisionBits) + 0.5));
+            }
+
+            coefficients.start[i] = first;
+            coefficients.count[i] = count;
+        }
+    }
+
+    // Convert a fixed point accumulator to a component
+    inline sf::Uint8 toComponent(int value)
+    {
+        value >>= precisionBits;
+        return static_cast<sf::Uint8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    // Resample one row of pixels horizontally
+    void resampleRow(const sf::Uint8* source, sf::Uint8* destination, unsigned int width, const Coefficients& coefficients)
+    {
+        for (unsigned int x = 0; x < width; ++x, destination += 4)
+        {
+            const sf::Uint8* pixels  = source + coefficients.start[x] * 4;
+            const sf::Int16* weights = &coefficients.weights[x * coefficients.stride];
+            int              count   = coefficients.count[x];
+            int              k       = 0;
+
+#if defined(SFML_IMAGERESAMPLER_SSE2)
+
+            // Accumulate two source pixels per step, with their components interleaved
+            // so that madd computes pixel0 * weight0 + pixel1 * weight1 per component
+            __m128i zero = _mm_setzero_si128();
+            __m128i sum  = _mm_set1_epi32(1 << (precisionBits - 1));
+            for (; k + 1 < count; k += 2)
+            {
+                __m128i values = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels + k * 4));
+                values = _mm_unpacklo_epi8(_mm_unpacklo_epi8(values, _mm_srli_si128(values, 4)), zero);
+
+                sf::Uint32 pair = static_cast<sf::Uint16>(weights[k]) | (static_cast<sf::Uint32>(static_cast<sf::Uint16>(weights[k + 1])) << 16);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(values, _mm_set1_epi32(static_cast<int>(pair))));
+            }
+            if (k < count)
+            {
+                int word;
+                std::memcpy(&word, pixels + k * 4, sizeof(word));
+                __m128i values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(word), zero), zero);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(values, _mm_set1_epi32(static_cast<sf::Uint16>(weights[k]))));
+            }
+
+            sum = _mm_srai_epi32(sum, precisionBits);
+            sum = _mm_packus_epi16(_mm_packs_epi32(sum, sum), zero);
+            int result = _mm_cvtsi128_si32(sum);
+            std::memcpy(destination, &result, sizeof(result));
+
+#elif defined(SFML_IMAGERESAMPLER_NEON)
+
+            int32x4_t sum = vdupq_n_s32(1 << (precisionBits - 1));
+            for (; k < count; ++k)
+            {
+                sf::Uint32 word;
+                std::memcpy(&word, pixels + k * 4, sizeof(word));
+                int16x8_t values = vreinterpretq_s16_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(word))));
+                sum = vmlal_n_s16(sum, vget_low_s16(values), weights[k]);
+            }
+
+            int16x4_t  narrow = vqmovn_s32(vshrq_n_s32(sum, precisionBits));
+            uint8x8_t  bytes  = vqmovun_s16(vcombine_s16(narrow, narrow));
+            sf::Uint32 result = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+            std::memcpy(destination, &result, sizeof(result));
+
+#else
+
+            int sum[4] = {1 << (precisionBits - 1), 1 << (precisionBits - 1), 1 << (precisionBits - 1), 1 << (precisionBits - 1)};
+            for (; k < count; ++k)
+            {
+                sum[0] += pixels[k * 4 + 0] * weights[k];
+                sum[1] += pixels[k * 4 + 1] * weights[k];
+                sum[2] += pixels[k * 4 + 2] * weights[k];
+                sum[3] += pixels[k * 4 + 3] * weights[k];
+            }
+
+            destination[0] = toComponent(sum[0]);
+            destination[1] = toComponent(sum[1]);
+            destination[2] = toComponent(sum[2]);
+            destination[3] = toComponent(sum[3]);
+
+#endif
+        }
+    }
+
+    // Resample one destination row vertically from a set of source rows
+    void resampleColumns(const sf::Uint8* const* rows, const sf::Int16* weights, int count, sf::Uint8* destination, unsigned int width)
+    {
+        std::size_t size = width * 4;
+        std::size_t i    = 0;
+
+#if defined(SFML_IMAGERESAMPLER_SSE2)
+
+        // Process 4 pixels per step, accumulating two rows at once with interleaved components
+        __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i sum0 = _mm_set1_epi32(1 << (precisionBits - 1));
+            __m128i sum1 = sum0;
+            __m128i sum2 = sum0;
+            __m128i sum3 = sum0;
+
+            for (int k = 0; k < count; k += 2)
+            {
+                __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i));
+                __m128i second = (k + 1 < count) ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1] + i)) : zero;
+                sf::Int16 nextWeight = (k + 1 < count) ? weights[k + 1] : 0;
+
+                sf::Uint32 pair   = static_cast<sf::Uint16>(weights[k]) | (static_cast<sf::Uint32>(static_cast<sf::Uint16>(nextWeight)) << 16);
+                __m128i    factor = _mm_set1_epi32(static_cast<int>(pair));
+
+                __m128i low  = _mm_unpacklo_epi8(first, second);
+                __m128i high = _mm_unpackhi_epi8(first, second);
+                sum0 = _mm_add_epi32(sum0, _mm_madd_epi16(_mm_unpacklo_epi8(low,  zero), factor));
+                sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(_mm_unpackhi_epi8(low,  zero), factor));
+                sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(_mm_unpacklo_epi8(high, zero), factor));
+                sum3 = _mm_add_epi32(sum3, _mm_madd_epi16(_mm_unpackhi_epi8(high, zero), factor));
+            }
+
+            __m128i low  = _mm_packs_epi32(_mm_srai_epi32(sum0, precisionBits), _mm_srai_epi32(sum1, precisionBits));
+            __m128i high = _mm_packs_epi32(_mm_srai_epi32(sum2, precisionBits), _mm_srai_epi32(sum3, precisionBits));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+        }
+
+#elif defined(SFML_IMAGERESAMPLER_NEON)
+
+        // Process 2 pixels per step
+        for (; i + 8 <= size; i += 8)
+        {
+            int32x4_t low  = vdupq_n_s32(1 << (precisionBits - 1));
+            int32x4_t high = low;
+
+            for (int k = 0; k < count; ++k)
+            {
+                int16x8_t values = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(rows[k] + i)));
+                low  = vmlal_n_s16(low,  vget_low_s16(values),  weights[k]);
+                high = vmlal_n_s16(high, vget_high_s16(values), weights[k]);
+            }
+
+            int16x8_t narrow = vcombine_s16(vqmovn_s32(vshrq_n_s32(low, precisionBits)), vqmovn_s32(vshrq_n_s32(high, precisionBits)));
+            vst1_u8(destination + i, vqmovun_s16(narrow));
+        }
+
+#endif
+
+        for (; i < size; ++i)
+        {
+            int sum = 1 << (precisionBits - 1);
+            for (int k = 0; k < count; ++k)
+                sum += rows[k][i] * weights[k];
+
+            destination[i] = toComponent(sum);
+        }
+    }
+
+    // Work shared by all the threads, and band of destination rows of one thread
+    struct ResampleBand
+    {
+        const sf::Uint8*    source;
+        unsigned int        sourceWidth;
+        sf::Uint8*          destination;
+        unsigned int        destinationWidth;
+        const Coefficients* horizontal;
+        const Coefficients* vertical;
+        unsigned int        firstRow;
+        unsigned int        lastRow;
+    };
+
+    // Produce a band of destination rows
+    void resampleBand(ResampleBand* band)
+    {
+        std::size_t sourcePitch      = band->sourceWidth * 4;
+        std::size_t destinationPitch = band->destinationWidth * 4;
+        bool        sameWidth        = (band->sourceWidth == band->destinationWidth);
+
+        // Same height: only the horizontal pass is needed
+        if (!band->vertical)
+        {
+            for (unsigned int y = band->firstRow; y < band->lastRow; ++y)
+                resampleRow(band->source + y * sourcePitch, band->destination + y * destinationPitch, band->destinationWidth, *band->horizontal);
+
+            return;
+        }
+
+        // Horizontally resampled rows are kept in a ring indexed by source row; since the
+        // source rows needed by successive destination rows only move forward, each of
+        // them is resampled once and stays in the ring as long as it's needed
+        const Coefficients& vertical = *band->vertical;
+        std::vector<sf::Uint8>        ring(sameWidth ? 0 : vertical.stride * destinationPitch);
+        std::vector<const sf::Uint8*> rows(vertical.stride);
+
+        int nextRow = vertical.start[band->firstRow];
+        for (unsigned int y = band->firstRow; y < band->lastRow; ++y)
+        {
+            int first = vertical.start[y];
+            int count = vertical.count[y];
+
+            for (int k = 0; k < count; ++k)
+            {
+                int row = first + k;
+                if (sameWidth)
+                {
+                    rows[k] = band->source + row * sourcePitch;
+                }
+                else
+                {
+                    sf::Uint8* slot = &ring[(row % vertical.stride) * destinationPitch];
+                    if (row >= nextRow)
+                        resampleRow(band->source + row * sourcePitch, slot, band->destinationWidth, *band->horizontal);
+
+                    rows[k] = slot;
+                }
+            }
+            nextRow = std::max(nextRow, first + count);
+
+            resampleColumns(&rows[0], &vertical.weights[y * vertical.stride], count, band->destination + y * destinationPitch, band->destinationWidth);
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void resampleImage(const Uint8* source, unsigned int sourceWidth, unsigned int sourceHeight,
+                   Uint8* destination, unsigned int destinationWidth, unsigned int destinationHeight,
+                   Image::ResizeFilter filter, unsigned int threadCount)
+{
+    // Same size: nothing to filter
+    if ((sourceWidth == destinationWidth) && (sourceHeight == destinationHeight))
+    {
+        std::memcpy(destination, source, sourceWidth * sourceHeight * 4);
+        return;
+    }
+
+    Coefficients horizontal;
+    Coefficients vertical;
+    if (sourceWidth != destinationWidth)
+        computeCoefficients(sourceWidth, destinationWidth, filter, horizontal);
+    if (sourceHeight != destinationHeight)
+        computeCoefficients(sourceHeight, destinationHeight, filter, vertical);
+
+    // Give each thread a band of at least a few rows, so that tiny images don't pay for threads
+    const unsigned int minimumRows = 16;
+    threadCount = std::max(1u, std::min(threadCount, destinationHeight / minimumRows));
+
+    std::vector<ResampleBand> bands(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        ResampleBand& band    = bands[i];
+        band.source           = source;
+        band.sourceWidth      = sourceWidth;
+        band.destination      = destination;
+        band.destinationWidth = destinationWidth;
+        band.horizontal       = &horizontal;
+        band.vertical         = (sourceHeight != destinationHeight) ? &vertical : NULL;
+        band.firstRow         = destinationHeight * i / threadCount;
+        band.lastRow          = destinationHeight * (i + 1) / threadCount;
+    }
+
+    // The calling thread processes the first band while the others run
+    std::vector<Thread*> threads(threadCount, NULL);
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads[i] = new Thread(&resampleBand, &bands[i]);
+        threads[i]->launch();
+    }
+
+    resampleBand(&bands[0]);
+
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
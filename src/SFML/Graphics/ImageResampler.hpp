@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_IMAGERESAMPLER_HPP
+#define SFML_IMAGERESAMPLER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Image.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Resample an array of RGBA pixels to a new size
+///
+/// The image is filtered horizontally then vertically, with
+/// fixed point weights. Each thread produces a band of
+/// destination rows and only keeps the few horizontally
+/// filtered rows needed by its current row, so no intermediate
+/// image is allocated.
+///
+/// \param source            Source pixels
+/// \param sourceWidth       Width of the source, in pixels
+/// \param sourceHeight      Height of the source, in pixels
+/// \param destination       Destination pixels, must not overlap the source
+/// \param destinationWidth  Width of the destination, in pixels
+/// \param destinationHeight Height of the destination, in pixels
+/// \param filter            Resampling filter
+/// \param threadCount       Maximum number of threads to use
+///
+////////////////////////////////////////////////////////////
+void resampleImage(const Uint8* source, unsigned int sourceWidth, unsigned int sourceHeight,
+                   Uint8* destination, unsigned int destinationWidth, unsigned int destinationHeight,
+                   Image::ResizeFilter filter, unsigned int threadCount);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGERESAMPLER_HPP
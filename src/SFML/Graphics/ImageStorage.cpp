@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageStorage.hpp>
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+ImageStorage::ImageStorage() :
+m_references(1)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageStorage::~ImageStorage()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageStorage::addReference()
+{
+    // A new reference is always made from an existing one, so no ordering is needed
+#if defined(_MSC_VER)
+    _InterlockedIncrement(&m_references);
+#elif defined(__ATOMIC_RELAXED)
+    __atomic_add_fetch(&m_references, 1, __ATOMIC_RELAXED);
+#else
+    __sync_add_and_fetch(&m_references, 1);
+#endif
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageStorage::removeReference()
+{
+    // The writes made through this reference must be visible to the thread that destroys the storage
+#if defined(_MSC_VER)
+    long references = _InterlockedDecrement(&m_references);
+#elif defined(__ATOMIC_ACQ_REL)
+    long references = __atomic_sub_fetch(&m_references, 1, __ATOMIC_ACQ_REL);
+#else
+    long references = __sync_sub_and_fetch(&m_references, 1);
+#endif
+
+    if (references == 0)
+        delete this;
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageStorage::isShared() const
+{
+    // Once the count is back to one, the other references are gone for good:
+    // synchronize with their release so that the pixels can safely be modified
+#if defined(_MSC_VER)
+    return _InterlockedCompareExchange(&m_references, 0, 0) != 1;
+#elif defined(__ATOMIC_ACQUIRE)
+    return __atomic_load_n(&m_references, __ATOMIC_ACQUIRE) != 1;
+#else
+    return __sync_add_and_fetch(&m_references, 0) != 1;
+#endif
+}
+
+} // namespace priv
+
+} // namespace sf
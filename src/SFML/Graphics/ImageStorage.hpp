@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+#ifndef SFML_IMAGESTORAGE_HPP
+#define SFML_IMAGESTORAGE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Reference counted array of pixels, shared by the
+///        copies of an image until one of them is modified
+///
+/// The reference count is updated atomically, so copies of
+/// the same image can live in different threads.
+///
+////////////////////////////////////////////////////////////
+class ImageStorage : NonCopyable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an empty storage, with one reference
+    ///
+    ////////////////////////////////////////////////////////////
+    ImageStorage();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a reference to the storage
+    ///
+    ////////////////////////////////////////////////////////////
+    void addReference();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a reference to the storage
+    ///
+    /// The storage is destroyed when its last reference is removed.
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeReference();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the storage has more than one reference
+    ///
+    /// \return True if the pixels must be copied before being modified
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isShared() const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Uint8> pixels; ///< Pixels of the image
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor, only called by removeReference
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ImageStorage();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable long m_references; ///< Number of images using the storage
+};
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_IMAGESTORAGE_HPP
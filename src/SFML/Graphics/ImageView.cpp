@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageView.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/PixelConverter.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageView::ImageView() :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0),
+m_format(RGBA8)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0),
+m_format(image.getPixelFormat())
+{
+    // Don't ask an empty image for its pixels, it would complain
+    if (image.getSize().x && image.getSize().y)
+        *this = ImageView(image.getPixelsPtr(), image.getSize().x, image.getSize().y, image.getPixelFormat());
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Image& image, const IntRect& area) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0),
+m_format(image.getPixelFormat())
+{
+    *this = ImageView(image).getSubView(area);
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView::ImageView(const Uint8* pixels, unsigned int width, unsigned int height, PixelFormat format, std::size_t stride) :
+m_pixels(NULL),
+m_size  (0, 0),
+m_stride(0),
+m_format(format)
+{
+    if (pixels && width && height)
+    {
+        m_pixels = pixels;
+        m_size.x = width;
+        m_size.y = height;
+        m_stride = stride ? stride : width * priv::getPixelSize(format);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+ImageView ImageView::getSubView(const IntRect& area) const
+{
+    if (area.width == 0 || (area.height == 0))
+        return *this;
+
+    // Clip the area to the bounds of the view
+    IntRect bounds(0, 0, m_size.x, m_size.y);
+    IntRect rectangle;
+    if (!bounds.intersects(area, rectangle))
+    {
+        ImageView empty;
+        empty.m_format = m_format;
+        return empty;
+    }
+
+    const Uint8* first = m_pixels + rectangle.top * m_stride + rectangle.left * priv::getPixelSize(m_format);
+    return ImageView(first, rectangle.width, rectangle.height, m_format, m_stride);
+}
+
+
+////////////////////////////////////////////////////////////
+const Uint8* ImageView::getPixelsPtr() const
+{
+    return m_pixels;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u ImageView::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ImageView::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+PixelFormat ImageView::getPixelFormat() const
+{
+    return m_format;
+}
+
+} // namespace sf
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/LargeSprite.hpp>
+#include <SFML/Graphics/LargeTexture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LargeSprite::LargeSprite() :
+m_texture(NULL),
+m_color  (Color::White)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+LargeSprite::LargeSprite(const LargeTexture& texture) :
+m_texture(&texture),
+m_color  (Color::White)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeSprite::setTexture(const LargeTexture& texture)
+{
+    m_texture = &texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeSprite::setColor(const Color& color)
+{
+    m_color = color;
+}
+
+
+////////////////////////////////////////////////////////////
+const LargeTexture* LargeSprite::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& LargeSprite::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect LargeSprite::getLocalBounds() const
+{
+    if (!m_texture)
+        return FloatRect();
+
+    Vector2u size = m_texture->getSize();
+    return FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect LargeSprite::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeSprite::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_texture)
+    {
+        states.transform *= getTransform();
+
+        // Bring the area seen by the view back to the texture's pixels
+        FloatRect visible = target.getView().getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+        visible = states.transform.getInverse().transformRect(visible);
+
+        m_texture->draw(target, states, visible, m_color);
+    }
+}
+
+} // namespace sf
@@ -0,0 +1,360 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/LargeTexture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Size of the tiles when none is given
+    const unsigned int defaultTileSize = 512;
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+LargeTexture::LargeTexture() :
+m_image        (),
+m_tileSize     (0),
+m_tileCount    (0, 0),
+m_tiles        (),
+m_isSmooth     (false),
+m_uploadLimit  (0),
+m_residentLimit(0),
+m_residentCount(0),
+m_drawCount    (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::loadFromFile(const std::string& filename, unsigned int tileSize)
+{
+    Image image;
+    return image.loadFromFile(filename) && loadFromImage(image, tileSize);
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::loadFromMemory(const void* data, std::size_t size, unsigned int tileSize)
+{
+    Image image;
+    return image.loadFromMemory(data, size) && loadFromImage(image, tileSize);
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::loadFromStream(InputStream& stream, unsigned int tileSize)
+{
+    Image image;
+    return image.loadFromStream(stream) && loadFromImage(image, tileSize);
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::loadFromImage(const Image& image, unsigned int tileSize)
+{
+    Vector2u size = image.getSize();
+    if ((size.x == 0) || (size.y == 0))
+    {
+        err() << "Failed to load large texture, the image is empty" << std::endl;
+        return false;
+    }
+
+    // Leave room for the border taken from the neighbor tiles
+    if (tileSize == 0)
+        tileSize = defaultTileSize;
+    tileSize = std::min(tileSize, Texture::getMaximumSize() - 2);
+
+    // The image is shared, not copied
+    m_image = image;
+    m_tileSize = tileSize;
+    m_tileCount.x = (size.x + tileSize - 1) / tileSize;
+    m_tileCount.y = (size.y + tileSize - 1) / tileSize;
+    m_residentCount = 0;
+
+    m_tiles.clear();
+    m_tiles.resize(m_tileCount.x * m_tileCount.y);
+
+    for (unsigned int y = 0; y < m_tileCount.y; ++y)
+    {
+        for (unsigned int x = 0; x < m_tileCount.x; ++x)
+        {
+            Tile& tile = m_tiles[x + y * m_tileCount.x];
+
+            unsigned int left = x * tileSize;
+            unsigned int top  = y * tileSize;
+            tile.area = IntRect(left, top, std::min(tileSize, size.x - left), std::min(tileSize, size.y - top));
+
+            // With a one pixel border, the smooth filter reads the
+            // same pixels on both sides of an edge between two tiles
+            unsigned int paddedLeft   = left > 0 ? left - 1 : 0;
+            unsigned int paddedTop    = top > 0 ? top - 1 : 0;
+            unsigned int paddedRight  = std::min(left + tile.area.width + 1, size.x);
+            unsigned int paddedBottom = std::min(top + tile.area.height + 1, size.y);
+            tile.padded = IntRect(paddedLeft, paddedTop, paddedRight - paddedLeft, paddedBottom - paddedTop);
+
+            tile.lastUse = 0;
+        }
+    }
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u LargeTexture::getSize() const
+{
+    return m_image.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int LargeTexture::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeTexture::setSmooth(bool smooth)
+{
+    if (smooth != m_isSmooth)
+    {
+        m_isSmooth = smooth;
+
+        for (std::vector<Tile>::iterator i = m_tiles.begin(); i != m_tiles.end(); ++i)
+        {
+            if (i->texture.getNativeHandle())
+                i->texture.setSmooth(smooth);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::isSmooth() const
+{
+    return m_isSmooth;
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeTexture::setUploadLimit(unsigned int count)
+{
+    m_uploadLimit = count;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int LargeTexture::getUploadLimit() const
+{
+    return m_uploadLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeTexture::setResidentLimit(unsigned int count)
+{
+    m_residentLimit = count;
+    evictTiles();
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int LargeTexture::getResidentLimit() const
+{
+    return m_residentLimit;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int LargeTexture::getResidentCount() const
+{
+    return m_residentCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeTexture::upload(const FloatRect& area)
+{
+    Vector2u size = getSize();
+    FloatRect rectangle = area;
+    if ((area.width == 0) || (area.height == 0))
+        rectangle = FloatRect(0.f, 0.f, static_cast<float>(size.x), static_cast<float>(size.y));
+
+    IntRect range;
+    if (!getTileRange(rectangle, range))
+        return;
+
+    // The tiles count as drawn, so that they don't evict each other
+    ++m_drawCount;
+
+    for (int y = range.top; y < range.top + range.height; ++y)
+    {
+        for (int x = range.left; x < range.left + range.width; ++x)
+        {
+            Tile& tile = m_tiles[x + y * m_tileCount.x];
+            tile.lastUse = m_drawCount;
+            uploadTile(tile);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeTexture::draw(RenderTarget& target, RenderStates states, const FloatRect& area, const Color& color) const
+{
+    IntRect range;
+    if (!getTileRange(area, range))
+        return;
+
+    ++m_drawCount;
+
+    Vertex vertices[4];
+    for (int i = 0; i < 4; ++i)
+        vertices[i].color = color;
+
+    unsigned int uploads = 0;
+    for (int y = range.top; y < range.top + range.height; ++y)
+    {
+        for (int x = range.left; x < range.left + range.width; ++x)
+        {
+            Tile& tile = m_tiles[x + y * m_tileCount.x];
+            tile.lastUse = m_drawCount;
+
+            if (!tile.texture.getNativeHandle())
+            {
+                // Over the limit, the tile will be uploaded by one of the next draws
+                if (m_uploadLimit && (uploads >= m_uploadLimit))
+                    continue;
+
+                ++uploads;
+                if (!uploadTile(tile))
+                    continue;
+            }
+
+            // The tile is drawn at its place in the image, without its border
+            float left   = static_cast<float>(tile.area.left);
+            float top    = static_cast<float>(tile.area.top);
+            float right  = static_cast<float>(tile.area.left + tile.area.width);
+            float bottom = static_cast<float>(tile.area.top + tile.area.height);
+            float u      = static_cast<float>(tile.area.left - tile.padded.left);
+            float v      = static_cast<float>(tile.area.top - tile.padded.top);
+
+            vertices[0].position = Vector2f(left, top);
+            vertices[1].position = Vector2f(left, bottom);
+            vertices[2].position = Vector2f(right, top);
+            vertices[3].position = Vector2f(right, bottom);
+
+            vertices[0].texCoords = Vector2f(u, v);
+            vertices[1].texCoords = Vector2f(u, v + tile.area.height);
+            vertices[2].texCoords = Vector2f(u + tile.area.width, v);
+            vertices[3].texCoords = Vector2f(u + tile.area.width, v + tile.area.height);
+
+            states.texture = &tile.texture;
+            target.draw(vertices, 4, TriangleStrip, states);
+        }
+    }
+
+    // The tiles that just left the view may be over the limit
+    evictTiles();
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::getTileRange(const FloatRect& area, IntRect& range) const
+{
+    if (m_tiles.empty())
+        return false;
+
+    // Clip the area to the texture
+    Vector2u size = getSize();
+    float left   = std::max(area.left, 0.f);
+    float top    = std::max(area.top, 0.f);
+    float right  = std::min(area.left + area.width, static_cast<float>(size.x));
+    float bottom = std::min(area.top + area.height, static_cast<float>(size.y));
+    if ((left >= right) || (top >= bottom))
+        return false;
+
+    float tileSize = static_cast<float>(m_tileSize);
+    range.left   = static_cast<int>(left / tileSize);
+    range.top    = static_cast<int>(top / tileSize);
+    range.width  = static_cast<int>(std::ceil(right / tileSize)) - range.left;
+    range.height = static_cast<int>(std::ceil(bottom / tileSize)) - range.top;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool LargeTexture::uploadTile(Tile& tile) const
+{
+    if (tile.texture.getNativeHandle())
+        return true;
+
+    // The tile is uploaded directly from the pixels of the image
+    if (!tile.texture.loadFromImage(ImageView(m_image, tile.padded)))
+        return false;
+
+    tile.texture.setSmooth(m_isSmooth);
+    ++m_residentCount;
+
+    evictTiles();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void LargeTexture::evictTiles() const
+{
+    while (m_residentLimit && (m_residentCount > m_residentLimit))
+    {
+        // Find the least recently used tile, the ones of the current draw are kept
+        Tile* oldest = NULL;
+        for (std::vector<Tile>::iterator i = m_tiles.begin(); i != m_tiles.end(); ++i)
+        {
+            if (i->texture.getNativeHandle() && (i->lastUse != m_drawCount) && (!oldest || (i->lastUse < oldest->lastUse)))
+                oldest = &*i;
+        }
+
+        if (!oldest)
+            return;
+
+        // Destroy the texture of the tile
+        Texture().swap(oldest->texture);
+        --m_residentCount;
+    }
+}
+
+} // namespace sf
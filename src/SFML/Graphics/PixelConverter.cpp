@@ -0,0 +1,561 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelConverter.hpp>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SFML_PIXELCONVERTER_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #define SFML_PIXELCONVERTER_NEON
+    #include <arm_neon.h>
+#endif
+
+
+namespace
+{
+    // Store a 16-bit pixel in native byte order
+    inline void storeWord(sf::Uint8* destination, sf::Uint16 word)
+    {
+        std::memcpy(destination, &word, sizeof(word));
+    }
+
+    // Load a 16-bit pixel in native byte order
+    inline sf::Uint16 loadWord(const sf::Uint8* source)
+    {
+        sf::Uint16 word;
+        std::memcpy(&word, source, sizeof(word));
+        return word;
+    }
+
+    // Widen a 5-bit component to 8 bits
+    inline sf::Uint8 expand5(unsigned int x)
+    {
+        return static_cast<sf::Uint8>((x << 3) | (x >> 2));
+    }
+
+    // Widen a 6-bit component to 8 bits
+    inline sf::Uint8 expand6(unsigned int x)
+    {
+        return static_cast<sf::Uint8>((x << 2) | (x >> 4));
+    }
+
+    // Widen a 4-bit component to 8 bits
+    inline sf::Uint8 expand4(unsigned int x)
+    {
+        return static_cast<sf::Uint8>((x << 4) | x);
+    }
+
+    // Rec. 601 luminance, with weights in 1/256 units
+    inline sf::Uint8 luminance(const sf::Uint8* pixel)
+    {
+        return static_cast<sf::Uint8>((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2] + 128) >> 8);
+    }
+
+#if defined(SFML_PIXELCONVERTER_SSE2)
+
+    // Load 4 bytes as a native 32-bit word
+    inline int loadInt(const sf::Uint8* source)
+    {
+        int word;
+        std::memcpy(&word, source, sizeof(word));
+        return word;
+    }
+
+    // Pack the low 16 bits of each 32-bit lane of two registers, avoiding the signed saturation of packs
+    inline __m128i packLowWords(__m128i a, __m128i b)
+    {
+        a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+        b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+        return _mm_packs_epi32(a, b);
+    }
+
+    // Pack the low byte of each 32-bit lane of four registers, all lanes being below 256
+    inline __m128i packLowBytes(__m128i a, __m128i b, __m128i c, __m128i d)
+    {
+        return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    }
+
+    // RGBA8 to RGB565, one pixel per 32-bit lane
+    inline __m128i toRGB565(__m128i pixels)
+    {
+        __m128i r = _mm_slli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF8)), 8);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 5), _mm_set1_epi32(0x07E0));
+        __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 19), _mm_set1_epi32(0x001F));
+        return _mm_or_si128(_mm_or_si128(r, g), b);
+    }
+
+    // RGBA8 to RGBA4444, one pixel per 32-bit lane
+    inline __m128i toRGBA4444(__m128i pixels)
+    {
+        __m128i r = _mm_slli_epi32(_mm_and_si128(pixels, _mm_set1_epi32(0xF0)), 8);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 4), _mm_set1_epi32(0x0F00));
+        __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 16), _mm_set1_epi32(0x00F0));
+        __m128i a = _mm_srli_epi32(pixels, 28);
+        return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+    }
+
+    // RGBA8 to luminance, one pixel per 32-bit lane
+    inline __m128i toL8(__m128i pixels)
+    {
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        __m128i r = _mm_and_si128(pixels, byteMask);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(pixels, 8), byteMask);
+        __m128i b = _mm_and_si128(_mm_srli_epi32(pixels, 16), byteMask);
+
+        // Products and sums stay below 65536, so 16-bit products don't spill into the high halves
+        __m128i sum = _mm_add_epi32(_mm_mullo_epi16(r, _mm_set1_epi32(77)), _mm_mullo_epi16(g, _mm_set1_epi32(150)));
+        sum = _mm_add_epi32(sum, _mm_mullo_epi16(b, _mm_set1_epi32(29)));
+        return _mm_srli_epi32(_mm_add_epi32(sum, _mm_set1_epi32(128)), 8);
+    }
+
+    // RGB565 to RGBA8, one pixel per 32-bit lane
+    inline __m128i fromRGB565(__m128i words)
+    {
+        __m128i r = _mm_srli_epi32(words, 11);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(words, 5), _mm_set1_epi32(0x3F));
+        __m128i b = _mm_and_si128(words, _mm_set1_epi32(0x1F));
+        r = _mm_or_si128(_mm_slli_epi32(r, 3), _mm_srli_epi32(r, 2));
+        g = _mm_or_si128(_mm_slli_epi32(g, 2), _mm_srli_epi32(g, 4));
+        b = _mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2));
+        __m128i rgb = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)), _mm_slli_epi32(b, 16));
+        return _mm_or_si128(rgb, _mm_set1_epi32(static_cast<int>(0xFF000000)));
+    }
+
+    // RGBA4444 to RGBA8, one pixel per 32-bit lane
+    inline __m128i fromRGBA4444(__m128i words)
+    {
+        // Move each nibble to the high half of its byte, then copy it to the low half
+        __m128i r = _mm_srli_epi32(words, 8);
+        __m128i g = _mm_slli_epi32(_mm_and_si128(words, _mm_set1_epi32(0x0F00)), 4);
+        __m128i b = _mm_slli_epi32(_mm_and_si128(words, _mm_set1_epi32(0x00F0)), 16);
+        __m128i a = _mm_slli_epi32(words, 28);
+        __m128i high = _mm_or_si128(_mm_or_si128(_mm_and_si128(r, _mm_set1_epi32(0xF0)), g), _mm_or_si128(b, a));
+        return _mm_or_si128(high, _mm_srli_epi32(high, 4));
+    }
+
+#endif
+
+
+    ////////////////////////////////////////////////////////////
+    void encodePixels(const sf::Uint8* source, sf::Uint8* destination, sf::PixelFormat format, std::size_t count)
+    {
+        switch (format)
+        {
+            case sf::RGB8:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                // Drop the alpha byte of each pixel, then join the two 6-byte halves; each
+                // store writes 4 bytes past the group, which the next group overwrites
+                const __m128i rgbMask  = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+                const __m128i highMask = _mm_set_epi32(0x0000FFFF, static_cast<int>(0xFF000000), 0x0000FFFF, static_cast<int>(0xFF000000));
+                const __m128i halfMask = _mm_set_epi32(0, 0, 0x0000FFFF, static_cast<int>(0xFFFFFFFF));
+                for (; count >= 6; count -= 4, source += 16, destination += 12)
+                {
+                    __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+                    __m128i halves = _mm_or_si128(_mm_and_si128(pixels, rgbMask), _mm_and_si128(_mm_srli_epi64(pixels, 8), highMask));
+                    __m128i packed = _mm_or_si128(_mm_and_si128(halves, halfMask), _mm_slli_si128(_mm_srli_si128(halves, 8), 6));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packed);
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 32, destination += 24)
+                {
+                    uint8x8x4_t rgba = vld4_u8(source);
+                    uint8x8x3_t rgb;
+                    rgb.val[0] = rgba.val[0];
+                    rgb.val[1] = rgba.val[1];
+                    rgb.val[2] = rgba.val[2];
+                    vst3_u8(destination, rgb);
+                }
+#endif
+                for (; count > 0; --count, source += 4, destination += 3)
+                {
+                    destination[0] = source[0];
+                    destination[1] = source[1];
+                    destination[2] = source[2];
+                }
+                break;
+            }
+
+            case sf::RGB565:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                for (; count >= 8; count -= 8, source += 32, destination += 16)
+                {
+                    __m128i low  = toRGB565(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+                    __m128i high = toRGB565(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packLowWords(low, high));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 32, destination += 16)
+                {
+                    uint8x8x4_t rgba = vld4_u8(source);
+                    uint16x8_t result = vshll_n_u8(rgba.val[0], 8);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[1], 8), 5);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[2], 8), 11);
+                    vst1q_u8(destination, vreinterpretq_u8_u16(result));
+                }
+#endif
+                for (; count > 0; --count, source += 4, destination += 2)
+                    storeWord(destination, static_cast<sf::Uint16>(((source[0] >> 3) << 11) | ((source[1] >> 2) << 5) | (source[2] >> 3)));
+                break;
+            }
+
+            case sf::RGBA4444:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                for (; count >= 8; count -= 8, source += 32, destination += 16)
+                {
+                    __m128i low  = toRGBA4444(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+                    __m128i high = toRGBA4444(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packLowWords(low, high));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 32, destination += 16)
+                {
+                    uint8x8x4_t rgba = vld4_u8(source);
+                    uint16x8_t result = vshll_n_u8(rgba.val[0], 8);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[1], 8), 4);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[2], 8), 8);
+                    result = vsriq_n_u16(result, vshll_n_u8(rgba.val[3], 8), 12);
+                    vst1q_u8(destination, vreinterpretq_u8_u16(result));
+                }
+#endif
+                for (; count > 0; --count, source += 4, destination += 2)
+                    storeWord(destination, static_cast<sf::Uint16>(((source[0] >> 4) << 12) | ((source[1] >> 4) << 8) | ((source[2] >> 4) << 4) | (source[3] >> 4)));
+                break;
+            }
+
+            case sf::L8:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                for (; count >= 16; count -= 16, source += 64, destination += 16)
+                {
+                    __m128i a = toL8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+                    __m128i b = toL8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16)));
+                    __m128i c = toL8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 32)));
+                    __m128i d = toL8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 48)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packLowBytes(a, b, c, d));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 32, destination += 8)
+                {
+                    uint8x8x4_t rgba = vld4_u8(source);
+                    uint16x8_t sum = vmull_u8(rgba.val[0], vdup_n_u8(77));
+                    sum = vmlal_u8(sum, rgba.val[1], vdup_n_u8(150));
+                    sum = vmlal_u8(sum, rgba.val[2], vdup_n_u8(29));
+                    vst1_u8(destination, vrshrn_n_u16(sum, 8));
+                }
+#endif
+                for (; count > 0; --count, source += 4, ++destination)
+                    *destination = luminance(source);
+                break;
+            }
+
+            case sf::A8:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                for (; count >= 16; count -= 16, source += 64, destination += 16)
+                {
+                    __m128i a = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)), 24);
+                    __m128i b = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 16)), 24);
+                    __m128i c = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 32)), 24);
+                    __m128i d = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 48)), 24);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), packLowBytes(a, b, c, d));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 32, destination += 8)
+                    vst1_u8(destination, vld4_u8(source).val[3]);
+#endif
+                for (; count > 0; --count, source += 4, ++destination)
+                    *destination = source[3];
+                break;
+            }
+
+            default:
+            {
+                std::memcpy(destination, source, count * 4);
+                break;
+            }
+        }
+    }
+
+
+    ////////////////////////////////////////////////////////////
+    void decodePixels(const sf::Uint8* source, sf::Uint8* destination, sf::PixelFormat format, std::size_t count)
+    {
+        switch (format)
+        {
+            case sf::RGB8:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                // Read each pixel as a 4-byte word and replace its last byte with the alpha;
+                // one more pixel must follow the group so that the last read stays in bounds
+                const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                for (; count >= 5; count -= 4, source += 12, destination += 16)
+                {
+                    __m128i pixels = _mm_setr_epi32(loadInt(source), loadInt(source + 3), loadInt(source + 6), loadInt(source + 9));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_or_si128(pixels, alpha));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 24, destination += 32)
+                {
+                    uint8x8x3_t rgb = vld3_u8(source);
+                    uint8x8x4_t rgba;
+                    rgba.val[0] = rgb.val[0];
+                    rgba.val[1] = rgb.val[1];
+                    rgba.val[2] = rgb.val[2];
+                    rgba.val[3] = vdup_n_u8(255);
+                    vst4_u8(destination, rgba);
+                }
+#endif
+                for (; count > 0; --count, source += 3, destination += 4)
+                {
+                    destination[0] = source[0];
+                    destination[1] = source[1];
+                    destination[2] = source[2];
+                    destination[3] = 255;
+                }
+                break;
+            }
+
+            case sf::RGB565:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                const __m128i zero = _mm_setzero_si128();
+                for (; count >= 8; count -= 8, source += 16, destination += 32)
+                {
+                    __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), fromRGB565(_mm_unpacklo_epi16(words, zero)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16), fromRGB565(_mm_unpackhi_epi16(words, zero)));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 16, destination += 32)
+                {
+                    // Each narrowing shift leaves the component in the high bits, which are then copied to the low bits
+                    uint16x8_t words = vreinterpretq_u16_u8(vld1q_u8(source));
+                    uint8x8x4_t rgba;
+                    rgba.val[0] = vshrn_n_u16(words, 8);
+                    rgba.val[1] = vshrn_n_u16(words, 3);
+                    rgba.val[2] = vmovn_u16(vshlq_n_u16(words, 3));
+                    rgba.val[0] = vsri_n_u8(rgba.val[0], rgba.val[0], 5);
+                    rgba.val[1] = vsri_n_u8(rgba.val[1], rgba.val[1], 6);
+                    rgba.val[2] = vsri_n_u8(rgba.val[2], rgba.val[2], 5);
+                    rgba.val[3] = vdup_n_u8(255);
+                    vst4_u8(destination, rgba);
+                }
+#endif
+                for (; count > 0; --count, source += 2, destination += 4)
+                {
+                    sf::Uint16 word = loadWord(source);
+                    destination[0] = expand5(word >> 11);
+                    destination[1] = expand6((word >> 5) & 0x3F);
+                    destination[2] = expand5(word & 0x1F);
+                    destination[3] = 255;
+                }
+                break;
+            }
+
+            case sf::RGBA4444:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                const __m128i zero = _mm_setzero_si128();
+                for (; count >= 8; count -= 8, source += 16, destination += 32)
+                {
+                    __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), fromRGBA4444(_mm_unpacklo_epi16(words, zero)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16), fromRGBA4444(_mm_unpackhi_epi16(words, zero)));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 16, destination += 32)
+                {
+                    uint16x8_t words = vreinterpretq_u16_u8(vld1q_u8(source));
+                    uint8x8x4_t rgba;
+                    rgba.val[0] = vshrn_n_u16(words, 8);
+                    rgba.val[1] = vshrn_n_u16(words, 4);
+                    rgba.val[2] = vmovn_u16(words);
+                    rgba.val[3] = vmovn_u16(vshlq_n_u16(words, 4));
+                    rgba.val[0] = vsri_n_u8(rgba.val[0], rgba.val[0], 4);
+                    rgba.val[1] = vsri_n_u8(rgba.val[1], rgba.val[1], 4);
+                    rgba.val[2] = vsri_n_u8(rgba.val[2], rgba.val[2], 4);
+                    rgba.val[3] = vsri_n_u8(rgba.val[3], rgba.val[3], 4);
+                    vst4_u8(destination, rgba);
+                }
+#endif
+                for (; count > 0; --count, source += 2, destination += 4)
+                {
+                    sf::Uint16 word = loadWord(source);
+                    destination[0] = expand4(word >> 12);
+                    destination[1] = expand4((word >> 8) & 0xF);
+                    destination[2] = expand4((word >> 4) & 0xF);
+                    destination[3] = expand4(word & 0xF);
+                }
+                break;
+            }
+
+            case sf::L8:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+                for (; count >= 16; count -= 16, source += 16, destination += 64)
+                {
+                    __m128i grey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+                    __m128i low  = _mm_unpacklo_epi8(grey, grey);
+                    __m128i high = _mm_unpackhi_epi8(grey, grey);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),      _mm_or_si128(_mm_unpacklo_epi16(low, low), alpha));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16), _mm_or_si128(_mm_unpackhi_epi16(low, low), alpha));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 32), _mm_or_si128(_mm_unpacklo_epi16(high, high), alpha));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 48), _mm_or_si128(_mm_unpackhi_epi16(high, high), alpha));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 8, destination += 32)
+                {
+                    uint8x8x4_t rgba;
+                    rgba.val[0] = vld1_u8(source);
+                    rgba.val[1] = rgba.val[0];
+                    rgba.val[2] = rgba.val[0];
+                    rgba.val[3] = vdup_n_u8(255);
+                    vst4_u8(destination, rgba);
+                }
+#endif
+                for (; count > 0; --count, ++source, destination += 4)
+                {
+                    destination[0] = *source;
+                    destination[1] = *source;
+                    destination[2] = *source;
+                    destination[3] = 255;
+                }
+                break;
+            }
+
+            case sf::A8:
+            {
+#if defined(SFML_PIXELCONVERTER_SSE2)
+                const __m128i zero  = _mm_setzero_si128();
+                const __m128i white = _mm_set1_epi32(0x00FFFFFF);
+                for (; count >= 16; count -= 16, source += 16, destination += 64)
+                {
+                    // Interleaving with zeros twice moves each alpha to the high byte of its own 32-bit lane
+                    __m128i alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+                    __m128i low   = _mm_unpacklo_epi8(zero, alpha);
+                    __m128i high  = _mm_unpackhi_epi8(zero, alpha);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination),      _mm_or_si128(_mm_unpacklo_epi16(zero, low), white));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 16), _mm_or_si128(_mm_unpackhi_epi16(zero, low), white));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 32), _mm_or_si128(_mm_unpacklo_epi16(zero, high), white));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + 48), _mm_or_si128(_mm_unpackhi_epi16(zero, high), white));
+                }
+#elif defined(SFML_PIXELCONVERTER_NEON)
+                for (; count >= 8; count -= 8, source += 8, destination += 32)
+                {
+                    uint8x8x4_t rgba;
+                    rgba.val[0] = vdup_n_u8(255);
+                    rgba.val[1] = rgba.val[0];
+                    rgba.val[2] = rgba.val[0];
+                    rgba.val[3] = vld1_u8(source);
+                    vst4_u8(destination, rgba);
+                }
+#endif
+                for (; count > 0; --count, ++source, destination += 4)
+                {
+                    destination[0] = 255;
+                    destination[1] = 255;
+                    destination[2] = 255;
+                    destination[3] = *source;
+                }
+                break;
+            }
+
+            default:
+            {
+                std::memcpy(destination, source, count * 4);
+                break;
+            }
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+std::size_t getPixelSize(PixelFormat format)
+{
+    switch (format)
+    {
+        case RGB8:     return 3;
+        case RGB565:   return 2;
+        case RGBA4444: return 2;
+        case L8:       return 1;
+        case A8:       return 1;
+        default:       return 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertPixels(const Uint8* source, PixelFormat sourceFormat, Uint8* destination, PixelFormat destinationFormat, std::size_t count)
+{
+    if (sourceFormat == destinationFormat)
+    {
+        std::memcpy(destination, source, count * getPixelSize(sourceFormat));
+    }
+    else if (sourceFormat == RGBA8)
+    {
+        encodePixels(source, destination, destinationFormat, count);
+    }
+    else if (destinationFormat == RGBA8)
+    {
+        decodePixels(source, destination, sourceFormat, count);
+    }
+    else
+    {
+        // Go through RGBA8, by chunks small enough to stay in the cache
+        const std::size_t chunkSize = 256;
+        Uint8 buffer[chunkSize * 4];
+
+        std::size_t sourceStep = chunkSize * getPixelSize(sourceFormat);
+        std::size_t destinationStep = chunkSize * getPixelSize(destinationFormat);
+
+        while (count > 0)
+        {
+            std::size_t chunk = count < chunkSize ? count : chunkSize;
+            decodePixels(source, buffer, sourceFormat, chunk);
+            encodePixels(buffer, destination, destinationFormat, chunk);
+
+            source += sourceStep;
+            destination += destinationStep;
+            count -= chunk;
+        }
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
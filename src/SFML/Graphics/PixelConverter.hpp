@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELCONVERTER_HPP
+#define SFML_PIXELCONVERTER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Get the number of bytes used by a pixel of a given format
+///
+/// \param format Pixel format
+///
+/// \return Size of a pixel, in bytes
+///
+////////////////////////////////////////////////////////////
+std::size_t getPixelSize(PixelFormat format);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a span of pixels from one format to another
+///
+/// Conversions from and to RGBA8 use SSE2 or NEON when the
+/// compiler targets it; other conversions go through RGBA8.
+/// Narrowing components are truncated, widened components
+/// replicate their high bits, so that converting to RGBA8 and
+/// back gives the original pixels.
+///
+/// \param source            Pixels to convert
+/// \param sourceFormat      Format of the source pixels
+/// \param destination       Converted pixels, must not overlap the source
+/// \param destinationFormat Format of the destination pixels
+/// \param count             Number of pixels
+///
+////////////////////////////////////////////////////////////
+void convertPixels(const Uint8* source, PixelFormat sourceFormat, Uint8* destination, PixelFormat destinationFormat, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELCONVERTER_HPP
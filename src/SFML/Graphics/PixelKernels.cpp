@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelKernels.hpp>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #define SFML_PIXELKERNELS_SSE2
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    #define SFML_PIXELKERNELS_NEON
+    #include <arm_neon.h>
+#endif
+
+
+namespace
+{
+    // Exact x / 255 for x in [0, 65025]
+    inline sf::Uint8 divide255(unsigned int x)
+    {
+        return static_cast<sf::Uint8>((x + 1 + (x >> 8)) >> 8);
+    }
+
+    // Exact round(x / 255) for x in [0, 65025]
+    inline sf::Uint8 round255(unsigned int x)
+    {
+        x += 128;
+        return static_cast<sf::Uint8>((x + (x >> 8)) >> 8);
+    }
+
+    // Read 4 bytes as a native 32 bits word, so that whole pixels can be compared and stored
+    inline sf::Uint32 toWord(const sf::Uint8* bytes)
+    {
+        sf::Uint32 word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    // Spread the alpha of each pixel over its 4 16-bit components
+    inline __m128i broadcastAlpha(__m128i pixels)
+    {
+        pixels = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+        return _mm_shufflehi_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    // Exact x / 255 on 16-bit components, for x in [0, 65535]
+    inline __m128i divide255(__m128i x)
+    {
+        return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16(static_cast<short>(0x8081))), 7);
+    }
+
+    // Exact round(x / 255) on 16-bit components, for x in [0, 65025]
+    inline __m128i round255(__m128i x)
+    {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    // Exact x / 255 for x in [0, 65025], narrowed to 8 bits
+    inline uint8x8_t divide255(uint16x8_t x)
+    {
+        return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+    }
+
+    // Exact round(x / 255) for x in [0, 65025], narrowed to 8 bits
+    inline uint8x8_t round255(uint16x8_t x)
+    {
+        return vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+    }
+
+#endif
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Uint8* color)
+{
+    Uint32 word = toWord(color);
+
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    __m128i pattern = _mm_set1_epi32(static_cast<int>(word));
+    for (; count >= 4; count -= 4, pixels += 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), pattern);
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    uint8x16_t pattern = vreinterpretq_u8_u32(vdupq_n_u32(word));
+    for (; count >= 4; count -= 4, pixels += 16)
+        vst1q_u8(pixels, pattern);
+
+#endif
+
+    for (; count > 0; --count, pixels += 4)
+        std::memcpy(pixels, &word, sizeof(word));
+}
+
+
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha)
+{
+#if defined(SFML_PIXELKERNELS_SSE2) || defined(SFML_PIXELKERNELS_NEON)
+
+    // Words selecting the alpha byte and holding the new alpha, in memory order
+    const Uint8 alphaMaskBytes[4]  = {0, 0, 0, 255};
+    const Uint8 alphaValueBytes[4] = {0, 0, 0, alpha};
+
+#endif
+
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    __m128i key        = _mm_set1_epi32(static_cast<int>(toWord(color)));
+    __m128i alphaMask  = _mm_set1_epi32(static_cast<int>(toWord(alphaMaskBytes)));
+    __m128i alphaValue = _mm_set1_epi32(static_cast<int>(toWord(alphaValueBytes)));
+    for (; count >= 4; count -= 4, pixels += 16)
+    {
+        __m128i values  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        __m128i matches = _mm_and_si128(_mm_cmpeq_epi32(values, key), alphaMask);
+        values = _mm_or_si128(_mm_andnot_si128(matches, values), _mm_and_si128(matches, alphaValue));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), values);
+    }
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    uint32x4_t key        = vdupq_n_u32(toWord(color));
+    uint32x4_t alphaMask  = vdupq_n_u32(toWord(alphaMaskBytes));
+    uint32x4_t alphaValue = vdupq_n_u32(toWord(alphaValueBytes));
+    for (; count >= 4; count -= 4, pixels += 16)
+    {
+        uint32x4_t values  = vreinterpretq_u32_u8(vld1q_u8(pixels));
+        uint32x4_t matches = vandq_u32(vceqq_u32(values, key), alphaMask);
+        vst1q_u8(pixels, vreinterpretq_u8_u32(vbslq_u32(matches, alphaValue, values)));
+    }
+
+#endif
+
+    for (; count > 0; --count, pixels += 4)
+    {
+        if ((pixels[0] == color[0]) && (pixels[1] == color[1]) && (pixels[2] == color[2]) && (pixels[3] == color[3]))
+            pixels[3] = alpha;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count)
+{
+    Uint8* left  = pixels;
+    Uint8* right = pixels + count * 4;
+
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    // Swap blocks of 4 pixels from both ends, reversing each block
+    while (right - left >= 32)
+    {
+        right -= 16;
+        __m128i leftBlock  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i rightBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left),  _mm_shuffle_epi32(rightBlock, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), _mm_shuffle_epi32(leftBlock,  _MM_SHUFFLE(0, 1, 2, 3)));
+        left += 16;
+    }
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    // Swap blocks of 4 pixels from both ends, reversing each block
+    while (right - left >= 32)
+    {
+        right -= 16;
+        uint32x4_t leftBlock  = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(left)));
+        uint32x4_t rightBlock = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(right)));
+        vst1q_u8(left,  vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(rightBlock), vget_low_u32(rightBlock))));
+        vst1q_u8(right, vreinterpretq_u8_u32(vcombine_u32(vget_high_u32(leftBlock),  vget_low_u32(leftBlock))));
+        left += 16;
+    }
+
+#endif
+
+    while (right - left >= 8)
+    {
+        right -= 4;
+        Uint32 leftPixel  = toWord(left);
+        Uint32 rightPixel = toWord(right);
+        std::memcpy(left,  &rightPixel, sizeof(rightPixel));
+        std::memcpy(right, &leftPixel,  sizeof(leftPixel));
+        left += 4;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count)
+{
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    // The source alpha is replaced by 255 so that the color formula
+    // also gives the alpha one: (255 * a + d * (255 - a)) / 255 = a + d * (255 - a) / 255
+    const Uint8 alphaBytes[4] = {0, 0, 0, 255};
+    __m128i opaque = _mm_set1_epi32(static_cast<int>(toWord(alphaBytes)));
+    __m128i full   = _mm_set1_epi16(255);
+    __m128i zero   = _mm_setzero_si128();
+    for (; count >= 4; count -= 4, source += 16, destination += 16)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination));
+
+        __m128i alphaLow   = broadcastAlpha(_mm_unpacklo_epi8(src, zero));
+        __m128i alphaHigh  = broadcastAlpha(_mm_unpackhi_epi8(src, zero));
+        __m128i colorLow   = _mm_unpacklo_epi8(_mm_or_si128(src, opaque), zero);
+        __m128i colorHigh  = _mm_unpackhi_epi8(_mm_or_si128(src, opaque), zero);
+
+        __m128i low  = _mm_add_epi16(_mm_mullo_epi16(colorLow,  alphaLow),  _mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(full, alphaLow)));
+        __m128i high = _mm_add_epi16(_mm_mullo_epi16(colorHigh, alphaHigh), _mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(full, alphaHigh)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_packus_epi16(divide255(low), divide255(high)));
+    }
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    // Process 8 pixels at once, deinterleaved into one register per component
+    uint8x8_t full = vdup_n_u8(255);
+    for (; count >= 8; count -= 8, source += 32, destination += 32)
+    {
+        uint8x8x4_t src = vld4_u8(source);
+        uint8x8x4_t dst = vld4_u8(destination);
+
+        uint8x8_t alpha   = src.val[3];
+        uint8x8_t inverse = vmvn_u8(alpha);
+
+        dst.val[0] = divide255(vmlal_u8(vmull_u8(src.val[0], alpha), dst.val[0], inverse));
+        dst.val[1] = divide255(vmlal_u8(vmull_u8(src.val[1], alpha), dst.val[1], inverse));
+        dst.val[2] = divide255(vmlal_u8(vmull_u8(src.val[2], alpha), dst.val[2], inverse));
+        dst.val[3] = divide255(vmlal_u8(vmull_u8(full,       alpha), dst.val[3], inverse));
+
+        vst4_u8(destination, dst);
+    }
+
+#endif
+
+    for (; count > 0; --count, source += 4, destination += 4)
+    {
+        unsigned int alpha   = source[3];
+        unsigned int inverse = 255 - alpha;
+        destination[0] = divide255(source[0] * alpha + destination[0] * inverse);
+        destination[1] = divide255(source[1] * alpha + destination[1] * inverse);
+        destination[2] = divide255(source[2] * alpha + destination[2] * inverse);
+        destination[3] = divide255(255       * alpha + destination[3] * inverse);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void blendPremultipliedPixels(Uint8* destination, const Uint8* source, std::size_t count)
+{
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    __m128i full = _mm_set1_epi16(255);
+    __m128i zero = _mm_setzero_si128();
+    for (; count >= 4; count -= 4, source += 16, destination += 16)
+    {
+        __m128i src = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination));
+
+        __m128i inverseLow  = _mm_sub_epi16(full, broadcastAlpha(_mm_unpacklo_epi8(src, zero)));
+        __m128i inverseHigh = _mm_sub_epi16(full, broadcastAlpha(_mm_unpackhi_epi8(src, zero)));
+
+        __m128i low  = round255(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), inverseLow));
+        __m128i high = round255(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), inverseHigh));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), _mm_adds_epu8(src, _mm_packus_epi16(low, high)));
+    }
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    // Process 8 pixels at once, deinterleaved into one register per component
+    for (; count >= 8; count -= 8, source += 32, destination += 32)
+    {
+        uint8x8x4_t src = vld4_u8(source);
+        uint8x8x4_t dst = vld4_u8(destination);
+
+        uint8x8_t inverse = vmvn_u8(src.val[3]);
+
+        dst.val[0] = vqadd_u8(src.val[0], round255(vmull_u8(dst.val[0], inverse)));
+        dst.val[1] = vqadd_u8(src.val[1], round255(vmull_u8(dst.val[1], inverse)));
+        dst.val[2] = vqadd_u8(src.val[2], round255(vmull_u8(dst.val[2], inverse)));
+        dst.val[3] = vqadd_u8(src.val[3], round255(vmull_u8(dst.val[3], inverse)));
+
+        vst4_u8(destination, dst);
+    }
+
+#endif
+
+    for (; count > 0; --count, source += 4, destination += 4)
+    {
+        unsigned int inverse = 255 - source[3];
+        for (int i = 0; i < 4; ++i)
+        {
+            unsigned int value = source[i] + round255(destination[i] * inverse);
+            destination[i] = static_cast<Uint8>(value > 255 ? 255 : value);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count)
+{
+#if defined(SFML_PIXELKERNELS_SSE2)
+
+    // Multiplying the alpha component by 255 leaves it unchanged
+    __m128i alphaFactor = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    __m128i zero        = _mm_setzero_si128();
+    for (; count >= 4; count -= 4, pixels += 16)
+    {
+        __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+
+        __m128i low  = _mm_unpacklo_epi8(values, zero);
+        __m128i high = _mm_unpackhi_epi8(values, zero);
+
+        low  = round255(_mm_mullo_epi16(low,  _mm_or_si128(broadcastAlpha(low),  alphaFactor)));
+        high = round255(_mm_mullo_epi16(high, _mm_or_si128(broadcastAlpha(high), alphaFactor)));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), _mm_packus_epi16(low, high));
+    }
+
+#elif defined(SFML_PIXELKERNELS_NEON)
+
+    // Process 8 pixels at once, deinterleaved into one register per component
+    for (; count >= 8; count -= 8, pixels += 32)
+    {
+        uint8x8x4_t values = vld4_u8(pixels);
+
+        values.val[0] = round255(vmull_u8(values.val[0], values.val[3]));
+        values.val[1] = round255(vmull_u8(values.val[1], values.val[3]));
+        values.val[2] = round255(vmull_u8(values.val[2], values.val[3]));
+
+        vst4_u8(pixels, values);
+    }
+
+#endif
+
+    for (; count > 0; --count, pixels += 4)
+    {
+        unsigned int alpha = pixels[3];
+        pixels[0] = round255(pixels[0] * alpha);
+        pixels[1] = round255(pixels[1] * alpha);
+        pixels[2] = round255(pixels[2] * alpha);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELKERNELS_HPP
+#define SFML_PIXELKERNELS_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// These functions process spans of RGBA pixels (4 bytes each).
+// They use SSE2 or NEON when the compiler targets it, and a
+// portable scalar version otherwise; all the versions produce
+// exactly the same results. Pointers don't need to be aligned.
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \brief Fill pixels with a single color
+///
+/// \param pixels Pixels to fill
+/// \param count  Number of pixels
+/// \param color  RGBA components of the color
+///
+////////////////////////////////////////////////////////////
+void fillPixels(Uint8* pixels, std::size_t count, const Uint8* color);
+
+////////////////////////////////////////////////////////////
+/// \brief Replace the alpha of the pixels matching a color
+///
+/// \param pixels Pixels to process
+/// \param count  Number of pixels
+/// \param color  RGBA components of the color to match
+/// \param alpha  Alpha assigned to the matching pixels
+///
+////////////////////////////////////////////////////////////
+void maskPixels(Uint8* pixels, std::size_t count, const Uint8* color, Uint8 alpha);
+
+////////////////////////////////////////////////////////////
+/// \brief Reverse the order of pixels
+///
+/// \param pixels Pixels to reverse
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void reversePixels(Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Blend pixels with straight (non premultiplied) alpha
+///
+/// dst.rgb = (src.rgb * src.a + dst.rgb * (255 - src.a)) / 255
+/// dst.a   = src.a + dst.a * (255 - src.a) / 255
+///
+/// \param destination Pixels to blend onto
+/// \param source      Pixels to blend
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPixels(Uint8* destination, const Uint8* source, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Blend pixels with premultiplied alpha
+///
+/// dst = src + dst * (255 - src.a) / 255, rounded
+///
+/// \param destination Pixels to blend onto
+/// \param source      Pixels to blend
+/// \param count       Number of pixels
+///
+////////////////////////////////////////////////////////////
+void blendPremultipliedPixels(Uint8* destination, const Uint8* source, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Multiply the color components of pixels by their alpha
+///
+/// rgb = rgb * a / 255, rounded
+///
+/// \param pixels Pixels to convert
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void premultiplyPixels(Uint8* pixels, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELKERNELS_HPP
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PostProcessChain.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Compute the size of a pass from the size of the input of the chain
+    sf::Vector2u getScaledSize(const sf::Vector2u& size, float scale)
+    {
+        unsigned int width  = static_cast<unsigned int>(static_cast<float>(size.x) * scale + 0.5f);
+        unsigned int height = static_cast<unsigned int>(static_cast<float>(size.y) * scale + 0.5f);
+
+        return sf::Vector2u(width > 0 ? width : 1, height > 0 ? height : 1);
+    }
+
+    // Draw a texture entirely as a rectangle of a given size
+    void drawTexture(sf::RenderTarget& target, const sf::Texture& texture, const sf::Vector2f& size, sf::RenderStates states)
+    {
+        sf::Vector2f textureSize(texture.getSize());
+
+        sf::Vertex vertices[4] =
+        {
+            sf::Vertex(sf::Vector2f(0.f, 0.f),       sf::Vector2f(0.f, 0.f)),
+            sf::Vertex(sf::Vector2f(size.x, 0.f),    sf::Vector2f(textureSize.x, 0.f)),
+            sf::Vertex(sf::Vector2f(0.f, size.y),    sf::Vector2f(0.f, textureSize.y)),
+            sf::Vertex(sf::Vector2f(size.x, size.y), sf::Vector2f(textureSize.x, textureSize.y))
+        };
+
+        states.texture = &texture;
+        target.draw(vertices, 4, sf::TriangleStrip, states);
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+PostProcessChain::PostProcessChain() :
+m_passes (),
+m_targets()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+PostProcessChain::~PostProcessChain()
+{
+    releaseTargets();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::addPass(const Shader* shader, float scale)
+{
+    Pass pass;
+    pass.shader = shader;
+    pass.scale = scale;
+
+    m_passes.push_back(pass);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t PostProcessChain::getPassCount() const
+{
+    return m_passes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::clear()
+{
+    m_passes.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void PostProcessChain::releaseTargets()
+{
+    for (std::size_t i = 0; i < m_targets.size(); ++i)
+        delete m_targets[i];
+
+    m_targets.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+bool PostProcessChain::apply(const Texture& input, RenderTarget& target, const RenderStates& states)
+{
+    Vector2u inputSize = input.getSize();
+    if ((inputSize.x == 0) || (inputSize.y == 0))
+        return false;
+
+    // Intermediate passes overwrite their whole target
+    RenderStates passStates(BlendNone);
+
+    const Texture* current = &input;
+    std::size_t last = m_passes.size();
+    std::size_t used = 0;
+
+    for (std::size_t i = 0; i < m_passes.size(); ++i)
+    {
+        const Pass& pass = m_passes[i];
+        Vector2u size = getScaledSize(inputSize, pass.scale);
+
+        if (!pass.shader)
+        {
+            // Resampling passes are merged with the next one if it
+            // resamples too, and are useless at the current resolution
+            // or at the end of the chain, which resamples anyway
+            bool nextResamples = (i + 1 < m_passes.size()) && !m_passes[i + 1].shader;
+            if (nextResamples || (size == current->getSize()) || (i + 1 == m_passes.size()))
+                continue;
+        }
+        else if ((i + 1 == m_passes.size()) && (size == inputSize))
+        {
+            // The last pass at full resolution draws directly to the final target
+            last = i;
+            break;
+        }
+
+        RenderTexture* passTarget = getTarget(size, current, used);
+        if (!passTarget)
+            return false;
+
+        passStates.shader = pass.shader;
+        drawTexture(*passTarget, *current, Vector2f(size), passStates);
+        passTarget->display();
+
+        current = &passTarget->getTexture();
+    }
+
+    // Targets that this run didn't need, typically the ones sized for
+    // the previous input after a resize, would otherwise stay alive forever
+    for (std::size_t i = used; i < m_targets.size(); ++i)
+        delete m_targets[i];
+    m_targets.resize(used);
+
+    // Draw the result
+    RenderStates finalStates(states);
+    finalStates.shader = (last < m_passes.size()) ? m_passes[last].shader : NULL;
+    drawTexture(target, *current, Vector2f(inputSize), finalStates);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTexture* PostProcessChain::getTarget(const Vector2u& size, const Texture* exclude, std::size_t& used)
+{
+    // Reuse a target of the same size, except the one which is read by the pass;
+    // the targets used by the current run are moved to the front of the list
+    for (std::size_t i = 0; i < m_targets.size(); ++i)
+    {
+        if ((m_targets[i]->getSize() == size) && (&m_targets[i]->getTexture() != exclude))
+        {
+            if (i < used)
+                return m_targets[i];
+
+            std::swap(m_targets[i], m_targets[used]);
+            return m_targets[used++];
+        }
+    }
+
+    RenderTexture* target = new RenderTexture;
+    if (!target->create(size.x, size.y))
+    {
+        err() << "Failed to create an intermediate target of " << size.x << "x" << size.y
+              << " pixels for a post-processing chain" << std::endl;
+        delete target;
+        return NULL;
+    }
+
+    target->setSmooth(true);
+    m_targets.push_back(target);
+    std::swap(m_targets.back(), m_targets[used++]);
+
+    return target;
+}
+
+} // namespace sf
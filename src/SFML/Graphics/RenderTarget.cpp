@@ -32,9 +32,26 @@
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/System/Err.hpp>
+#ifdef SFML_OPENGL_ES2
+    #include <SFML/Graphics/GLES2Pipeline.hpp>
+#endif
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
+
+#if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
+
+    #define castToGlHandle(x) reinterpret_cast<GLEXT_GLhandle>(static_cast<ptrdiff_t>(x))
+    #define castFromGlHandle(x) static_cast<unsigned int>(reinterpret_cast<ptrdiff_t>(x))
+
+#else
+
+    #define castToGlHandle(x) (x)
+    #define castFromGlHandle(x) (x)
+
+#endif
+
 namespace
 {
     // Convert an sf::BlendMode::Factor constant to the corresponding OpenGL constant.
@@ -74,6 +91,22 @@ namespace
         assert(false);
         return GLEXT_GL_FUNC_ADD;
     }
+
+
+    // OpenGL capabilities which are changed by SFML and saved by RenderTarget::GLStateScope
+    const GLenum scopedCapabilities[] =
+    {
+        GL_BLEND,
+        GL_CULL_FACE,
+        GL_DEPTH_TEST
+    #ifndef SFML_OPENGL_ES2
+        , GL_TEXTURE_2D,
+        GL_LIGHTING,
+        GL_ALPHA_TEST
+    #endif
+    };
+
+    const std::size_t scopedCapabilityCount = sizeof(scopedCapabilities) / sizeof(scopedCapabilities[0]);
 }
 
 
@@ -86,12 +119,18 @@ m_view       (),
 m_cache      ()
 {
     m_cache.glStatesSet = false;
+    for (int i = 0; i < 3; ++i)
+        m_defaultPrograms[i] = NULL;
 }
 
 
 ////////////////////////////////////////////////////////////
 RenderTarget::~RenderTarget()
 {
+#ifdef SFML_OPENGL_ES2
+    for (int i = 0; i < 3; ++i)
+        delete m_defaultPrograms[i];
+#endif
 }
 
 
@@ -273,10 +312,17 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         bool enableTexCoordsArray = (states.texture || states.shader);
         if (enableTexCoordsArray != m_cache.texCoordsArrayEnabled)
         {
+        #ifdef SFML_OPENGL_ES2
+            if (enableTexCoordsArray)
+                glCheck(glEnableVertexAttribArray(priv::TexCoordsAttribute));
+            else
+                glCheck(glDisableVertexAttribArray(priv::TexCoordsAttribute));
+        #else
             if (enableTexCoordsArray)
                 glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
             else
                 glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+        #endif
             m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
         }
 
@@ -284,11 +330,57 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
         if (vertices)
         {
             const char* data = reinterpret_cast<const char*>(vertices);
+        #ifdef SFML_OPENGL_ES2
+            glCheck(glVertexAttribPointer(priv::PositionAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), data + 0));
+            glCheck(glVertexAttribPointer(priv::ColorAttribute, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), data + 8));
+            if (enableTexCoordsArray)
+                glCheck(glVertexAttribPointer(priv::TexCoordsAttribute, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), data + 12));
+        #else
             glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), data + 0));
             glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), data + 8));
             if (enableTexCoordsArray)
                 glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), data + 12));
+        #endif
+        }
+
+    #ifdef SFML_OPENGL_ES2
+        // There's no fixed-function pipeline: select the program and
+        // pass it the matrices that the other backends load into GL
+        float textureMatrix[16];
+        if (states.texture)
+            states.texture->getMatrix(textureMatrix, Texture::Pixels);
+        else
+            std::memcpy(textureMatrix, Transform::Identity.getMatrix(), sizeof(textureMatrix));
+
+        const Transform& modelView = useVertexCache ? Transform::Identity : states.transform;
+        priv::ProgramState* program = NULL;
+        if (states.shader && states.shader->m_shaderProgram)
+        {
+            // The shader keeps the state of its program (it is already the current program)
+            if (!states.shader->m_programState)
+                states.shader->m_programState = new priv::ProgramState(states.shader->m_shaderProgram, false);
+            program = states.shader->m_programState;
         }
+        else
+        {
+            // The default programs are created on first use, in the context of the target;
+            // A8 textures may sample as black, only their alpha is used
+            priv::ProgramState::DefaultProgram type = priv::ProgramState::Untextured;
+            if (states.texture)
+                type = (states.texture->m_format == A8) ? priv::ProgramState::AlphaTextured : priv::ProgramState::Textured;
+
+            priv::ProgramState*& defaultProgram = m_defaultPrograms[type];
+            if (!defaultProgram)
+                defaultProgram = priv::ProgramState::createDefault(type);
+            program = defaultProgram;
+
+            if (program)
+                glCheck(glUseProgram(program->getProgram()));
+        }
+
+        if (program)
+            program->uploadMatrices(m_view.getTransform().getMatrix(), modelView.getMatrix(), textureMatrix);
+    #endif
 
         // Find the OpenGL primitive type
         static const GLenum modes[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES,
@@ -333,12 +425,14 @@ void RenderTarget::pushGLStates()
             glCheck(glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS));
             glCheck(glPushAttrib(GL_ALL_ATTRIB_BITS));
         #endif
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPushMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPushMatrix());
+        #ifndef SFML_OPENGL_ES2
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPushMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPushMatrix());
+        #endif
     }
 
     resetGLStates();
@@ -350,12 +444,14 @@ void RenderTarget::popGLStates()
 {
     if (setActive(true))
     {
-        glCheck(glMatrixMode(GL_PROJECTION));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_MODELVIEW));
-        glCheck(glPopMatrix());
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glPopMatrix());
+        #ifndef SFML_OPENGL_ES2
+            glCheck(glMatrixMode(GL_PROJECTION));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_MODELVIEW));
+            glCheck(glPopMatrix());
+            glCheck(glMatrixMode(GL_TEXTURE));
+            glCheck(glPopMatrix());
+        #endif
         #ifndef SFML_OPENGL_ES
             glCheck(glPopClientAttrib());
             glCheck(glPopAttrib());
@@ -378,21 +474,29 @@ void RenderTarget::resetGLStates()
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
+        #ifndef SFML_OPENGL_ES2
             glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+        #endif
             glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
         }
 
         // Define the default OpenGL states
         glCheck(glDisable(GL_CULL_FACE));
-        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_DEPTH_TEST));
+        glCheck(glEnable(GL_BLEND));
+    #ifdef SFML_OPENGL_ES2
+        glCheck(glEnableVertexAttribArray(priv::PositionAttribute));
+        glCheck(glEnableVertexAttribArray(priv::ColorAttribute));
+        glCheck(glEnableVertexAttribArray(priv::TexCoordsAttribute));
+    #else
+        glCheck(glDisable(GL_LIGHTING));
         glCheck(glDisable(GL_ALPHA_TEST));
         glCheck(glEnable(GL_TEXTURE_2D));
-        glCheck(glEnable(GL_BLEND));
         glCheck(glMatrixMode(GL_MODELVIEW));
         glCheck(glEnableClientState(GL_VERTEX_ARRAY));
         glCheck(glEnableClientState(GL_COLOR_ARRAY));
         glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+    #endif
         m_cache.glStatesSet = true;
 
         // Apply the default SFML states
@@ -432,6 +536,8 @@ void RenderTarget::applyCurrentView()
     int top = getSize().y - (viewport.top + viewport.height);
     glCheck(glViewport(viewport.left, top, viewport.width, viewport.height));
 
+#ifndef SFML_OPENGL_ES2
+
     // Set the projection matrix
     glCheck(glMatrixMode(GL_PROJECTION));
     glCheck(glLoadMatrixf(m_view.getTransform().getMatrix()));
@@ -439,6 +545,8 @@ void RenderTarget::applyCurrentView()
     // Go back to model-view mode
     glCheck(glMatrixMode(GL_MODELVIEW));
 
+#endif
+
     m_cache.viewChanged = false;
 }
 
@@ -494,9 +602,18 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
 ////////////////////////////////////////////////////////////
 void RenderTarget::applyTransform(const Transform& transform)
 {
+#ifdef SFML_OPENGL_ES2
+
+    // The model-view matrix is passed to the program at draw time
+    (void)transform;
+
+#else
+
     // No need to call glMatrixMode(GL_MODELVIEW), it is always the
     // current mode (for optimization purpose, since it's the most used)
     glCheck(glLoadMatrixf(transform.getMatrix()));
+
+#endif
 }
 
 
@@ -515,6 +632,239 @@ void RenderTarget::applyShader(const Shader* shader)
     Shader::bind(shader);
 }
 
+
+////////////////////////////////////////////////////////////
+RenderTarget::GLStateScope::GLStateScope(RenderTarget& target) :
+m_target             (target),
+m_active             (false),
+m_matrixMode         (0),
+m_activeTexture      (0),
+m_clientActiveTexture(0),
+m_texture            (0),
+m_program            (0)
+{
+    // Check here to make sure a context change does not happen after activate(true)
+    bool shaderAvailable = Shader::isAvailable();
+
+    m_active = m_target.setActive(true);
+    if (!m_active)
+        return;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    // Texture units: SFML only uses the number 0
+    if (GLEXT_multitexture)
+    {
+        glCheck(glGetIntegerv(GLEXT_GL_ACTIVE_TEXTURE, &m_activeTexture));
+        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    #ifndef SFML_OPENGL_ES2
+        glCheck(glGetIntegerv(GLEXT_GL_CLIENT_ACTIVE_TEXTURE, &m_clientActiveTexture));
+        glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
+    #endif
+    }
+
+    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_texture));
+
+    // Capabilities (texturing is a state of the active texture unit)
+    for (std::size_t i = 0; i < scopedCapabilityCount; ++i)
+        m_capabilities[i] = (glIsEnabled(scopedCapabilities[i]) == GL_TRUE);
+
+    // Blending
+    if (GLEXT_blend_func_separate)
+    {
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_SRC_RGB, &m_blendFunction[0]));
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_DST_RGB, &m_blendFunction[1]));
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_SRC_ALPHA, &m_blendFunction[2]));
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_DST_ALPHA, &m_blendFunction[3]));
+    }
+    else
+    {
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_SRC, &m_blendFunction[0]));
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_DST, &m_blendFunction[1]));
+        m_blendFunction[2] = m_blendFunction[0];
+        m_blendFunction[3] = m_blendFunction[1];
+    }
+
+    m_blendEquation[0] = GLEXT_GL_FUNC_ADD;
+    m_blendEquation[1] = GLEXT_GL_FUNC_ADD;
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    {
+        glCheck(glGetIntegerv(GLEXT_GL_BLEND_EQUATION, &m_blendEquation[0]));
+        m_blendEquation[1] = m_blendEquation[0];
+        if (GLEXT_blend_equation_separate)
+            glCheck(glGetIntegerv(GLEXT_GL_BLEND_EQUATION_ALPHA, &m_blendEquation[1]));
+    }
+
+    // Viewport
+    glCheck(glGetIntegerv(GL_VIEWPORT, m_viewport));
+
+    // Program
+#if !defined(SFML_OPENGL_ES) || defined(SFML_OPENGL_ES2)
+    if (shaderAvailable)
+    {
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+        m_program = castFromGlHandle(program);
+    }
+#else
+    (void)shaderAvailable;
+#endif
+
+#ifdef SFML_OPENGL_ES2
+
+    // Vertex attributes
+    for (GLuint i = 0; i < 3; ++i)
+    {
+        GLint enabled, normalized;
+        GLvoid* pointer;
+        glCheck(glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled));
+        glCheck(glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &m_arrays[i].size));
+        glCheck(glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &m_arrays[i].type));
+        glCheck(glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &normalized));
+        glCheck(glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &m_arrays[i].stride));
+        glCheck(glGetVertexAttribPointerv(i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &pointer));
+        m_arrays[i].enabled = (enabled != GL_FALSE);
+        m_arrays[i].normalized = (normalized != GL_FALSE);
+        m_arrays[i].pointer = pointer;
+    }
+
+#else
+
+    // Matrices
+    glCheck(glGetIntegerv(GL_MATRIX_MODE, &m_matrixMode));
+    glCheck(glMatrixMode(GL_TEXTURE));
+    glCheck(glPushMatrix());
+    glCheck(glMatrixMode(GL_PROJECTION));
+    glCheck(glPushMatrix());
+    glCheck(glMatrixMode(GL_MODELVIEW));
+    glCheck(glPushMatrix());
+
+    // Client-side arrays
+    static const GLenum arrays[3][5] =
+    {
+        {GL_VERTEX_ARRAY,        GL_VERTEX_ARRAY_SIZE,        GL_VERTEX_ARRAY_TYPE,        GL_VERTEX_ARRAY_STRIDE,        GL_VERTEX_ARRAY_POINTER},
+        {GL_COLOR_ARRAY,         GL_COLOR_ARRAY_SIZE,         GL_COLOR_ARRAY_TYPE,         GL_COLOR_ARRAY_STRIDE,         GL_COLOR_ARRAY_POINTER},
+        {GL_TEXTURE_COORD_ARRAY, GL_TEXTURE_COORD_ARRAY_SIZE, GL_TEXTURE_COORD_ARRAY_TYPE, GL_TEXTURE_COORD_ARRAY_STRIDE, GL_TEXTURE_COORD_ARRAY_POINTER}
+    };
+
+    for (int i = 0; i < 3; ++i)
+    {
+        GLvoid* pointer;
+        m_arrays[i].enabled = (glIsEnabled(arrays[i][0]) == GL_TRUE);
+        glCheck(glGetIntegerv(arrays[i][1], &m_arrays[i].size));
+        glCheck(glGetIntegerv(arrays[i][2], &m_arrays[i].type));
+        glCheck(glGetIntegerv(arrays[i][3], &m_arrays[i].stride));
+        glCheck(glGetPointerv(arrays[i][4], &pointer));
+        m_arrays[i].normalized = false;
+        m_arrays[i].pointer = pointer;
+    }
+
+#endif
+
+    // The states of the target are unknown from now on
+    m_target.m_cache.glStatesSet = false;
+}
+
+
+////////////////////////////////////////////////////////////
+RenderTarget::GLStateScope::~GLStateScope()
+{
+    if (!m_active || !m_target.setActive(true))
+        return;
+
+#ifdef SFML_OPENGL_ES2
+
+    // Vertex attributes
+    for (GLuint i = 0; i < 3; ++i)
+    {
+        const ArrayState& array = m_arrays[i];
+        glCheck(glVertexAttribPointer(i, array.size, static_cast<GLenum>(array.type), array.normalized ? GL_TRUE : GL_FALSE, array.stride, array.pointer));
+        if (array.enabled)
+            glCheck(glEnableVertexAttribArray(i));
+        else
+            glCheck(glDisableVertexAttribArray(i));
+    }
+
+#else
+
+    // Client-side arrays
+    glCheck(glVertexPointer(m_arrays[0].size, static_cast<GLenum>(m_arrays[0].type), m_arrays[0].stride, m_arrays[0].pointer));
+    glCheck(glColorPointer(m_arrays[1].size, static_cast<GLenum>(m_arrays[1].type), m_arrays[1].stride, m_arrays[1].pointer));
+    glCheck(glTexCoordPointer(m_arrays[2].size, static_cast<GLenum>(m_arrays[2].type), m_arrays[2].stride, m_arrays[2].pointer));
+
+    const GLenum arrays[3] = {GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY};
+    for (int i = 0; i < 3; ++i)
+    {
+        if (m_arrays[i].enabled)
+            glCheck(glEnableClientState(arrays[i]));
+        else
+            glCheck(glDisableClientState(arrays[i]));
+    }
+
+    // Matrices (texture unit 0 is still the active one)
+    glCheck(glMatrixMode(GL_TEXTURE));
+    glCheck(glPopMatrix());
+    glCheck(glMatrixMode(GL_PROJECTION));
+    glCheck(glPopMatrix());
+    glCheck(glMatrixMode(GL_MODELVIEW));
+    glCheck(glPopMatrix());
+    glCheck(glMatrixMode(static_cast<GLenum>(m_matrixMode)));
+
+#endif
+
+    // Program
+#if !defined(SFML_OPENGL_ES) || defined(SFML_OPENGL_ES2)
+    if (Shader::isAvailable())
+        glCheck(GLEXT_glUseProgramObject(castToGlHandle(m_program)));
+#endif
+
+    // Texture units
+    glCheck(glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(m_texture)));
+
+    // Capabilities, before leaving the texture unit 0
+    for (std::size_t i = 0; i < scopedCapabilityCount; ++i)
+    {
+        if (m_capabilities[i])
+            glCheck(glEnable(scopedCapabilities[i]));
+        else
+            glCheck(glDisable(scopedCapabilities[i]));
+    }
+
+    if (GLEXT_multitexture)
+    {
+    #ifndef SFML_OPENGL_ES2
+        glCheck(GLEXT_glClientActiveTexture(static_cast<GLenum>(m_clientActiveTexture)));
+    #endif
+        glCheck(GLEXT_glActiveTexture(static_cast<GLenum>(m_activeTexture)));
+    }
+
+    // Viewport
+    glCheck(glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]));
+
+    // Blending
+    if (GLEXT_blend_func_separate)
+    {
+        glCheck(GLEXT_glBlendFuncSeparate(static_cast<GLenum>(m_blendFunction[0]), static_cast<GLenum>(m_blendFunction[1]),
+                                          static_cast<GLenum>(m_blendFunction[2]), static_cast<GLenum>(m_blendFunction[3])));
+    }
+    else
+    {
+        glCheck(glBlendFunc(static_cast<GLenum>(m_blendFunction[0]), static_cast<GLenum>(m_blendFunction[1])));
+    }
+
+    if (GLEXT_blend_minmax && GLEXT_blend_subtract)
+    {
+        if (GLEXT_blend_equation_separate)
+            glCheck(GLEXT_glBlendEquationSeparate(static_cast<GLenum>(m_blendEquation[0]), static_cast<GLenum>(m_blendEquation[1])));
+        else
+            glCheck(GLEXT_glBlendEquation(static_cast<GLenum>(m_blendEquation[0])));
+    }
+
+    // The states of the target are unknown again
+    m_target.m_cache.glStatesSet = false;
+}
+
 } // namespace sf
 
 
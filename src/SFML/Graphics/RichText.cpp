@@ -0,0 +1,484 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/RichText.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Add an underline or strikethrough segment to the vertex array, relative to the baseline
+    void addLine(sf::VertexArray& vertices, float left, float right, const sf::Color& color, float offset, float thickness, float outlineThickness = 0)
+    {
+        float top = std::floor(offset - (thickness / 2) + 0.5f);
+        float bottom = top + std::floor(thickness + 0.5f);
+
+        vertices.append(sf::Vertex(sf::Vector2f(left  - outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(right + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(left  - outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(left  - outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(right + outlineThickness, top    - outlineThickness), color, sf::Vector2f(1, 1)));
+        vertices.append(sf::Vertex(sf::Vector2f(right + outlineThickness, bottom + outlineThickness), color, sf::Vector2f(1, 1)));
+    }
+
+    // Add the underline and strike through segments of a run
+    void addRunLines(sf::VertexArray& fill, sf::VertexArray& outline, float left, float right, const sf::RichText::Run& run, float underlineOffset, float strikeThroughOffset, float thickness)
+    {
+        if (run.style & sf::Text::Underlined)
+        {
+            addLine(fill, left, right, run.fillColor, underlineOffset, thickness);
+            if (run.outlineThickness != 0)
+                addLine(outline, left, right, run.outlineColor, underlineOffset, thickness, run.outlineThickness);
+        }
+
+        if (run.style & sf::Text::StrikeThrough)
+        {
+            addLine(fill, left, right, run.fillColor, strikeThroughOffset, thickness);
+            if (run.outlineThickness != 0)
+                addLine(outline, left, right, run.outlineColor, strikeThroughOffset, thickness, run.outlineThickness);
+        }
+    }
+
+    // Add a glyph quad to the vertex array, relative to the baseline
+    void addGlyphQuad(sf::VertexArray& vertices, float x, const sf::Color& color, const sf::Glyph& glyph, float italic, float outlineThickness = 0)
+    {
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+        vertices.append(sf::Vertex(sf::Vector2f(x + left  - italic * top    - outlineThickness, top    - outlineThickness), color, sf::Vector2f(u1, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(x + right - italic * top    - outlineThickness, top    - outlineThickness), color, sf::Vector2f(u2, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(x + left  - italic * bottom - outlineThickness, bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
+        vertices.append(sf::Vertex(sf::Vector2f(x + left  - italic * bottom - outlineThickness, bottom - outlineThickness), color, sf::Vector2f(u1, v2)));
+        vertices.append(sf::Vertex(sf::Vector2f(x + right - italic * top    - outlineThickness, top    - outlineThickness), color, sf::Vector2f(u2, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(x + right - italic * bottom - outlineThickness, bottom - outlineThickness), color, sf::Vector2f(u2, v2)));
+    }
+
+    // Bounding box accumulated while laying out the text
+    struct Extent
+    {
+        Extent() : empty(true), minX(0), minY(0), maxX(0), maxY(0) {}
+
+        void add(float x, float y)
+        {
+            if (empty)
+            {
+                minX = maxX = x;
+                minY = maxY = y;
+                empty = false;
+            }
+            else
+            {
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+        }
+
+        bool  empty;
+        float minX;
+        float minY;
+        float maxX;
+        float maxY;
+    };
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+RichText::Run::Run() :
+string          (),
+characterSize   (30),
+style           (Text::Regular),
+fillColor       (255, 255, 255),
+outlineColor    (0, 0, 0),
+outlineThickness(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RichText::Run::Run(const String& theString, unsigned int theCharacterSize, Uint32 theStyle, const Color& theFillColor) :
+string          (theString),
+characterSize   (theCharacterSize),
+style           (theStyle),
+fillColor       (theFillColor),
+outlineColor    (0, 0, 0),
+outlineThickness(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RichText::Layer::Layer() :
+fill        (Triangles),
+outline     (Triangles),
+fillStart   (0),
+outlineStart(0)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RichText::RichText() :
+m_runs              (),
+m_font              (NULL),
+m_layers            (),
+m_bounds            (),
+m_geometryNeedUpdate(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+RichText::RichText(const Font& font) :
+m_runs              (),
+m_font              (&font),
+m_layers            (),
+m_bounds            (),
+m_geometryNeedUpdate(true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* RichText::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::append(const Run& run)
+{
+    m_runs.push_back(run);
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::append(const String& string, unsigned int characterSize, Uint32 style, const Color& fillColor)
+{
+    append(Run(string, characterSize, style, fillColor));
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::setRun(std::size_t index, const Run& run)
+{
+    m_runs[index] = run;
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const RichText::Run& RichText::getRun(std::size_t index) const
+{
+    return m_runs[index];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RichText::getRunCount() const
+{
+    return m_runs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::clear()
+{
+    m_runs.clear();
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect RichText::getLocalBounds() const
+{
+    ensureGeometryUpdate();
+
+    return m_bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect RichText::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::draw(RenderTarget& target, RenderStates states) const
+{
+    if (m_font)
+    {
+        ensureGeometryUpdate();
+
+        states.transform *= getTransform();
+
+        // Draw all the outlines first, so that they never cover the fill of a neighbouring run
+        for (LayerTable::const_iterator it = m_layers.begin(); it != m_layers.end(); ++it)
+        {
+            if (it->second.outline.getVertexCount() > 0)
+            {
+                states.texture = &m_font->getTexture(it->first);
+                target.draw(it->second.outline, states);
+            }
+        }
+
+        for (LayerTable::const_iterator it = m_layers.begin(); it != m_layers.end(); ++it)
+        {
+            if (it->second.fill.getVertexCount() > 0)
+            {
+                states.texture = &m_font->getTexture(it->first);
+                target.draw(it->second.fill, states);
+            }
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void RichText::ensureGeometryUpdate() const
+{
+    // Do nothing, if geometry has not changed
+    if (!m_geometryNeedUpdate)
+        return;
+
+    // Mark geometry as updated
+    m_geometryNeedUpdate = false;
+
+    // Clear the previous geometry
+    m_layers.clear();
+    m_bounds = FloatRect();
+
+    // No font or text: nothing to draw
+    if (!m_font || m_runs.empty())
+        return;
+
+    // Glyphs are laid out relative to the baseline of their line; once a line
+    // is complete and its height known, its vertices are moved down in place
+    Extent bounds;
+    Extent lineBounds;
+    float  x           = 0.f;
+    float  lineTop     = 0.f;
+    float  lineAscent  = 0.f;
+    float  lineSpacing = 0.f;
+    Uint32 prevChar    = 0;
+    unsigned int prevSize = 0;
+
+    for (std::size_t r = 0; r <= m_runs.size(); ++r)
+    {
+        bool lastRun = (r == m_runs.size());
+
+        // Compute values related to the run style
+        const Run*   run                 = lastRun ? NULL : &m_runs[r];
+        unsigned int size                = lastRun ? 0 : run->characterSize;
+        bool         bold                = !lastRun && (run->style & Text::Bold) != 0;
+        float        italic              = (!lastRun && (run->style & Text::Italic)) ? 0.208f : 0.f; // 12 degrees
+        float        outlineThickness    = lastRun ? 0.f : run->outlineThickness;
+        std::size_t  length              = lastRun ? 1 : run->string.getSize();
+        float        hspace              = 0.f;
+        float        underlineOffset     = 0.f;
+        float        underlineThickness  = 0.f;
+        float        strikeThroughOffset = 0.f;
+        Layer*       layer               = NULL;
+
+        if (!lastRun)
+        {
+            if (run->string.isEmpty())
+                continue;
+
+            layer = &m_layers[size];
+
+            hspace             = static_cast<float>(m_font->getGlyph(L' ', size, bold).advance);
+            underlineOffset    = m_font->getUnderlinePosition(size);
+            underlineThickness = m_font->getUnderlineThickness(size);
+
+            FloatRect xBounds = m_font->getGlyph(L'x', size, bold).bounds;
+            strikeThroughOffset = xBounds.top + xBounds.height / 2.f;
+
+            // Kerning only applies between glyphs of the same page
+            if (size != prevSize)
+                prevChar = 0;
+            prevSize = size;
+
+            // The run contributes to the height of the line it starts on
+            lineAscent  = std::max(lineAscent, static_cast<float>(size));
+            lineSpacing = std::max(lineSpacing, m_font->getLineSpacing(size));
+        }
+
+        float decorationStart = x;
+
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            // The sentinel past the last run closes the last line
+            Uint32 curChar = lastRun ? L'\n' : run->string[i];
+
+            if (!lastRun)
+            {
+                // Apply the kerning offset
+                x += m_font->getKerning(prevChar, curChar, size);
+                prevChar = curChar;
+            }
+
+            if (curChar == L'\n')
+            {
+                // Close the underline and strike through segments of the run on this line
+                if (!lastRun && (x > decorationStart))
+                    addRunLines(layer->fill, layer->outline, decorationStart, x, *run, underlineOffset, strikeThroughOffset, underlineThickness);
+
+                // Move the geometry of the finished line down to its baseline
+                float baseline = lineTop + lineAscent;
+                for (LayerTable::iterator it = m_layers.begin(); it != m_layers.end(); ++it)
+                {
+                    Layer& current = it->second;
+
+                    for (std::size_t j = current.fillStart; j < current.fill.getVertexCount(); ++j)
+                        current.fill[j].position.y += baseline;
+                    for (std::size_t j = current.outlineStart; j < current.outline.getVertexCount(); ++j)
+                        current.outline[j].position.y += baseline;
+
+                    current.fillStart    = current.fill.getVertexCount();
+                    current.outlineStart = current.outline.getVertexCount();
+                }
+
+                if (!lineBounds.empty)
+                {
+                    bounds.add(lineBounds.minX, baseline + lineBounds.minY);
+                    bounds.add(lineBounds.maxX, baseline + lineBounds.maxY);
+                }
+
+                if (lastRun)
+                    break;
+
+                // Start a new line, initially as high as the current run
+                lineTop        += lineSpacing;
+                lineAscent      = static_cast<float>(size);
+                lineSpacing     = m_font->getLineSpacing(size);
+                lineBounds      = Extent();
+                x               = 0.f;
+                decorationStart = 0.f;
+
+                // Text following a trailing line break still counts in the bounds
+                lineBounds.add(x, 0.f);
+
+                continue;
+            }
+
+            // Handle the other special characters
+            if ((curChar == L' ') || (curChar == L'\t'))
+            {
+                lineBounds.add(x, 0.f);
+                x += (curChar == L' ') ? hspace : hspace * 4;
+                lineBounds.add(x, 0.f);
+
+                // Next glyph, no need to create a quad for whitespace
+                continue;
+            }
+
+            // Apply the outline
+            if (outlineThickness != 0)
+            {
+                const Glyph& glyph = m_font->getGlyph(curChar, size, bold, outlineThickness);
+
+                float top    = glyph.bounds.top;
+                float bottom = glyph.bounds.top + glyph.bounds.height;
+
+                // Add the outline glyph to the vertices
+                addGlyphQuad(layer->outline, x, run->outlineColor, glyph, italic, outlineThickness);
+
+                // Update the current bounds with the outlined glyph bounds
+                lineBounds.add(x + glyph.bounds.left - italic * bottom - outlineThickness, top - outlineThickness);
+                lineBounds.add(x + glyph.bounds.left + glyph.bounds.width - italic * top - outlineThickness, bottom - outlineThickness);
+            }
+
+            // Extract the current glyph's description
+            const Glyph& glyph = m_font->getGlyph(curChar, size, bold);
+
+            // Add the glyph to the vertices
+            addGlyphQuad(layer->fill, x, run->fillColor, glyph, italic);
+
+            // Update the current bounds with the non outlined glyph bounds
+            if (outlineThickness == 0)
+            {
+                float top    = glyph.bounds.top;
+                float bottom = glyph.bounds.top + glyph.bounds.height;
+
+                lineBounds.add(x + glyph.bounds.left - italic * bottom, top);
+                lineBounds.add(x + glyph.bounds.left + glyph.bounds.width - italic * top, bottom);
+            }
+
+            // Advance to the next character
+            x += glyph.advance;
+        }
+
+        // Close the underline and strike through segments of the run
+        if (!lastRun && (x > decorationStart))
+            addRunLines(layer->fill, layer->outline, decorationStart, x, *run, underlineOffset, strikeThroughOffset, underlineThickness);
+    }
+
+    // Update the bounding rectangle
+    if (!bounds.empty)
+    {
+        m_bounds.left   = bounds.minX;
+        m_bounds.top    = bounds.minY;
+        m_bounds.width  = bounds.maxX - bounds.minX;
+        m_bounds.height = bounds.maxY - bounds.minY;
+    }
+}
+
+} // namespace sf
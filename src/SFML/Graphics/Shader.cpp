@@ -36,11 +36,16 @@
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <cstring>
 #include <fstream>
 #include <vector>
 
+#ifdef SFML_OPENGL_ES2
+    #include <SFML/Graphics/GLES2Pipeline.hpp>
+#endif
+
 
-#ifndef SFML_OPENGL_ES
+#if !defined(SFML_OPENGL_ES) || defined(SFML_OPENGL_ES2)
 
 #if defined(SFML_SYSTEM_MACOS) || defined(SFML_SYSTEM_IOS)
 
@@ -58,6 +63,58 @@ namespace
 {
     sf::Mutex maxTextureUnitsMutex;
     sf::Mutex isAvailableMutex;
+    sf::Mutex binaryCacheMutex;
+
+    // Directory of the program binary cache, empty if the cache is disabled
+    std::string binaryCacheDirectory;
+
+    // Program binary file format
+    const char       programBinaryMagic[8]  = {'S', 'F', 'P', 'R', 'O', 'G', '\0', '\0'};
+    const sf::Uint32 programBinaryVersion   = 1;
+
+    struct ProgramBinaryHeader
+    {
+        char       magic[8];
+        sf::Uint32 version;
+        sf::Uint32 format;
+        sf::Uint64 key;
+        sf::Uint32 length;
+        sf::Uint32 padding;
+    };
+
+    // Types of the values stored in the uniform block of sf::Shader
+    enum UniformType
+    {
+        UniformFloat1 = 1,
+        UniformFloat2,
+        UniformFloat3,
+        UniformFloat4,
+        UniformMat3,
+        UniformMat4,
+        UniformInt1,
+        UniformInt2,
+        UniformInt3,
+        UniformInt4
+    };
+
+    // Get the number of components of a uniform type
+    std::size_t getComponentCount(int type)
+    {
+        switch (type)
+        {
+            case UniformFloat1: return 1;
+            case UniformFloat2: return 2;
+            case UniformFloat3: return 3;
+            case UniformFloat4: return 4;
+            case UniformMat3:   return 3 * 3;
+            case UniformMat4:   return 4 * 4;
+            case UniformInt1:   return 1;
+            case UniformInt2:   return 2;
+            case UniformInt3:   return 3;
+            case UniformInt4:   return 4;
+            default:            return 0;
+        }
+    }
 
     GLint checkMaxTextureUnits()
     {
@@ -117,6 +174,140 @@ namespace
         return success;
     }
 
+    // Check whether the driver can save and load program binaries
+    bool checkProgramBinarySupport()
+    {
+        if (!GLEXT_get_program_binary)
+            return false;
+
+        // Some drivers expose the extension without supporting any format
+        GLint formatCount = 0;
+        glCheck(glGetIntegerv(GLEXT_GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+
+        return formatCount > 0;
+    }
+
+    // Add a string, including its terminating zero, to a 64-bits FNV-1a hash
+    void hash(sf::Uint64& value, const char* string)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(string ? string : "");
+        do
+        {
+            value ^= *bytes;
+            value *= 1099511628211ULL;
+        }
+        while (*bytes++);
+    }
+
+    // Hash the driver identification, which is the same for all the contexts
+    sf::Uint64 getDriverKey()
+    {
+        sf::Uint64 key = 14695981039346656037ULL;
+        hash(key, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+        hash(key, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+        hash(key, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+        return key;
+    }
+
+    // Get the file of the program binary cache matching a set of sources,
+    // or an empty string if the cache cannot be used
+    std::string getProgramBinaryFilename(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode, sf::Uint64& key)
+    {
+        sf::Lock lock(binaryCacheMutex);
+
+        if (binaryCacheDirectory.empty())
+            return "";
+
+        static bool supported = checkProgramBinarySupport();
+        if (!supported)
+            return "";
+
+        // A binary is only valid for the same sources and the same driver
+        static sf::Uint64 driverKey = getDriverKey();
+        key = driverKey;
+        hash(key, vertexShaderCode);
+        hash(key, geometryShaderCode);
+        hash(key, fragmentShaderCode);
+
+        char name[17];
+        for (int i = 0; i < 16; ++i)
+            name[i] = "0123456789abcdef"[(key >> (60 - 4 * i)) & 0xF];
+        name[16] = '\0';
+
+        return binaryCacheDirectory + "/" + name + ".bin";
+    }
+
+    // Create a program from a cached binary, returns 0 if there is
+    // no usable binary in the cache
+    GLEXT_GLhandle loadProgramBinary(const std::string& filename, sf::Uint64 key)
+    {
+        std::vector<char> buffer;
+        if (!getFileContents(filename, buffer))
+            return 0;
+
+        // getFileContents appends a terminating zero
+        std::size_t size = buffer.size() - 1;
+
+        ProgramBinaryHeader header;
+        if (size < sizeof(header))
+            return 0;
+
+        std::memcpy(&header, &buffer[0], sizeof(header));
+        if ((std::memcmp(header.magic, programBinaryMagic, sizeof(header.magic)) != 0) ||
+            (header.version != programBinaryVersion) || (header.key != key) ||
+            (header.length != size - sizeof(header)))
+            return 0;
+
+        GLEXT_GLhandle program;
+        glCheck(program = GLEXT_glCreateProgramObject());
+        glCheck(GLEXT_glProgramBinary(castFromGlHandle(program), header.format, &buffer[sizeof(header)], header.length));
+
+        // The driver rejects binaries that it can no longer use (e.g. after an update)
+        GLint success;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_OBJECT_LINK_STATUS, &success));
+        if (success == GL_FALSE)
+        {
+            glCheck(GLEXT_glDeleteObject(program));
+            return 0;
+        }
+
+        return program;
+    }
+
+    // Store the binary of a linked program in the cache
+    void saveProgramBinary(const std::string& filename, sf::Uint64 key, GLEXT_GLhandle program)
+    {
+        GLint length = 0;
+        glCheck(GLEXT_glGetObjectParameteriv(program, GLEXT_GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length <= 0)
+            return;
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glCheck(GLEXT_glGetProgramBinary(castFromGlHandle(program), length, &written, &format, &binary[0]));
+        if (written <= 0)
+            return;
+
+        std::ofstream file(filename.c_str(), std::ios_base::binary | std::ios_base::trunc);
+        if (!file)
+        {
+            sf::err() << "Failed to save program binary \"" << filename << "\" (failed to open the file)" << std::endl;
+            return;
+        }
+
+        ProgramBinaryHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, programBinaryMagic, sizeof(header.magic));
+        header.version = programBinaryVersion;
+        header.format  = format;
+        header.key     = key;
+        header.length  = static_cast<sf::Uint32>(written);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(&binary[0], written);
+    }
+
     // Transforms an array of 2D vectors into a contiguous array of scalars
     template <typename T>
     std::vector<T> flatten(const sf::Vector2<T>* vectorArray, std::size_t length)
@@ -176,54 +367,14 @@ namespace sf
 Shader::CurrentTextureType Shader::CurrentTexture;
 
 
-////////////////////////////////////////////////////////////
-struct Shader::UniformBinder : private NonCopyable
-{
-    ////////////////////////////////////////////////////////////
-    /// \brief Constructor: set up state before uniform is set
-    ///
-    ////////////////////////////////////////////////////////////
-    UniformBinder(Shader& shader, const std::string& name) :
-    savedProgram(0),
-    currentProgram(castToGlHandle(shader.m_shaderProgram)),
-    location(-1)
-    {
-        if (currentProgram)
-        {
-            // Enable program object
-            glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
-            if (currentProgram != savedProgram)
-                glCheck(GLEXT_glUseProgramObject(currentProgram));
-
-            // Store uniform location for further use outside constructor
-            location = shader.getUniformLocation(name);
-        }
-    }
-
-    ////////////////////////////////////////////////////////////
-    /// \brief Destructor: restore state after uniform is set
-    ///
-    ////////////////////////////////////////////////////////////
-    ~UniformBinder()
-    {
-        // Disable program object
-        if (currentProgram && (currentProgram != savedProgram))
-            glCheck(GLEXT_glUseProgramObject(savedProgram));
-    }
-
-    TransientContextLock lock;           ///< Lock to keep context active while uniform is bound
-    GLEXT_GLhandle       savedProgram;   ///< Handle to the previously active program object
-    GLEXT_GLhandle       currentProgram; ///< Handle to the program object of the modified sf::Shader instance
-    GLint                location;       ///< Uniform location, used by the surrounding sf::Shader code
-};
-
-
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1),
-m_textures      (),
-m_uniforms      ()
+m_shaderProgram(0),
+m_textures     (),
+m_uniforms     (),
+m_uniformBlock (),
+m_dirtyUniforms(),
+m_programState (NULL)
 {
 }
 
@@ -235,7 +386,13 @@ Shader::~Shader()
 
     // Destroy effect program
     if (m_shaderProgram)
+    {
+    #ifdef SFML_OPENGL_ES2
+        delete m_programState;
+        m_programState = NULL;
+    #endif
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+    }
 }
 
 
@@ -425,175 +582,120 @@ bool Shader::loadFromStream(InputStream& vertexShaderStream, InputStream& geomet
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, float x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1f(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2f(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3f(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Vec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4f(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, int x)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1i(binder.location, x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec2& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2i(binder.location, v.x, v.y));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec3& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3i(binder.location, v.x, v.y, v.z));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Ivec4& v)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4i(binder.location, v.x, v.y, v.z, v.w));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, bool x)
 {
-    setUniform(name, static_cast<int>(x));
+    setUniform(getUniformHandle(name), x);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec2& v)
 {
-    setUniform(name, Glsl::Ivec2(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec3& v)
 {
-    setUniform(name, Glsl::Ivec3(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Bvec4& v)
 {
-    setUniform(name, Glsl::Ivec4(v));
+    setUniform(getUniformHandle(name), v);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat3& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Glsl::Mat4& matrix)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, 1, GL_FALSE, matrix.array));
+    setUniform(getUniformHandle(name), matrix);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, const Texture& texture)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
-
-        // Find the location of the variable in the shader
-        int location = getUniformLocation(name);
-        if (location != -1)
-        {
-            // Store the location -> texture mapping
-            TextureTable::iterator it = m_textures.find(location);
-            if (it == m_textures.end())
-            {
-                // New entry, make sure there are enough texture units
-                GLint maxUnits = getMaxTextureUnits();
-                if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
-                {
-                    err() << "Impossible to use texture \"" << name << "\" for shader: all available texture units are used" << std::endl;
-                    return;
-                }
-
-                m_textures[location] = &texture;
-            }
-            else
-            {
-                // Location already used, just replace the texture
-                it->second = &texture;
-            }
-        }
-    }
+    setUniform(getUniformHandle(name), texture);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniform(const std::string& name, CurrentTextureType)
 {
-    if (m_shaderProgram)
-    {
-        TransientContextLock lock;
-
-        // Find the location of the variable in the shader
-        m_currentTexture = getUniformLocation(name);
-    }
+    setUniform(getUniformHandle(name), CurrentTexture);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Shader::setUniformArray(const std::string& name, const float* scalarArray, std::size_t length)
 {
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform1fv(binder.location, length, scalarArray));
+    std::vector<float> contiguous(scalarArray, scalarArray + length);
+    storeUniformArray(getUniformHandle(name), UniformFloat1, contiguous);
 }
 
 
@@ -601,10 +703,7 @@ void Shader::setUniformArray(const std::string& name, const float* scalarArray,
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform2fv(binder.location, length, &contiguous[0]));
+    storeUniformArray(getUniformHandle(name), UniformFloat2, contiguous);
 }
 
 
@@ -612,10 +711,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec2* vectorAr
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform3fv(binder.location, length, &contiguous[0]));
+    storeUniformArray(getUniformHandle(name), UniformFloat3, contiguous);
 }
 
 
@@ -623,10 +719,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Vec3* vectorAr
 void Shader::setUniformArray(const std::string& name, const Glsl::Vec4* vectorArray, std::size_t length)
 {
     std::vector<float> contiguous = flatten(vectorArray, length);
-
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniform4fv(binder.location, length, &contiguous[0]));
+    storeUniformArray(getUniformHandle(name), UniformFloat4, contiguous);
 }
 
 
@@ -639,9 +732,7 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat3* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix3fv(binder.location, length, GL_FALSE, &contiguous[0]));
+    storeUniformArray(getUniformHandle(name), UniformMat3, contiguous);
 }
 
 
@@ -654,9 +745,198 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
     for (std::size_t i = 0; i < length; ++i)
         priv::copyMatrix(matrixArray[i].array, matrixSize, &contiguous[matrixSize * i]);
 
-    UniformBinder binder(*this, name);
-    if (binder.location != -1)
-        glCheck(GLEXT_glUniformMatrix4fv(binder.location, length, GL_FALSE, &contiguous[0]));
+    storeUniformArray(getUniformHandle(name), UniformMat4, contiguous);
+}
+
+
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    if (!m_shaderProgram)
+        return -1;
+
+    // Check the cache
+    UniformTable::const_iterator it = m_uniforms.find(name);
+    if (it != m_uniforms.end())
+        return it->second;
+
+    // Not in cache, request the location from OpenGL
+    TransientContextLock lock;
+
+    int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
+    if (location == -1)
+    {
+        err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+        m_uniforms.insert(std::make_pair(name, -1));
+        return -1;
+    }
+
+    // Several names can refer to the same variable (e.g. "array" and "array[0]")
+    for (std::size_t i = 0; i < m_uniformBlock.size(); ++i)
+    {
+        if (m_uniformBlock[i].location == location)
+        {
+            m_uniforms.insert(std::make_pair(name, static_cast<UniformHandle>(i)));
+            return static_cast<UniformHandle>(i);
+        }
+    }
+
+    Uniform uniform;
+    uniform.location = location;
+    uniform.type = 0;
+    uniform.texture = -1;
+    uniform.dirty = false;
+
+    UniformHandle handle = static_cast<UniformHandle>(m_uniformBlock.size());
+    m_uniformBlock.push_back(uniform);
+    m_uniforms.insert(std::make_pair(name, handle));
+
+    return handle;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+    storeUniform(handle, UniformFloat1, &x, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+    const float floats[] = {v.x, v.y};
+    storeUniform(handle, UniformFloat2, floats, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+    const float floats[] = {v.x, v.y, v.z};
+    storeUniform(handle, UniformFloat3, floats, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+    const float floats[] = {v.x, v.y, v.z, v.w};
+    storeUniform(handle, UniformFloat4, floats, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+    storeUniform(handle, UniformInt1, NULL, &x);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+    const int ints[] = {v.x, v.y};
+    storeUniform(handle, UniformInt2, NULL, ints);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+    const int ints[] = {v.x, v.y, v.z};
+    storeUniform(handle, UniformInt3, NULL, ints);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+    const int ints[] = {v.x, v.y, v.z, v.w};
+    storeUniform(handle, UniformInt4, NULL, ints);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+    setUniform(handle, static_cast<int>(x));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+    setUniform(handle, Glsl::Ivec2(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+    setUniform(handle, Glsl::Ivec3(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+    setUniform(handle, Glsl::Ivec4(v));
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+    storeUniform(handle, UniformMat3, matrix.array, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+    storeUniform(handle, UniformMat4, matrix.array, NULL);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+    if ((handle < 0) || (static_cast<std::size_t>(handle) >= m_uniformBlock.size()))
+        return;
+
+    Uniform& uniform = m_uniformBlock[handle];
+    if (uniform.texture != -1)
+    {
+        // Variable already used, just replace the texture
+        m_textures[uniform.texture].second = &texture;
+        return;
+    }
+
+    // New entry, make sure there are enough texture units
+    {
+        TransientContextLock lock;
+
+        GLint maxUnits = getMaxTextureUnits();
+        if (m_textures.size() + 1 >= static_cast<std::size_t>(maxUnits))
+        {
+            err() << "Impossible to use texture for shader: all available texture units are used" << std::endl;
+            return;
+        }
+    }
+
+    // The variable is given the unit of the texture, the unit 0 is reserved for the current texture
+    uniform.texture = static_cast<int>(m_textures.size());
+    m_textures.push_back(std::make_pair(uniform.location, &texture));
+    setUniform(handle, uniform.texture + 1);
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+    // The current texture is always bound to the unit 0
+    setUniform(handle, 0);
 }
 
 
@@ -755,12 +1035,11 @@ void Shader::bind(const Shader* shader)
         // Enable the program
         glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
 
+        // Upload the uniforms which changed since the last bind
+        shader->uploadUniforms();
+
         // Bind the textures
         shader->bindTextures();
-
-        // Bind the current texture
-        if (shader->m_currentTexture != -1)
-            glCheck(GLEXT_glUniform1i(shader->m_currentTexture, 0));
     }
     else
     {
@@ -822,6 +1101,15 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+    Lock lock(binaryCacheMutex);
+
+    binaryCacheDirectory = directory;
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
@@ -846,14 +1134,42 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     // Destroy the shader if it was already created
     if (m_shaderProgram)
     {
+    #ifdef SFML_OPENGL_ES2
+        delete m_programState;
+        m_programState = NULL;
+    #endif
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
         m_shaderProgram = 0;
     }
 
+#ifdef SFML_OPENGL_ES2
+    // OpenGL ES 2 programs need both stages: complete the missing one
+    // with the stage of the default program
+    if (!vertexShaderCode)
+        vertexShaderCode = priv::getDefaultVertexShader();
+    if (!fragmentShaderCode)
+        fragmentShaderCode = priv::getDefaultFragmentShader();
+#endif
+
     // Reset the internal state
-    m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_uniformBlock.clear();
+    m_dirtyUniforms.clear();
+
+    // Use the binary of a previous link if the cache has one
+    Uint64 binaryKey = 0;
+    std::string binaryFilename = getProgramBinaryFilename(vertexShaderCode, geometryShaderCode, fragmentShaderCode, binaryKey);
+    if (!binaryFilename.empty())
+    {
+        GLEXT_GLhandle cachedProgram = loadProgramBinary(binaryFilename, binaryKey);
+        if (cachedProgram)
+        {
+            m_shaderProgram = castFromGlHandle(cachedProgram);
+            glCheck(glFlush());
+            return true;
+        }
+    }
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
@@ -942,6 +1258,17 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
         glCheck(GLEXT_glDeleteObject(fragmentShader));
     }
 
+#ifdef SFML_OPENGL_ES2
+    // Give the vertex attributes the locations used by sf::RenderTarget
+    priv::bindVertexAttributes(shaderProgram);
+#endif
+
+#ifdef GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    // Tell the driver that the binary will be retrieved
+    if (!binaryFilename.empty())
+        glCheck(GLEXT_glProgramParameteri(castFromGlHandle(shaderProgram), GLEXT_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+#endif
+
     // Link the program
     glCheck(GLEXT_glLinkProgram(shaderProgram));
 
@@ -960,6 +1287,10 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 
     m_shaderProgram = castFromGlHandle(shaderProgram);
 
+    // Store the binary so that the next launches don't have to compile the sources
+    if (!binaryFilename.empty())
+        saveProgramBinary(binaryFilename, binaryKey, shaderProgram);
+
     // Force an OpenGL flush, so that the shader will appear updated
     // in all contexts immediately (solves problems in multi-threaded apps)
     glCheck(glFlush());
@@ -971,14 +1302,12 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
 ////////////////////////////////////////////////////////////
 void Shader::bindTextures() const
 {
-    TextureTable::const_iterator it = m_textures.begin();
+    // The sampler variables already hold their unit (see setUniform)
     for (std::size_t i = 0; i < m_textures.size(); ++i)
     {
         GLint index = static_cast<GLsizei>(i + 1);
-        glCheck(GLEXT_glUniform1i(it->first, index));
         glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + index));
-        Texture::bind(it->second);
-        ++it;
+        Texture::bind(m_textures[i].second);
     }
 
     // Make sure that the texture unit which is left active is the number 0
@@ -987,31 +1316,124 @@ void Shader::bindTextures() const
 
 
 ////////////////////////////////////////////////////////////
-int Shader::getUniformLocation(const std::string& name)
+void Shader::uploadUniforms() const
 {
-    // Check the cache
-    UniformTable::const_iterator it = m_uniforms.find(name);
-    if (it != m_uniforms.end())
+    for (std::size_t i = 0; i < m_dirtyUniforms.size(); ++i)
     {
-        // Already in cache, return it
-        return it->second;
+        Uniform& uniform = m_uniformBlock[m_dirtyUniforms[i]];
+        const float* f = uniform.value.floats;
+        const int* n = uniform.value.ints;
+
+        if (!uniform.array.empty())
+        {
+            // Arrays of values (see setUniformArray)
+            const float* a = &uniform.array[0];
+            GLsizei length = static_cast<GLsizei>(uniform.array.size() / getComponentCount(uniform.type));
+            switch (uniform.type)
+            {
+                case UniformFloat1: glCheck(GLEXT_glUniform1fv(uniform.location, length, a));                            break;
+                case UniformFloat2: glCheck(GLEXT_glUniform2fv(uniform.location, length, a));                            break;
+                case UniformFloat3: glCheck(GLEXT_glUniform3fv(uniform.location, length, a));                            break;
+                case UniformFloat4: glCheck(GLEXT_glUniform4fv(uniform.location, length, a));                            break;
+                case UniformMat3:   glCheck(GLEXT_glUniformMatrix3fv(uniform.location, length, GL_FALSE, a));            break;
+                case UniformMat4:   glCheck(GLEXT_glUniformMatrix4fv(uniform.location, length, GL_FALSE, a));            break;
+                default:                                                                                                 break;
+            }
+        }
+        else
+        {
+            switch (uniform.type)
+            {
+                case UniformFloat1: glCheck(GLEXT_glUniform1f(uniform.location, f[0]));                                  break;
+                case UniformFloat2: glCheck(GLEXT_glUniform2f(uniform.location, f[0], f[1]));                            break;
+                case UniformFloat3: glCheck(GLEXT_glUniform3f(uniform.location, f[0], f[1], f[2]));                      break;
+                case UniformFloat4: glCheck(GLEXT_glUniform4f(uniform.location, f[0], f[1], f[2], f[3]));                break;
+                case UniformMat3:   glCheck(GLEXT_glUniformMatrix3fv(uniform.location, 1, GL_FALSE, f));                 break;
+                case UniformMat4:   glCheck(GLEXT_glUniformMatrix4fv(uniform.location, 1, GL_FALSE, f));                 break;
+                case UniformInt1:   glCheck(GLEXT_glUniform1i(uniform.location, n[0]));                                  break;
+                case UniformInt2:   glCheck(GLEXT_glUniform2i(uniform.location, n[0], n[1]));                            break;
+                case UniformInt3:   glCheck(GLEXT_glUniform3i(uniform.location, n[0], n[1], n[2]));                      break;
+                case UniformInt4:   glCheck(GLEXT_glUniform4i(uniform.location, n[0], n[1], n[2], n[3]));                break;
+                default:                                                                                                 break;
+            }
+        }
+
+        uniform.dirty = false;
+    }
+
+    m_dirtyUniforms.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::storeUniform(UniformHandle handle, int type, const float* floats, const int* ints)
+{
+    if ((handle < 0) || (static_cast<std::size_t>(handle) >= m_uniformBlock.size()))
+        return;
+
+    Uniform& uniform = m_uniformBlock[handle];
+    std::size_t count = getComponentCount(type);
+
+    // Nothing to do if the variable already has this value
+    bool sameType = (uniform.type == type) && uniform.array.empty();
+    if (floats)
+    {
+        if (sameType && (std::memcmp(uniform.value.floats, floats, count * sizeof(float)) == 0))
+            return;
+        std::memcpy(uniform.value.floats, floats, count * sizeof(float));
     }
     else
     {
-        // Not in cache, request the location from OpenGL
-        int location = GLEXT_glGetUniformLocation(castToGlHandle(m_shaderProgram), name.c_str());
-        m_uniforms.insert(std::make_pair(name, location));
+        if (sameType && (std::memcmp(uniform.value.ints, ints, count * sizeof(int)) == 0))
+            return;
+        std::memcpy(uniform.value.ints, ints, count * sizeof(int));
+    }
+
+    uniform.type = type;
+    uniform.array.clear();
+
+    if (!uniform.dirty)
+    {
+        uniform.dirty = true;
+        m_dirtyUniforms.push_back(handle);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::storeUniformArray(UniformHandle handle, int type, std::vector<float>& values)
+{
+    if ((handle < 0) || (static_cast<std::size_t>(handle) >= m_uniformBlock.size()) || values.empty())
+        return;
 
-        if (location == -1)
-            err() << "Uniform \"" << name << "\" not found in shader" << std::endl;
+    Uniform& uniform = m_uniformBlock[handle];
 
-        return location;
+    // Nothing to do if the variable already has these values
+    if ((uniform.type == type) && (uniform.array == values))
+        return;
+
+    uniform.type = type;
+    uniform.array.swap(values);
+
+    if (!uniform.dirty)
+    {
+        uniform.dirty = true;
+        m_dirtyUniforms.push_back(handle);
     }
 }
 
+
+////////////////////////////////////////////////////////////
+int Shader::getUniformLocation(const std::string& name)
+{
+    UniformHandle handle = getUniformHandle(name);
+
+    return (handle != -1) ? m_uniformBlock[handle].location : -1;
+}
+
 } // namespace sf
 
-#else // SFML_OPENGL_ES
+#else // SFML_OPENGL_ES && !SFML_OPENGL_ES2
 
 // OpenGL ES 1 doesn't support GLSL shaders at all, we have to provide an empty implementation
 
@@ -1023,8 +1445,8 @@ Shader::CurrentTextureType Shader::CurrentTexture;
 
 ////////////////////////////////////////////////////////////
 Shader::Shader() :
-m_shaderProgram (0),
-m_currentTexture(-1)
+m_shaderProgram(0),
+m_programState (NULL)
 {
 }
 
@@ -1230,6 +1652,109 @@ void Shader::setUniformArray(const std::string& name, const Glsl::Mat4* matrixAr
 }
 
 
+////////////////////////////////////////////////////////////
+Shader::UniformHandle Shader::getUniformHandle(const std::string& name)
+{
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, float x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Vec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, int x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Ivec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, bool x)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec2& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec3& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Bvec4& v)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat3& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Glsl::Mat4& matrix)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, const Texture& texture)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void Shader::setUniform(UniformHandle handle, CurrentTextureType)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::setParameter(const std::string& name, float x)
 {
@@ -1317,6 +1842,12 @@ bool Shader::isGeometryAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void Shader::setBinaryCacheDirectory(const std::string& directory)
+{
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCode, const char* fragmentShaderCode)
 {
@@ -1331,4 +1862,4 @@ void Shader::bindTextures() const
 
 } // namespace sf
 
-#endif // SFML_OPENGL_ES
+#endif // !SFML_OPENGL_ES || SFML_OPENGL_ES2
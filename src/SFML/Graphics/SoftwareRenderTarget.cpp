@@ -0,0 +1,925 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/ImageStorage.hpp>
+#include <SFML/Graphics/PixelKernels.hpp>
+#include <SFML/System/Thread.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    // Positions are snapped to 1/256 of pixel, and texture coordinates to 1/256 of texel
+    const int       SubpixelBits  = 8;
+    const sf::Int64 SubpixelScale = 1 << SubpixelBits;
+    const sf::Int64 SubpixelHalf  = SubpixelScale / 2;
+
+    // Interpolated values have 32 fractional bits
+    const int       FractionBits = 32;
+    const sf::Int64 FractionOne  = sf::Int64(1) << FractionBits;
+    const sf::Int64 FractionHalf = FractionOne / 2;
+
+    // Triangles going further than this distance (in pixels) outside the target
+    // are clipped, so that the fixed-point edge functions can't overflow
+    const float GuardBand = 16384.f;
+
+    // Biggest target, and biggest texture coordinate (in texels) accepted
+    const unsigned int MaximumSize     = 16384;
+    const float        MaximumTexCoord = 1048576.f;
+
+    // Minimum number of pixels covered by a draw call to split it across threads
+    const sf::Int64 MinimumThreadedArea = 128 * 128;
+
+    // Memory used by the copies of the textures before the least recently used are dropped
+    const std::size_t TextureCacheBudget = 64 * 1024 * 1024;
+
+    // Vertex with a floating point position in pixels, before snapping
+    struct ClipVertex
+    {
+        float x, y;
+        float r, g, b, a;
+        float u, v;
+    };
+
+    // Vertex ready for rasterization
+    struct RasterVertex
+    {
+        sf::Int64 x, y;       // Position, in subpixels
+        sf::Int64 r, g, b, a; // Color components, from 0 to 255
+        sf::Int64 u, v;       // Texture coordinates, in subpixels of texels
+    };
+
+    // Edge function of a triangle: E(x, y) = a * x + b * y + c, positive inside
+    struct Edge
+    {
+        sf::Int64 a, b, c;
+        sf::Int64 bias; // 0 if pixels centered exactly on the edge are inside, -1 otherwise
+    };
+
+    struct Triangle
+    {
+        RasterVertex vertices[3]; // In an order which makes the area positive
+        Edge         edges[3];    // Edge i is opposite to vertex i, its function is the weight of vertex i
+        sf::Int64    area;        // Twice the area of the triangle, sum of the 3 weights
+        int          top;         // First row whose centers may be covered
+        int          bottom;      // Last row whose centers may be covered
+        bool         flat;        // Solid color, without texture
+    };
+
+    struct Line
+    {
+        RasterVertex vertices[2];
+    };
+
+    // Everything needed to rasterize a draw call
+    struct DrawCall
+    {
+        sf::Uint8*                pixels;
+        unsigned int              width;
+        int                       clipLeft, clipTop, clipRight, clipBottom; // Inclusive
+        const sf::Uint8*          texture; // RGBA8 texels, or NULL
+        int                       textureWidth;
+        int                       textureHeight;
+        bool                      smooth;
+        bool                      repeated;
+        sf::BlendMode             blendMode;
+        std::vector<Triangle>     triangles;
+        std::vector<Line>         lines;
+        std::vector<RasterVertex> points;
+    };
+
+    // Band of rows rasterized by one thread
+    struct Band
+    {
+        const DrawCall* drawCall;
+        int             firstRow;
+        int             lastRow; // Inclusive
+    };
+
+    // Integer division rounded toward negative infinity
+    sf::Int64 floorDiv(sf::Int64 numerator, sf::Int64 denominator)
+    {
+        sf::Int64 quotient = numerator / denominator;
+        if ((numerator % denominator != 0) && ((numerator < 0) != (denominator < 0)))
+            --quotient;
+
+        return quotient;
+    }
+
+    // Integer division rounded toward positive infinity
+    sf::Int64 ceilDiv(sf::Int64 numerator, sf::Int64 denominator)
+    {
+        return -floorDiv(-numerator, denominator);
+    }
+
+    // numerator / denominator with 32 fractional bits; the operands are exact in a
+    // double and the division is correctly rounded, so the result is reproducible
+    sf::Int64 toFraction(sf::Int64 numerator, sf::Int64 denominator)
+    {
+        double quotient = static_cast<double>(numerator) * static_cast<double>(FractionOne) / static_cast<double>(denominator);
+        return static_cast<sf::Int64>(std::floor(quotient + 0.5));
+    }
+
+    sf::Int64 snap(float value, float scale)
+    {
+        return static_cast<sf::Int64>(std::floor(static_cast<double>(value) * scale + 0.5));
+    }
+
+    sf::Uint8 clampComponent(sf::Int64 value)
+    {
+        return static_cast<sf::Uint8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+
+    // round(a * b / 255), exact for a and b in [0, 255]
+    int multiply(int a, int b)
+    {
+        int product = a * b + 128;
+        return (product + (product >> 8)) >> 8;
+    }
+
+    RasterVertex snapVertex(const ClipVertex& vertex)
+    {
+        RasterVertex result;
+        result.x = snap(vertex.x, static_cast<float>(SubpixelScale));
+        result.y = snap(vertex.y, static_cast<float>(SubpixelScale));
+        result.r = snap(vertex.r, 1.f);
+        result.g = snap(vertex.g, 1.f);
+        result.b = snap(vertex.b, 1.f);
+        result.a = snap(vertex.a, 1.f);
+        result.u = snap(std::max(-MaximumTexCoord, std::min(vertex.u, MaximumTexCoord)), static_cast<float>(SubpixelScale));
+        result.v = snap(std::max(-MaximumTexCoord, std::min(vertex.v, MaximumTexCoord)), static_cast<float>(SubpixelScale));
+        return result;
+    }
+
+    ClipVertex lerp(const ClipVertex& from, const ClipVertex& to, float t)
+    {
+        ClipVertex result;
+        result.x = from.x + (to.x - from.x) * t;
+        result.y = from.y + (to.y - from.y) * t;
+        result.r = from.r + (to.r - from.r) * t;
+        result.g = from.g + (to.g - from.g) * t;
+        result.b = from.b + (to.b - from.b) * t;
+        result.a = from.a + (to.a - from.a) * t;
+        result.u = from.u + (to.u - from.u) * t;
+        result.v = from.v + (to.v - from.v) * t;
+        return result;
+    }
+
+    // Clip a polygon against the half-plane sign * (coordinate - limit) <= 0
+    std::size_t clipPolygon(const ClipVertex* input, std::size_t count, ClipVertex* output, bool vertical, float limit, float sign)
+    {
+        std::size_t outputCount = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const ClipVertex& current = input[i];
+            const ClipVertex& next = input[(i + 1) % count];
+            float currentDistance = sign * ((vertical ? current.y : current.x) - limit);
+            float nextDistance = sign * ((vertical ? next.y : next.x) - limit);
+
+            if (currentDistance <= 0)
+                output[outputCount++] = current;
+
+            if ((currentDistance <= 0) != (nextDistance <= 0))
+                output[outputCount++] = lerp(current, next, currentDistance / (currentDistance - nextDistance));
+        }
+
+        return outputCount;
+    }
+
+    Edge makeEdge(const RasterVertex& from, const RasterVertex& to)
+    {
+        sf::Int64 dx = to.x - from.x;
+        sf::Int64 dy = to.y - from.y;
+
+        // Top-left rule: centers exactly on a left or top edge belong to the triangle,
+        // so that pixels on an edge shared by two triangles are drawn once
+        Edge edge;
+        edge.a = -dy;
+        edge.b = dx;
+        edge.c = dy * from.x - dx * from.y;
+        edge.bias = ((dy < 0) || ((dy == 0) && (dx < 0))) ? 0 : -1;
+        return edge;
+    }
+
+    void addTriangle(DrawCall& drawCall, const RasterVertex& v0, const RasterVertex& v1, const RasterVertex& v2)
+    {
+        Triangle triangle;
+        triangle.area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+
+        // Degenerate triangles cover nothing
+        if (triangle.area == 0)
+            return;
+
+        // Rasterize all the triangles with the same winding
+        triangle.vertices[0] = v0;
+        triangle.vertices[1] = triangle.area > 0 ? v1 : v2;
+        triangle.vertices[2] = triangle.area > 0 ? v2 : v1;
+        triangle.area = triangle.area > 0 ? triangle.area : -triangle.area;
+
+        const RasterVertex* v = triangle.vertices;
+        triangle.edges[0] = makeEdge(v[1], v[2]);
+        triangle.edges[1] = makeEdge(v[2], v[0]);
+        triangle.edges[2] = makeEdge(v[0], v[1]);
+
+        sf::Int64 top = std::min(v[0].y, std::min(v[1].y, v[2].y));
+        sf::Int64 bottom = std::max(v[0].y, std::max(v[1].y, v[2].y));
+        triangle.top = static_cast<int>(std::max<sf::Int64>(ceilDiv(top - SubpixelHalf, SubpixelScale), drawCall.clipTop));
+        triangle.bottom = static_cast<int>(std::min<sf::Int64>(floorDiv(bottom - SubpixelHalf, SubpixelScale), drawCall.clipBottom));
+
+        if (triangle.top > triangle.bottom)
+            return;
+
+        triangle.flat = !drawCall.texture &&
+                        (v[0].r == v[1].r) && (v[0].g == v[1].g) && (v[0].b == v[1].b) && (v[0].a == v[1].a) &&
+                        (v[0].r == v[2].r) && (v[0].g == v[2].g) && (v[0].b == v[2].b) && (v[0].a == v[2].a);
+
+        drawCall.triangles.push_back(triangle);
+    }
+
+    void addTriangle(DrawCall& drawCall, const ClipVertex& v0, const ClipVertex& v1, const ClipVertex& v2)
+    {
+        float left   = drawCall.clipLeft - GuardBand;
+        float top    = drawCall.clipTop - GuardBand;
+        float right  = drawCall.clipRight + GuardBand;
+        float bottom = drawCall.clipBottom + GuardBand;
+
+        // Most triangles are in the guard band and don't need any clipping
+        if ((std::min(v0.x, std::min(v1.x, v2.x)) >= left) && (std::max(v0.x, std::max(v1.x, v2.x)) <= right) &&
+            (std::min(v0.y, std::min(v1.y, v2.y)) >= top) && (std::max(v0.y, std::max(v1.y, v2.y)) <= bottom))
+        {
+            addTriangle(drawCall, snapVertex(v0), snapVertex(v1), snapVertex(v2));
+            return;
+        }
+
+        // Each clip plane adds at most one vertex
+        ClipVertex polygon[7] = {v0, v1, v2};
+        ClipVertex clipped[7];
+        std::size_t count = 3;
+        count = clipPolygon(polygon, count, clipped, false, left, -1.f);
+        count = clipPolygon(clipped, count, polygon, false, right, 1.f);
+        count = clipPolygon(polygon, count, clipped, true, top, -1.f);
+        count = clipPolygon(clipped, count, polygon, true, bottom, 1.f);
+
+        for (std::size_t i = 2; i < count; ++i)
+            addTriangle(drawCall, snapVertex(polygon[0]), snapVertex(polygon[i - 1]), snapVertex(polygon[i]));
+    }
+
+    void addLine(DrawCall& drawCall, const ClipVertex& v0, const ClipVertex& v1)
+    {
+        // Lines are short enough in practice, skip the ones which would need clipping
+        float left   = drawCall.clipLeft - GuardBand;
+        float top    = drawCall.clipTop - GuardBand;
+        float right  = drawCall.clipRight + GuardBand;
+        float bottom = drawCall.clipBottom + GuardBand;
+        if ((std::min(v0.x, v1.x) < left) || (std::max(v0.x, v1.x) > right) ||
+            (std::min(v0.y, v1.y) < top) || (std::max(v0.y, v1.y) > bottom))
+            return;
+
+        Line line;
+        line.vertices[0] = snapVertex(v0);
+        line.vertices[1] = snapVertex(v1);
+        drawCall.lines.push_back(line);
+    }
+
+    // Wrap or clamp a texel coordinate (which is small enough to fit in an int)
+    int wrap(sf::Int64 coordinate, int size, bool repeated)
+    {
+        int value = static_cast<int>(coordinate);
+
+        if (!repeated)
+            return value < 0 ? 0 : (value >= size ? size - 1 : value);
+
+        // Texture sizes are usually powers of two, which don't need a division
+        if ((size & (size - 1)) == 0)
+            return value & (size - 1);
+
+        value %= size;
+        return value < 0 ? value + size : value;
+    }
+
+    // Fetch a texel, wrapping or clamping its coordinates
+    const sf::Uint8* fetch(const DrawCall& drawCall, sf::Int64 x, sf::Int64 y)
+    {
+        x = wrap(x, drawCall.textureWidth, drawCall.repeated);
+        y = wrap(y, drawCall.textureHeight, drawCall.repeated);
+
+        return drawCall.texture + (y * drawCall.textureWidth + x) * 4;
+    }
+
+    // Compute the color of a pixel from its interpolated attributes
+    void shade(const DrawCall& drawCall, int r, int g, int b, int a, sf::Int64 u, sf::Int64 v, sf::Uint8* pixel)
+    {
+        if (!drawCall.texture)
+        {
+            pixel[0] = static_cast<sf::Uint8>(r);
+            pixel[1] = static_cast<sf::Uint8>(g);
+            pixel[2] = static_cast<sf::Uint8>(b);
+            pixel[3] = static_cast<sf::Uint8>(a);
+            return;
+        }
+
+        int texel[4];
+        if (drawCall.smooth)
+        {
+            // Bilinear filtering, between the 4 texels whose centers surround the point
+            sf::Int64 x = u - SubpixelHalf;
+            sf::Int64 y = v - SubpixelHalf;
+            int fx = static_cast<int>(x & (SubpixelScale - 1));
+            int fy = static_cast<int>(y & (SubpixelScale - 1));
+            x >>= SubpixelBits;
+            y >>= SubpixelBits;
+
+            const sf::Uint8* t00 = fetch(drawCall, x, y);
+            const sf::Uint8* t10 = fetch(drawCall, x + 1, y);
+            const sf::Uint8* t01 = fetch(drawCall, x, y + 1);
+            const sf::Uint8* t11 = fetch(drawCall, x + 1, y + 1);
+            for (int i = 0; i < 4; ++i)
+            {
+                int upper = t00[i] * (256 - fx) + t10[i] * fx;
+                int lower = t01[i] * (256 - fx) + t11[i] * fx;
+                texel[i] = (upper * (256 - fy) + lower * fy + 32768) >> 16;
+            }
+        }
+        else
+        {
+            const sf::Uint8* t = fetch(drawCall, u >> SubpixelBits, v >> SubpixelBits);
+            for (int i = 0; i < 4; ++i)
+                texel[i] = t[i];
+        }
+
+        // The texture is modulated by the vertex color
+        pixel[0] = static_cast<sf::Uint8>(multiply(texel[0], r));
+        pixel[1] = static_cast<sf::Uint8>(multiply(texel[1], g));
+        pixel[2] = static_cast<sf::Uint8>(multiply(texel[2], b));
+        pixel[3] = static_cast<sf::Uint8>(multiply(texel[3], a));
+    }
+
+    // Value of a blending factor, from 0 to 255
+    int blendFactor(sf::BlendMode::Factor factor, const sf::Uint8* source, const sf::Uint8* destination, int component)
+    {
+        switch (factor)
+        {
+            case sf::BlendMode::Zero:             return 0;
+            case sf::BlendMode::One:              return 255;
+            case sf::BlendMode::SrcColor:         return source[component];
+            case sf::BlendMode::OneMinusSrcColor: return 255 - source[component];
+            case sf::BlendMode::DstColor:         return destination[component];
+            case sf::BlendMode::OneMinusDstColor: return 255 - destination[component];
+            case sf::BlendMode::SrcAlpha:         return source[3];
+            case sf::BlendMode::OneMinusSrcAlpha: return 255 - source[3];
+            case sf::BlendMode::DstAlpha:         return destination[3];
+            case sf::BlendMode::OneMinusDstAlpha: return 255 - destination[3];
+        }
+
+        return 0;
+    }
+
+    int blendComponent(const sf::BlendMode& mode, const sf::Uint8* source, const sf::Uint8* destination, int component)
+    {
+        bool alpha = (component == 3);
+        sf::BlendMode::Factor sourceFactor = alpha ? mode.alphaSrcFactor : mode.colorSrcFactor;
+        sf::BlendMode::Factor destinationFactor = alpha ? mode.alphaDstFactor : mode.colorDstFactor;
+        sf::BlendMode::Equation equation = alpha ? mode.alphaEquation : mode.colorEquation;
+
+        int s = source[component] * blendFactor(sourceFactor, source, destination, component);
+        int d = destination[component] * blendFactor(destinationFactor, source, destination, component);
+
+        int value = 0;
+        switch (equation)
+        {
+            case sf::BlendMode::Add:             value = s + d; break;
+            case sf::BlendMode::Subtract:        value = s - d; break;
+            case sf::BlendMode::ReverseSubtract: value = d - s; break;
+        }
+
+        return value <= 0 ? 0 : std::min((value + 127) / 255, 255);
+    }
+
+    // Blend a span of shaded pixels onto the target
+    void blendSpan(const DrawCall& drawCall, sf::Uint8* destination, const sf::Uint8* source, std::size_t count)
+    {
+        if (drawCall.blendMode == sf::BlendNone)
+        {
+            std::memcpy(destination, source, count * 4);
+        }
+        else if (drawCall.blendMode == sf::BlendAlpha)
+        {
+            sf::priv::blendPixels(destination, source, count);
+        }
+        else if (drawCall.blendMode == sf::BlendAdd)
+        {
+            for (std::size_t i = 0; i < count; ++i, source += 4, destination += 4)
+            {
+                for (int component = 0; component < 3; ++component)
+                    destination[component] = static_cast<sf::Uint8>(std::min(destination[component] + multiply(source[component], source[3]), 255));
+
+                destination[3] = static_cast<sf::Uint8>(std::min(destination[3] + source[3], 255));
+            }
+        }
+        else if (drawCall.blendMode == sf::BlendMultiply)
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+                destination[i] = static_cast<sf::Uint8>(multiply(destination[i], source[i]));
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i, source += 4, destination += 4)
+            {
+                sf::Uint8 result[4];
+                for (int component = 0; component < 4; ++component)
+                    result[component] = static_cast<sf::Uint8>(blendComponent(drawCall.blendMode, source, destination, component));
+
+                std::memcpy(destination, result, 4);
+            }
+        }
+    }
+
+    void rasterizeTriangle(const DrawCall& drawCall, const Triangle& triangle, int firstRow, int lastRow, sf::Uint8* scratch)
+    {
+        const RasterVertex* v = triangle.vertices;
+        const Edge* edges = triangle.edges;
+
+        // Attributes are interpolated as v2 + (v0 - v2) * w0 + (v1 - v2) * w1, with normalized weights
+        sf::Int64 attributes[3][6] =
+        {
+            {v[0].r, v[0].g, v[0].b, v[0].a, v[0].u, v[0].v},
+            {v[1].r, v[1].g, v[1].b, v[1].a, v[1].u, v[1].v},
+            {v[2].r, v[2].g, v[2].b, v[2].a, v[2].u, v[2].v}
+        };
+
+        // Weight increments from one pixel to the next; they can only be bigger
+        // than 1 for slivers whose spans are single pixels, which don't use them
+        sf::Int64 stepWeight0 = toFraction(std::max(-triangle.area, std::min(edges[0].a * SubpixelScale, triangle.area)), triangle.area);
+        sf::Int64 stepWeight1 = toFraction(std::max(-triangle.area, std::min(edges[1].a * SubpixelScale, triangle.area)), triangle.area);
+
+        sf::Int64 steps[6];
+        for (int i = 0; i < 6; ++i)
+            steps[i] = (attributes[0][i] - attributes[2][i]) * stepWeight0 + (attributes[1][i] - attributes[2][i]) * stepWeight1;
+
+        firstRow = std::max(firstRow, triangle.top);
+        lastRow = std::min(lastRow, triangle.bottom);
+
+        for (int row = firstRow; row <= lastRow; ++row)
+        {
+            sf::Int64 y = row * SubpixelScale + SubpixelHalf;
+
+            // Find the exact range of pixel centers inside the 3 edges
+            sf::Int64 left = drawCall.clipLeft;
+            sf::Int64 right = drawCall.clipRight;
+            for (int i = 0; i < 3; ++i)
+            {
+                const Edge& edge = edges[i];
+                sf::Int64 threshold = -(edge.b * y + edge.c + edge.bias + edge.a * SubpixelHalf);
+                sf::Int64 step = edge.a * SubpixelScale;
+
+                if (step > 0)
+                    left = std::max(left, ceilDiv(threshold, step));
+                else if (step < 0)
+                    right = std::min(right, floorDiv(threshold, step));
+                else if (threshold > 0)
+                    right = left - 1;
+            }
+
+            if (left > right)
+                continue;
+
+            std::size_t count = static_cast<std::size_t>(right - left + 1);
+            sf::Uint8* destination = drawCall.pixels + (static_cast<std::size_t>(row) * drawCall.width + static_cast<std::size_t>(left)) * 4;
+
+            if (triangle.flat)
+            {
+                sf::Uint8 color[4] = {static_cast<sf::Uint8>(v[0].r), static_cast<sf::Uint8>(v[0].g),
+                                      static_cast<sf::Uint8>(v[0].b), static_cast<sf::Uint8>(v[0].a)};
+                sf::priv::fillPixels(scratch, count, color);
+            }
+            else
+            {
+                // Normalized weights of v0 and v1 at the first pixel of the span
+                sf::Int64 x = left * SubpixelScale + SubpixelHalf;
+                sf::Int64 weight0 = toFraction(edges[0].a * x + edges[0].b * y + edges[0].c, triangle.area);
+                sf::Int64 weight1 = toFraction(edges[1].a * x + edges[1].b * y + edges[1].c, triangle.area);
+
+                sf::Int64 values[6];
+                for (int i = 0; i < 6; ++i)
+                    values[i] = attributes[2][i] * FractionOne + (attributes[0][i] - attributes[2][i]) * weight0 +
+                                (attributes[1][i] - attributes[2][i]) * weight1 + FractionHalf;
+
+                sf::Uint8* pixel = scratch;
+                if (drawCall.texture)
+                {
+                    for (std::size_t i = 0; i < count; ++i, pixel += 4)
+                    {
+                        shade(drawCall, clampComponent(values[0] >> FractionBits), clampComponent(values[1] >> FractionBits),
+                              clampComponent(values[2] >> FractionBits), clampComponent(values[3] >> FractionBits),
+                              values[4] >> FractionBits, values[5] >> FractionBits, pixel);
+
+                        for (int j = 0; j < 6; ++j)
+                            values[j] += steps[j];
+                    }
+                }
+                else
+                {
+                    // Only the color is interpolated
+                    for (std::size_t i = 0; i < count; ++i, pixel += 4)
+                    {
+                        for (int j = 0; j < 4; ++j)
+                        {
+                            pixel[j] = clampComponent(values[j] >> FractionBits);
+                            values[j] += steps[j];
+                        }
+                    }
+                }
+            }
+
+            blendSpan(drawCall, destination, scratch, count);
+        }
+    }
+
+    void rasterizeLine(const DrawCall& drawCall, const Line& line, int firstRow, int lastRow)
+    {
+        const RasterVertex* v = line.vertices;
+        sf::Int64 dx = v[1].x - v[0].x;
+        sf::Int64 dy = v[1].y - v[0].y;
+        if ((dx == 0) && (dy == 0))
+            return;
+
+        // Step along the major axis, one pixel center at a time; the last pixel is excluded
+        bool xMajor = (dx < 0 ? -dx : dx) >= (dy < 0 ? -dy : dy);
+        sf::Int64 length = xMajor ? dx : dy;
+        sf::Int64 start = xMajor ? v[0].x : v[0].y;
+        sf::Int64 direction = length > 0 ? 1 : -1;
+
+        sf::Int64 first = direction > 0 ? ceilDiv(start - SubpixelHalf, SubpixelScale) : floorDiv(start - SubpixelHalf, SubpixelScale);
+        sf::Int64 end = start + length;
+
+        for (sf::Int64 major = first; ; major += direction)
+        {
+            sf::Int64 center = major * SubpixelScale + SubpixelHalf;
+            if ((direction > 0) ? (center >= end) : (center <= end))
+                break;
+
+            sf::Int64 distance = center - start;
+            sf::Int64 minor = (xMajor ? v[0].y : v[0].x) + floorDiv(distance * (xMajor ? dy : dx), length);
+            sf::Int64 px = xMajor ? major : floorDiv(minor, SubpixelScale);
+            sf::Int64 py = xMajor ? floorDiv(minor, SubpixelScale) : major;
+
+            if ((px < drawCall.clipLeft) || (px > drawCall.clipRight) || (py < firstRow) || (py > lastRow))
+                continue;
+
+            sf::Int64 weight = toFraction(distance, length);
+            sf::Int64 values[6];
+            values[0] = v[0].r * FractionOne + (v[1].r - v[0].r) * weight;
+            values[1] = v[0].g * FractionOne + (v[1].g - v[0].g) * weight;
+            values[2] = v[0].b * FractionOne + (v[1].b - v[0].b) * weight;
+            values[3] = v[0].a * FractionOne + (v[1].a - v[0].a) * weight;
+            values[4] = v[0].u * FractionOne + (v[1].u - v[0].u) * weight;
+            values[5] = v[0].v * FractionOne + (v[1].v - v[0].v) * weight;
+            for (int i = 0; i < 6; ++i)
+                values[i] = (values[i] + FractionHalf) >> FractionBits;
+
+            sf::Uint8 pixel[4];
+            shade(drawCall, clampComponent(values[0]), clampComponent(values[1]), clampComponent(values[2]),
+                  clampComponent(values[3]), values[4], values[5], pixel);
+
+            blendSpan(drawCall, drawCall.pixels + (static_cast<std::size_t>(py) * drawCall.width + static_cast<std::size_t>(px)) * 4, pixel, 1);
+        }
+    }
+
+    void rasterizePoint(const DrawCall& drawCall, const RasterVertex& point, int firstRow, int lastRow)
+    {
+        sf::Int64 px = floorDiv(point.x, SubpixelScale);
+        sf::Int64 py = floorDiv(point.y, SubpixelScale);
+        if ((px < drawCall.clipLeft) || (px > drawCall.clipRight) || (py < firstRow) || (py > lastRow))
+            return;
+
+        sf::Uint8 pixel[4];
+        shade(drawCall, clampComponent(point.r), clampComponent(point.g), clampComponent(point.b),
+              clampComponent(point.a), point.u, point.v, pixel);
+
+        blendSpan(drawCall, drawCall.pixels + (static_cast<std::size_t>(py) * drawCall.width + static_cast<std::size_t>(px)) * 4, pixel, 1);
+    }
+
+    // Rasterize all the primitives of a draw call, in order, in a band of rows
+    void rasterizeBand(Band* band)
+    {
+        const DrawCall& drawCall = *band->drawCall;
+        std::vector<sf::Uint8> scratch(drawCall.width * 4);
+
+        for (std::vector<Triangle>::const_iterator it = drawCall.triangles.begin(); it != drawCall.triangles.end(); ++it)
+            rasterizeTriangle(drawCall, *it, band->firstRow, band->lastRow, &scratch[0]);
+
+        for (std::vector<Line>::const_iterator it = drawCall.lines.begin(); it != drawCall.lines.end(); ++it)
+            rasterizeLine(drawCall, *it, band->firstRow, band->lastRow);
+
+        for (std::vector<RasterVertex>::const_iterator it = drawCall.points.begin(); it != drawCall.points.end(); ++it)
+            rasterizePoint(drawCall, *it, band->firstRow, band->lastRow);
+    }
+
+    // Memory used by the pixels of an RGBA8 image
+    std::size_t getImageSize(const sf::Image& image)
+    {
+        return static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4;
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::SoftwareRenderTarget() :
+m_image           (),
+m_threadCount     (4),
+m_textureImages   (),
+m_textureCacheSize(0),
+m_textureUseCount (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::create(unsigned int width, unsigned int height)
+{
+    if ((width == 0) || (height == 0) || (width > MaximumSize) || (height > MaximumSize))
+    {
+        err() << "Failed to create software render target, invalid size (" << width << "x" << height
+              << ", maximum is " << MaximumSize << "x" << MaximumSize << ")" << std::endl;
+        return false;
+    }
+
+    m_image.create(width, height, Color::Transparent);
+
+    RenderTarget::initialize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::setThreadCount(unsigned int count)
+{
+    m_threadCount = std::max(count, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int SoftwareRenderTarget::getThreadCount() const
+{
+    return m_threadCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::clearTextureCache()
+{
+    m_textureImages.clear();
+    m_textureCacheSize = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::clear(const Color& color)
+{
+    if (!m_image.m_storage)
+        return;
+
+    m_image.detach();
+
+    Uint8 components[4] = {color.r, color.g, color.b, color.a};
+    priv::fillPixels(&m_image.m_storage->pixels[0], m_image.getSize().x * m_image.getSize().y, components);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0) || !m_image.m_storage)
+        return;
+
+    // Pixels of the target covered by the viewport
+    Vector2u size = getSize();
+    IntRect viewport = getViewport(getView());
+
+    DrawCall drawCall;
+    drawCall.clipLeft   = std::max(viewport.left, 0);
+    drawCall.clipTop    = std::max(viewport.top, 0);
+    drawCall.clipRight  = std::min(viewport.left + viewport.width, static_cast<int>(size.x)) - 1;
+    drawCall.clipBottom = std::min(viewport.top + viewport.height, static_cast<int>(size.y)) - 1;
+
+    if ((drawCall.clipLeft > drawCall.clipRight) || (drawCall.clipTop > drawCall.clipBottom))
+        return;
+
+    m_image.detach();
+    drawCall.pixels    = &m_image.m_storage->pixels[0];
+    drawCall.width     = size.x;
+    drawCall.texture       = NULL;
+    drawCall.textureWidth  = 0;
+    drawCall.textureHeight = 0;
+    drawCall.smooth        = false;
+    drawCall.repeated      = false;
+    drawCall.blendMode     = states.blendMode;
+
+    if (states.texture && (states.texture->getSize().x > 0) && (states.texture->getSize().y > 0))
+    {
+        const Image& image = getTextureImage(*states.texture);
+        drawCall.texture       = image.getPixelsPtr();
+        drawCall.textureWidth  = static_cast<int>(image.getSize().x);
+        drawCall.textureHeight = static_cast<int>(image.getSize().y);
+        drawCall.smooth        = states.texture->isSmooth();
+        drawCall.repeated      = states.texture->isRepeated();
+    }
+
+    // Combine the transform, the view and the viewport to go straight to pixels
+    float halfWidth  = viewport.width / 2.f;
+    float halfHeight = viewport.height / 2.f;
+    Transform toPixels(halfWidth, 0.f,         viewport.left + halfWidth,
+                       0.f,       -halfHeight, viewport.top + halfHeight,
+                       0.f,       0.f,         1.f);
+    toPixels.combine(getView().getTransform()).combine(states.transform);
+
+    std::vector<ClipVertex> transformed(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        Vector2f position = toPixels.transformPoint(vertices[i].position);
+        ClipVertex& vertex = transformed[i];
+        vertex.x = position.x;
+        vertex.y = position.y;
+        vertex.r = vertices[i].color.r;
+        vertex.g = vertices[i].color.g;
+        vertex.b = vertices[i].color.b;
+        vertex.a = vertices[i].color.a;
+        vertex.u = vertices[i].texCoords.x;
+        vertex.v = vertices[i].texCoords.y;
+    }
+
+    // Assemble the primitives
+    const ClipVertex* v = &transformed[0];
+    switch (type)
+    {
+        case Points:
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                drawCall.points.push_back(snapVertex(v[i]));
+            break;
+
+        case Lines:
+            for (std::size_t i = 1; i < vertexCount; i += 2)
+                addLine(drawCall, v[i - 1], v[i]);
+            break;
+
+        case LineStrip:
+            for (std::size_t i = 1; i < vertexCount; ++i)
+                addLine(drawCall, v[i - 1], v[i]);
+            break;
+
+        case Triangles:
+            for (std::size_t i = 2; i < vertexCount; i += 3)
+                addTriangle(drawCall, v[i - 2], v[i - 1], v[i]);
+            break;
+
+        case TriangleStrip:
+            for (std::size_t i = 2; i < vertexCount; ++i)
+                addTriangle(drawCall, v[i - 2], v[i - 1], v[i]);
+            break;
+
+        case TriangleFan:
+            for (std::size_t i = 2; i < vertexCount; ++i)
+                addTriangle(drawCall, v[0], v[i - 1], v[i]);
+            break;
+
+        case Quads:
+            for (std::size_t i = 3; i < vertexCount; i += 4)
+            {
+                addTriangle(drawCall, v[i - 3], v[i - 2], v[i - 1]);
+                addTriangle(drawCall, v[i - 3], v[i - 1], v[i]);
+            }
+            break;
+    }
+
+    // Split big draw calls in bands of rows; each pixel still receives
+    // its primitives in order, so the result doesn't depend on the split
+    Int64 coveredArea = 0;
+    for (std::vector<Triangle>::const_iterator it = drawCall.triangles.begin(); it != drawCall.triangles.end(); ++it)
+        coveredArea += it->area / (2 * SubpixelScale * SubpixelScale);
+
+    int rows = drawCall.clipBottom - drawCall.clipTop + 1;
+    unsigned int threadCount = 1;
+    if (coveredArea >= MinimumThreadedArea)
+        threadCount = std::max(1u, std::min(m_threadCount, static_cast<unsigned int>(rows) / 16));
+
+    std::vector<Band> bands(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        bands[i].drawCall = &drawCall;
+        bands[i].firstRow = drawCall.clipTop + rows * static_cast<int>(i) / static_cast<int>(threadCount);
+        bands[i].lastRow  = drawCall.clipTop + rows * static_cast<int>(i + 1) / static_cast<int>(threadCount) - 1;
+    }
+
+    // The calling thread processes the first band while the others run
+    std::vector<Thread*> threads(threadCount, NULL);
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads[i] = new Thread(&rasterizeBand, &bands[i]);
+        threads[i]->launch();
+    }
+
+    rasterizeBand(&bands[0]);
+
+    for (unsigned int i = 1; i < threadCount; ++i)
+    {
+        threads[i]->wait();
+        delete threads[i];
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SoftwareRenderTarget::getSize() const
+{
+    return m_image.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::setActive(bool /* active */)
+{
+    // There's no OpenGL context to activate
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& SoftwareRenderTarget::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& SoftwareRenderTarget::getTextureImage(const Texture& texture)
+{
+    // The cache identifier of a texture is unique, and changes whenever its pixels do;
+    // unlike the address of the texture, it can't be reused by another texture
+    std::map<Uint64, TextureImage>::iterator it = m_textureImages.find(texture.m_cacheId);
+
+    if (it == m_textureImages.end())
+    {
+        TextureImage entry;
+        entry.image = texture.copyToImage();
+        entry.image.convert(RGBA8);
+
+        it = m_textureImages.insert(std::make_pair(texture.m_cacheId, entry)).first;
+        m_textureCacheSize += getImageSize(it->second.image);
+
+        // Drop the least recently used copies, which include the outdated ones, to stay in the budget
+        while ((m_textureCacheSize > TextureCacheBudget) && (m_textureImages.size() > 1))
+        {
+            std::map<Uint64, TextureImage>::iterator oldest = m_textureImages.end();
+            for (std::map<Uint64, TextureImage>::iterator entry = m_textureImages.begin(); entry != m_textureImages.end(); ++entry)
+            {
+                if ((entry != it) && ((oldest == m_textureImages.end()) || (entry->second.lastUse < oldest->second.lastUse)))
+                    oldest = entry;
+            }
+
+            m_textureCacheSize -= getImageSize(oldest->second.image);
+            m_textureImages.erase(oldest);
+        }
+    }
+
+    it->second.lastUse = ++m_textureUseCount;
+
+    return it->second.image;
+}
+
+} // namespace sf
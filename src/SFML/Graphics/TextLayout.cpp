@@ -0,0 +1,587 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextLayout.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace
+{
+    // Value of the modification marker when all the lines are up to date
+    const std::size_t noModification = static_cast<std::size_t>(-1);
+
+    // Add a glyph quad to the vertex array
+    void addGlyphQuad(sf::VertexArray& vertices, sf::Vector2f position, const sf::Color& color, const sf::Glyph& glyph, float italic)
+    {
+        float left   = glyph.bounds.left;
+        float top    = glyph.bounds.top;
+        float right  = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.top  + glyph.bounds.height;
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top  + glyph.textureRect.height);
+
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italic * top,    position.y + top),    color, sf::Vector2f(u1, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italic * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + left  - italic * bottom, position.y + bottom), color, sf::Vector2f(u1, v2)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italic * top,    position.y + top),    color, sf::Vector2f(u2, v1)));
+        vertices.append(sf::Vertex(sf::Vector2f(position.x + right - italic * bottom, position.y + bottom), color, sf::Vector2f(u2, v2)));
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextLayout::Paragraph::Paragraph() :
+string    (),
+lines     (),
+firstLine (0),
+width     (0),
+needUpdate(true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TextLayout::TextLayout() :
+m_paragraphs        (),
+m_font              (NULL),
+m_characterSize     (30),
+m_style             (Text::Regular),
+m_fillColor         (255, 255, 255),
+m_wrapWidth         (0),
+m_firstModified     (noModification),
+m_lineCount         (0),
+m_vertices          (Triangles),
+m_firstVisible      (0),
+m_lastVisible       (0),
+m_geometryNeedUpdate(false)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+TextLayout::TextLayout(const Font& font, unsigned int characterSize) :
+m_paragraphs        (),
+m_font              (&font),
+m_characterSize     (characterSize),
+m_style             (Text::Regular),
+m_fillColor         (255, 255, 255),
+m_wrapWidth         (0),
+m_firstModified     (noModification),
+m_lineCount         (0),
+m_vertices          (Triangles),
+m_firstVisible      (0),
+m_lastVisible       (0),
+m_geometryNeedUpdate(true)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setString(const String& string)
+{
+    clear();
+    appendParagraph(string);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::appendParagraph(const String& string)
+{
+    invalidate(m_paragraphs.size());
+
+    // Each line break starts a new paragraph
+    std::size_t start = 0;
+    while (true)
+    {
+        std::size_t end = string.find(String(L'\n'), start);
+
+        m_paragraphs.push_back(Paragraph());
+        m_paragraphs.back().string = string.substring(start, end == String::InvalidPos ? String::InvalidPos : end - start);
+
+        if (end == String::InvalidPos)
+            break;
+
+        start = end + 1;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::insertParagraph(std::size_t index, const String& string)
+{
+    m_paragraphs.insert(m_paragraphs.begin() + index, Paragraph());
+    m_paragraphs[index].string = string;
+
+    invalidate(index);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setParagraph(std::size_t index, const String& string)
+{
+    Paragraph& paragraph = m_paragraphs[index];
+    if (paragraph.string != string)
+    {
+        paragraph.string = string;
+
+        if (m_firstModified == noModification)
+        {
+            // The layout is up to date: lay out the paragraph now, the following
+            // ones only have to move if its number of lines changes
+            std::size_t lineCount = paragraph.lines.size();
+            layoutParagraph(paragraph);
+
+            m_geometryNeedUpdate = true;
+            if (paragraph.lines.size() != lineCount)
+                invalidate(index + 1);
+        }
+        else
+        {
+            paragraph.needUpdate = true;
+            invalidate(index);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::removeParagraphs(std::size_t index, std::size_t count)
+{
+    count = std::min(count, m_paragraphs.size() - index);
+    m_paragraphs.erase(m_paragraphs.begin() + index, m_paragraphs.begin() + index + count);
+
+    invalidate(index);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::clear()
+{
+    m_paragraphs.clear();
+
+    invalidate(0);
+}
+
+
+////////////////////////////////////////////////////////////
+const String& TextLayout::getParagraph(std::size_t index) const
+{
+    return m_paragraphs[index].string;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::getParagraphCount() const
+{
+    return m_paragraphs.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TextLayout::getLineCount() const
+{
+    ensureLayoutUpdate();
+
+    return m_lineCount;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setFont(const Font& font)
+{
+    if (m_font != &font)
+    {
+        m_font = &font;
+        invalidateAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setCharacterSize(unsigned int size)
+{
+    if (m_characterSize != size)
+    {
+        m_characterSize = size;
+        invalidateAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setStyle(Uint32 style)
+{
+    if (m_style != style)
+    {
+        m_style = style;
+        invalidateAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setFillColor(const Color& color)
+{
+    if (m_fillColor != color)
+    {
+        m_fillColor = color;
+
+        // Only the visible lines have vertices: recoloring them is cheap
+        for (std::size_t i = 0; i < m_vertices.getVertexCount(); ++i)
+            m_vertices[i].color = m_fillColor;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::setWrapWidth(float width)
+{
+    if (m_wrapWidth != width)
+    {
+        m_wrapWidth = width;
+        invalidateAll();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const Font* TextLayout::getFont() const
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TextLayout::getCharacterSize() const
+{
+    return m_characterSize;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint32 TextLayout::getStyle() const
+{
+    return m_style;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& TextLayout::getFillColor() const
+{
+    return m_fillColor;
+}
+
+
+////////////////////////////////////////////////////////////
+float TextLayout::getWrapWidth() const
+{
+    return m_wrapWidth;
+}
+
+
+////////////////////////////////////////////////////////////
+float TextLayout::getLineTop(std::size_t line) const
+{
+    if (!m_font)
+        return 0.f;
+
+    return static_cast<float>(line) * m_font->getLineSpacing(m_characterSize);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextLayout::getLocalBounds() const
+{
+    if (!m_font)
+        return FloatRect();
+
+    ensureLayoutUpdate();
+
+    float width = 0.f;
+    for (std::size_t i = 0; i < m_paragraphs.size(); ++i)
+        width = std::max(width, m_paragraphs[i].width);
+
+    return FloatRect(0.f, 0.f, width, getLineTop(m_lineCount));
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextLayout::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!m_font)
+        return;
+
+    ensureLayoutUpdate();
+
+    states.transform *= getTransform();
+
+    // Find the area of the text covered by the view
+    const View& view = target.getView();
+    FloatRect visible = view.getInverseTransform().transformRect(FloatRect(-1.f, -1.f, 2.f, 2.f));
+    visible = states.transform.getInverse().transformRect(visible);
+
+    // Convert it to a range of lines, with one line of margin on each side
+    // for the glyphs that overflow their line (accents, descenders, italic)
+    float spacing = m_font->getLineSpacing(m_characterSize);
+    if (spacing <= 0.f)
+        return;
+
+    float lineCount = static_cast<float>(m_lineCount);
+    float first     = std::min(std::max(std::floor(visible.top / spacing) - 1.f, 0.f), lineCount);
+    float last      = std::min(std::max(std::ceil((visible.top + visible.height) / spacing) + 1.f, 0.f), lineCount);
+
+    ensureGeometryUpdate(static_cast<std::size_t>(first), static_cast<std::size_t>(last));
+
+    if (m_vertices.getVertexCount() > 0)
+    {
+        states.texture = &m_font->getTexture(m_characterSize);
+        target.draw(m_vertices, states);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::invalidate(std::size_t index)
+{
+    if ((m_firstModified == noModification) || (index < m_firstModified))
+        m_firstModified = index;
+
+    m_geometryNeedUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::invalidateAll()
+{
+    for (std::size_t i = 0; i < m_paragraphs.size(); ++i)
+        m_paragraphs[i].needUpdate = true;
+
+    invalidate(0);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::layoutParagraph(Paragraph& paragraph) const
+{
+    paragraph.lines.clear();
+    paragraph.width = 0.f;
+    paragraph.needUpdate = false;
+
+    const String& string = paragraph.string;
+    Line line = {0, string.getSize(), 0.f};
+
+    if (m_font)
+    {
+        bool  bold   = (m_style & Text::Bold) != 0;
+        float hspace = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
+
+        std::size_t breakPos   = 0;
+        float       breakWidth = 0.f;
+        float       x          = 0.f;
+        Uint32      prevChar   = 0;
+        for (std::size_t i = 0; i < string.getSize(); ++i)
+        {
+            Uint32 curChar    = string[i];
+            bool   whitespace = (curChar == L' ') || (curChar == L'\t');
+
+            float advance = m_font->getKerning(prevChar, curChar, m_characterSize);
+            if (curChar == L' ')
+                advance += hspace;
+            else if (curChar == L'\t')
+                advance += hspace * 4;
+            else
+                advance += m_font->getGlyph(curChar, m_characterSize, bold).advance;
+
+            // Break the line if this character doesn't fit, preferably after the last whitespace
+            if ((m_wrapWidth > 0.f) && !whitespace && (i > line.begin) && (x + advance > m_wrapWidth))
+            {
+                line.end   = (breakPos > line.begin) ? breakPos : i;
+                line.width = (breakPos > line.begin) ? breakWidth : x;
+                paragraph.lines.push_back(line);
+                paragraph.width = std::max(paragraph.width, line.width);
+
+                // Measure the characters moved to the new line again
+                line.begin = line.end;
+                breakPos   = line.begin;
+                x          = 0.f;
+                prevChar   = 0;
+                i          = line.begin - 1;
+                continue;
+            }
+
+            if (whitespace)
+            {
+                breakPos   = i + 1;
+                breakWidth = x;
+            }
+
+            x += advance;
+            prevChar = curChar;
+        }
+
+        line.end   = string.getSize();
+        line.width = x;
+    }
+
+    // A paragraph always has at least one line, even when empty
+    paragraph.lines.push_back(line);
+    paragraph.width = std::max(paragraph.width, line.width);
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::ensureLayoutUpdate() const
+{
+    // Do nothing, if no paragraph has changed
+    if (m_firstModified == noModification)
+        return;
+
+    // Lay out the modified paragraphs and shift the first line of the ones after them;
+    // paragraphs that were not modified keep their cached lines
+    std::size_t index = std::min(m_firstModified, m_paragraphs.size());
+    std::size_t line  = 0;
+    if (index > 0)
+        line = m_paragraphs[index - 1].firstLine + m_paragraphs[index - 1].lines.size();
+
+    for (; index < m_paragraphs.size(); ++index)
+    {
+        Paragraph& paragraph = m_paragraphs[index];
+
+        if (paragraph.needUpdate)
+            layoutParagraph(paragraph);
+
+        paragraph.firstLine = line;
+        line += paragraph.lines.size();
+    }
+
+    m_lineCount     = line;
+    m_firstModified = noModification;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextLayout::ensureGeometryUpdate(std::size_t first, std::size_t last) const
+{
+    // Reuse the current geometry if it still covers the visible lines without being much larger
+    std::size_t visibleCount = last - first;
+    if (!m_geometryNeedUpdate && (first >= m_firstVisible) && (last <= m_lastVisible) &&
+        (m_lastVisible - m_firstVisible <= visibleCount * 2 + 2))
+        return;
+
+    m_geometryNeedUpdate = false;
+    m_vertices.clear();
+
+    // Build half a screen of extra lines on each side, so that scrolling
+    // doesn't rebuild the geometry every frame
+    m_firstVisible = (first > visibleCount / 2) ? first - visibleCount / 2 : 0;
+    m_lastVisible  = std::min(last + visibleCount / 2, m_lineCount);
+
+    if (m_firstVisible >= m_lastVisible)
+        return;
+
+    // Find the paragraph that contains the first line
+    std::size_t low  = 0;
+    std::size_t high = m_paragraphs.size();
+    while (high - low > 1)
+    {
+        std::size_t middle = (low + high) / 2;
+        if (m_paragraphs[middle].firstLine <= m_firstVisible)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    // Compute values related to the text style
+    bool  bold    = (m_style & Text::Bold) != 0;
+    float italic  = (m_style & Text::Italic) ? 0.208f : 0.f; // 12 degrees
+    float hspace  = static_cast<float>(m_font->getGlyph(L' ', m_characterSize, bold).advance);
+    float spacing = m_font->getLineSpacing(m_characterSize);
+
+    // Create one quad for each visible character
+    std::size_t lineIndex = m_firstVisible;
+    for (std::size_t p = low; (p < m_paragraphs.size()) && (lineIndex < m_lastVisible); ++p)
+    {
+        const Paragraph& paragraph = m_paragraphs[p];
+
+        for (std::size_t l = lineIndex - paragraph.firstLine; (l < paragraph.lines.size()) && (lineIndex < m_lastVisible); ++l, ++lineIndex)
+        {
+            const Line& line = paragraph.lines[l];
+
+            float  x        = 0.f;
+            float  y        = static_cast<float>(lineIndex) * spacing + static_cast<float>(m_characterSize);
+            Uint32 prevChar = 0;
+            for (std::size_t i = line.begin; i < line.end; ++i)
+            {
+                Uint32 curChar = paragraph.string[i];
+
+                // Apply the kerning offset
+                x += m_font->getKerning(prevChar, curChar, m_characterSize);
+                prevChar = curChar;
+
+                // Handle special characters
+                if (curChar == L' ')
+                {
+                    x += hspace;
+                    continue;
+                }
+                else if (curChar == L'\t')
+                {
+                    x += hspace * 4;
+                    continue;
+                }
+
+                const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, bold);
+
+                addGlyphQuad(m_vertices, Vector2f(x, y), m_fillColor, glyph, italic);
+
+                x += glyph.advance;
+            }
+        }
+    }
+}
+
+} // namespace sf
@@ -28,12 +28,14 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/PixelConverter.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -53,6 +55,51 @@ namespace
 
         return id++;
     }
+
+    // Get the OpenGL format and type of the pixels of a given format,
+    // and the internal format used to store them
+    void getGlFormat(sf::PixelFormat format, GLenum& glFormat, GLenum& type, GLint& internalFormat)
+    {
+        switch (format)
+        {
+            case sf::RGB8:     glFormat = GL_RGB;       type = GL_UNSIGNED_BYTE;                 break;
+            case sf::RGB565:   glFormat = GL_RGB;       type = GLEXT_GL_UNSIGNED_SHORT_5_6_5;   break;
+            case sf::RGBA4444: glFormat = GL_RGBA;      type = GLEXT_GL_UNSIGNED_SHORT_4_4_4_4; break;
+            case sf::L8:       glFormat = GL_LUMINANCE; type = GL_UNSIGNED_BYTE;                 break;
+            case sf::A8:       glFormat = GL_ALPHA;     type = GL_UNSIGNED_BYTE;                 break;
+            default:           glFormat = GL_RGBA;      type = GL_UNSIGNED_BYTE;                 break;
+        }
+
+#ifdef SFML_OPENGL_ES
+
+        // OpenGL ES stores the pixels in the format they are given in
+        internalFormat = static_cast<GLint>(glFormat);
+
+#else
+
+        // Desktop drivers would store unsized 16-bit formats with 8 bits per component.
+        // GL_RGB5 may keep only 5 bits of green, so RGB565 pixels are stored exactly
+        // with ARB_ES2_compatibility, and with 8 bits per component without it
+        GLint rgb565 = GLEXT_ES2_compatibility ? GLEXT_GL_RGB565 : GL_RGB8;
+
+        switch (format)
+        {
+            case sf::RGB8:     internalFormat = GL_RGB8;       break;
+            case sf::RGB565:   internalFormat = rgb565;        break;
+            case sf::RGBA4444: internalFormat = GL_RGBA4;      break;
+            case sf::L8:       internalFormat = GL_LUMINANCE8; break;
+            case sf::A8:       internalFormat = GL_ALPHA8;     break;
+            default:           internalFormat = GL_RGBA;       break;
+        }
+
+#endif
+    }
+
+    // Luminance and alpha textures can't be attached to a frame buffer
+    bool isColorRenderable(sf::PixelFormat format)
+    {
+        return (format != sf::L8) && (format != sf::A8);
+    }
 }
 
 
@@ -69,7 +116,9 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_format       (RGBA8),
+m_cacheId      (getUniqueId()),
+m_pixelCopy    (NULL)
 {
 }
 
@@ -85,11 +134,13 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
-m_cacheId      (getUniqueId())
+m_format       (RGBA8),
+m_cacheId      (getUniqueId()),
+m_pixelCopy    (NULL)
 {
     if (copy.m_texture)
     {
-        if (create(copy.getSize().x, copy.getSize().y))
+        if (create(copy.getSize().x, copy.getSize().y, copy.m_format))
         {
             update(copy);
 
@@ -120,7 +171,7 @@ Texture::~Texture()
 
 
 ////////////////////////////////////////////////////////////
-bool Texture::create(unsigned int width, unsigned int height)
+bool Texture::create(unsigned int width, unsigned int height, PixelFormat format)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -149,6 +200,7 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_actualSize    = actualSize;
     m_pixelsFlipped = false;
     m_fboAttachment = false;
+    m_format        = format;
 
     TransientContextLock lock;
 
@@ -184,7 +236,7 @@ bool Texture::create(unsigned int width, unsigned int height)
 
     static bool textureSrgb = GLEXT_texture_sRGB;
 
-    if (m_sRgb && !textureSrgb)
+    if (m_sRgb && !textureSrgb && (m_format == RGBA8))
     {
         static bool warned = false;
 
@@ -203,13 +255,31 @@ bool Texture::create(unsigned int width, unsigned int height)
         m_sRgb = false;
     }
 
-    // Initialize the texture
+    // Initialize the texture (sRGB conversion only applies to RGBA8 textures)
+    GLenum glFormat, type;
+    GLint internalFormat;
+    getGlFormat(m_format, glFormat, type, internalFormat);
+    if (m_sRgb && (m_format == RGBA8))
+        internalFormat = GLEXT_GL_SRGB8_ALPHA8;
+
     glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), m_actualSize.x, m_actualSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_actualSize.x, m_actualSize.y, 0, glFormat, type, NULL));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+    // A8 textures are sampled as white with the alpha of their pixels by shaders too
+    // (the fixed pipeline and the default OpenGL ES 2 program don't need the swizzle)
+    if (GLEXT_texture_swizzle)
+    {
+        bool white = (m_format == A8);
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_SWIZZLE_R, white ? GL_ONE : GLEXT_GL_RED));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_SWIZZLE_G, white ? GL_ONE : GLEXT_GL_GREEN));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_SWIZZLE_B, white ? GL_ONE : GLEXT_GL_BLUE));
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GLEXT_GL_TEXTURE_SWIZZLE_A, GL_ALPHA));
+    }
+
     m_cacheId = getUniqueId();
 
     m_hasMipmap = false;
@@ -254,16 +324,7 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
        ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
     {
         // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
-        {
-            update(image);
-
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return loadFromImage(ImageView(image));
     }
     else
     {
@@ -276,36 +337,24 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
         if (rectangle.left + rectangle.width > width)  rectangle.width  = width - rectangle.left;
         if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
 
-        // Create the texture and upload the pixels
-        if (create(rectangle.width, rectangle.height))
-        {
-            TransientContextLock lock;
-
-            // Make sure that the current texture binding will be preserved
-            priv::TextureSaver save;
-
-            // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-            for (int i = 0; i < rectangle.height; ++i)
-            {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
-            }
+        // The view points into the image, no pixel is copied before the upload
+        return loadFromImage(ImageView(image, rectangle));
+    }
+}
 
-            glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
-            m_hasMipmap = false;
 
-            // Force an OpenGL flush, so that the texture will appear updated
-            // in all contexts immediately (solves problems in multi-threaded apps)
-            glCheck(glFlush());
+////////////////////////////////////////////////////////////
+bool Texture::loadFromImage(const ImageView& view)
+{
+    if (create(view.getSize().x, view.getSize().y, view.getPixelFormat()))
+    {
+        update(view);
 
-            return true;
-        }
-        else
-        {
-            return false;
-        }
+        return true;
+    }
+    else
+    {
+        return false;
     }
 }
 
@@ -317,6 +366,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat Texture::getPixelFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -324,16 +380,32 @@ Image Texture::copyToImage() const
     if (!m_texture)
         return Image();
 
+    // The owner of the texture keeps a copy of its pixels: no need to read them back
+    if (m_pixelCopy && (m_pixelCopy->size() == m_size.x * m_size.y * priv::getPixelSize(m_format)))
+    {
+        Image image;
+        image.create(m_size.x, m_size.y, &(*m_pixelCopy)[0], m_format);
+
+        return image;
+    }
+
     TransientContextLock lock;
 
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
+#ifdef SFML_OPENGL_ES
+
+    // Luminance and alpha textures can't be attached to a FBO, so they can't be read back
+    if (!isColorRenderable(m_format))
+    {
+        err() << "Failed to copy texture to image, luminance and alpha textures can't be read on OpenGL ES" << std::endl;
+        return Image();
+    }
+
     // Create an array of pixels
     std::vector<Uint8> pixels(m_size.x * m_size.y * 4);
 
-#ifdef SFML_OPENGL_ES
-
     // OpenGL ES doesn't have the glGetTexImage function, the only way to read
     // from a texture is to bind it to a FBO and use glReadPixels
     GLuint frameBuffer = 0;
@@ -351,28 +423,51 @@ Image Texture::copyToImage() const
         glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer));
     }
 
+    // glReadPixels always returns RGBA pixels, convert them back to the format of the texture
+    Image image;
+    image.create(m_size.x, m_size.y, &pixels[0]);
+    image.convert(m_format);
+
+    return image;
+
 #else
 
+    GLenum glFormat, type;
+    GLint internalFormat;
+    getGlFormat(m_format, glFormat, type, internalFormat);
+
+    // Create an array of pixels, in the format of the texture
+    std::size_t pixelSize = priv::getPixelSize(m_format);
+    std::vector<Uint8> pixels(m_size.x * m_size.y * pixelSize);
+
+    // Rows of pixels smaller than 4 bytes are not 4-byte aligned
+    GLint packAlignment = 4;
+    if (pixelSize != 4)
+    {
+        glCheck(glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment));
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+    }
+
     if ((m_size == m_actualSize) && !m_pixelsFlipped)
     {
         // Texture is not padded nor flipped, we can use a direct copy
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &pixels[0]));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, glFormat, type, &pixels[0]));
     }
     else
     {
         // Texture is either padded or flipped, we have to use a slower algorithm
 
         // All the pixels will first be copied to a temporary array
-        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * 4);
+        std::vector<Uint8> allPixels(m_actualSize.x * m_actualSize.y * pixelSize);
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, &allPixels[0]));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, glFormat, type, &allPixels[0]));
 
         // Then we copy the useful pixels from the temporary array to the final one
         const Uint8* src = &allPixels[0];
         Uint8* dst = &pixels[0];
-        int srcPitch = m_actualSize.x * 4;
-        int dstPitch = m_size.x * 4;
+        int srcPitch = m_actualSize.x * pixelSize;
+        int dstPitch = m_size.x * pixelSize;
 
         // Handle the case where source pixels are flipped vertically
         if (m_pixelsFlipped)
@@ -389,13 +484,16 @@ Image Texture::copyToImage() const
         }
     }
 
-#endif // SFML_OPENGL_ES
+    if (pixelSize != 4)
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, packAlignment));
 
     // Create the image
     Image image;
-    image.create(m_size.x, m_size.y, &pixels[0]);
+    image.create(m_size.x, m_size.y, &pixels[0], m_format);
 
     return image;
+
+#endif // SFML_OPENGL_ES
 }
 
 
@@ -409,6 +507,13 @@ void Texture::update(const Uint8* pixels)
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y)
+{
+    update(pixels, width, height, x, y, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Uint8* pixels, unsigned int width, unsigned int height, unsigned int x, unsigned int y, std::size_t rowStride)
 {
     assert(x + width <= m_size.x);
     assert(y + height <= m_size.y);
@@ -420,10 +525,63 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
+        GLenum glFormat, type;
+        GLint internalFormat;
+        getGlFormat(m_format, glFormat, type, internalFormat);
+
+        std::size_t pixelSize = priv::getPixelSize(m_format);
+        std::size_t rowSize = width * pixelSize;
+        // A single row, or contiguous rows, can be uploaded as they are
+        if ((rowStride == 0) || (height <= 1) || (width == 0))
+            rowStride = rowSize;
+
+        // Rows of pixels smaller than 4 bytes are not 4-byte aligned
+        bool unaligned = (pixelSize != 4);
+        GLint unpackAlignment = 4;
+        if (unaligned)
+        {
+            glCheck(glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment));
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        }
+
         // Copy pixels from the given array to the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        if (rowStride == rowSize)
+        {
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, glFormat, type, pixels));
+        }
+#ifndef SFML_OPENGL_ES
+        else if (rowStride % pixelSize == 0)
+        {
+            // Let OpenGL skip the end of the rows
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(rowStride / pixelSize)));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, glFormat, type, pixels));
+            glCheck(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+        }
+#endif
+        else
+        {
+            // OpenGL ES 2 has no row length: pack the rows into a scratch
+            // buffer, and upload as many of them as it holds at once
+            const std::size_t scratchSize = 256 * 1024;
+            unsigned int chunkRows = static_cast<unsigned int>(std::max<std::size_t>(scratchSize / rowSize, 1));
+            chunkRows = std::min(chunkRows, height);
+
+            std::vector<Uint8> scratch(chunkRows * rowSize);
+            for (unsigned int row = 0; row < height; row += chunkRows)
+            {
+                unsigned int rows = std::min(chunkRows, height - row);
+                for (unsigned int i = 0; i < rows; ++i)
+                    std::memcpy(&scratch[i * rowSize], pixels + (row + i) * rowStride, rowSize);
+
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y + row, width, rows, glFormat, type, &scratch[0]));
+            }
+        }
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
+
+        if (unaligned)
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment));
+
         m_hasMipmap = false;
         m_pixelsFlipped = false;
         m_cacheId = getUniqueId();
@@ -461,7 +619,8 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         priv::ensureExtensionsInit();
     }
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    // Luminance and alpha textures are not color-renderable, so they can't be attached to a frame buffer
+    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit && isColorRenderable(m_format) && isColorRenderable(texture.m_format))
     {
         TransientContextLock lock;
 
@@ -503,6 +662,7 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         {
             // Blit the texture contents from the source to the destination texture
             glCheck(GLEXT_glBlitFramebuffer(0, 0, texture.m_size.x, texture.m_size.y, x, y, x + texture.m_size.x, y + texture.m_size.y, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+            m_cacheId = getUniqueId();
         }
         else
         {
@@ -530,14 +690,53 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 void Texture::update(const Image& image)
 {
     // Update the whole texture
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+    update(image, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image, unsigned int x, unsigned int y)
 {
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
+    update(ImageView(image), x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const Image& image, const IntRect& sourceRect, unsigned int x, unsigned int y)
+{
+    update(ImageView(image, sourceRect), x, y);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& view)
+{
+    // Update the whole texture
+    update(view, 0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::update(const ImageView& view, unsigned int x, unsigned int y)
+{
+    const Uint8* pixels = view.getPixelsPtr();
+    unsigned int width = view.getSize().x;
+    unsigned int height = view.getSize().y;
+
+    if (pixels && (view.getPixelFormat() != m_format))
+    {
+        // Convert the rows to the format of the texture, packed contiguously
+        std::size_t rowSize = width * priv::getPixelSize(m_format);
+        std::vector<Uint8> converted(rowSize * height);
+        for (unsigned int i = 0; i < height; ++i)
+            priv::convertPixels(pixels + i * view.getStride(), view.getPixelFormat(), &converted[i * rowSize], m_format, width);
+
+        update(&converted[0], width, height, x, y);
+    }
+    else
+    {
+        update(pixels, width, height, x, y, view.getStride());
+    }
 }
 
 
@@ -727,28 +926,13 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
         // Bind the texture
         glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
 
+#ifndef SFML_OPENGL_ES2
+
         // Check if we need to define a special texture matrix
         if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
         {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
-
-            // If non-normalized coordinates (= pixels) are requested, we need to
-            // setup scale factors that convert the range [0 .. size] to [0 .. 1]
-            if (coordinateType == Pixels)
-            {
-                matrix[0] = 1.f / texture->m_actualSize.x;
-                matrix[5] = 1.f / texture->m_actualSize.y;
-            }
-
-            // If pixels are flipped we must invert the Y axis
-            if (texture->m_pixelsFlipped)
-            {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / texture->m_actualSize.y;
-            }
+            GLfloat matrix[16];
+            texture->getMatrix(matrix, coordinateType);
 
             // Load the matrix
             glCheck(glMatrixMode(GL_TEXTURE));
@@ -757,18 +941,51 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
             // Go back to model-view mode (sf::RenderTarget relies on it)
             glCheck(glMatrixMode(GL_MODELVIEW));
         }
+
+#endif
     }
     else
     {
         // Bind no texture
         glCheck(glBindTexture(GL_TEXTURE_2D, 0));
 
+#ifndef SFML_OPENGL_ES2
+
         // Reset the texture matrix
         glCheck(glMatrixMode(GL_TEXTURE));
         glCheck(glLoadIdentity());
 
         // Go back to model-view mode (sf::RenderTarget relies on it)
         glCheck(glMatrixMode(GL_MODELVIEW));
+
+#endif
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Texture::getMatrix(float* matrix, CoordinateType coordinateType) const
+{
+    static const float identity[16] = {1.f, 0.f, 0.f, 0.f,
+                                       0.f, 1.f, 0.f, 0.f,
+                                       0.f, 0.f, 1.f, 0.f,
+                                       0.f, 0.f, 0.f, 1.f};
+
+    std::memcpy(matrix, identity, sizeof(identity));
+
+    // If non-normalized coordinates (= pixels) are requested, we need to
+    // setup scale factors that convert the range [0 .. size] to [0 .. 1]
+    if (coordinateType == Pixels)
+    {
+        matrix[0] = 1.f / m_actualSize.x;
+        matrix[5] = 1.f / m_actualSize.y;
+    }
+
+    // If pixels are flipped we must invert the Y axis
+    if (m_pixelsFlipped)
+    {
+        matrix[5] = -matrix[5];
+        matrix[13] = static_cast<float>(m_size.y) / m_actualSize.y;
     }
 }
 
@@ -817,6 +1034,9 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_format,        right.m_format);
+
+    // The copy of the pixels stays with the object which owns it (see Font)
 
     m_cacheId = getUniqueId();
     right.m_cacheId = getUniqueId();
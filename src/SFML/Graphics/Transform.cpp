@@ -29,6 +29,17 @@
 #include <cmath>
 
 
+namespace
+{
+    // Check whether a 4x4 matrix is a 2D affine transform, ie.
+    // whether the last row of its 3x3 form is (0, 0, 1)
+    inline bool isAffine(const float* matrix)
+    {
+        return (matrix[3] == 0.f) && (matrix[7] == 0.f) && (matrix[15] == 1.f);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
@@ -68,6 +79,24 @@ const float* Transform::getMatrix() const
 ////////////////////////////////////////////////////////////
 Transform Transform::getInverse() const
 {
+    // Affine transforms only need the determinant of their 2x2 part
+    if (isAffine(m_matrix))
+    {
+        float det = m_matrix[0] * m_matrix[5] - m_matrix[1] * m_matrix[4];
+        if (det == 0.f)
+            return Identity;
+
+        float inv = 1.f / det;
+        float a00 =  m_matrix[5] * inv;
+        float a01 = -m_matrix[4] * inv;
+        float a10 = -m_matrix[1] * inv;
+        float a11 =  m_matrix[0] * inv;
+
+        return Transform(a00, a01, -(a00 * m_matrix[12] + a01 * m_matrix[13]),
+                         a10, a11, -(a10 * m_matrix[12] + a11 * m_matrix[13]),
+                         0.f, 0.f, 1.f);
+    }
+
     // Compute the determinant
     float det = m_matrix[0] * (m_matrix[15] * m_matrix[5] - m_matrix[7] * m_matrix[13]) -
                 m_matrix[1] * (m_matrix[15] * m_matrix[4] - m_matrix[7] * m_matrix[12]) +
@@ -112,6 +141,20 @@ Vector2f Transform::transformPoint(const Vector2f& point) const
 ////////////////////////////////////////////////////////////
 FloatRect Transform::transformRect(const FloatRect& rectangle) const
 {
+    // Without rotation nor shear, the rectangle stays axis-aligned
+    if ((m_matrix[1] == 0.f) && (m_matrix[4] == 0.f))
+    {
+        Vector2f a = transformPoint(rectangle.left, rectangle.top);
+        Vector2f b = transformPoint(rectangle.left + rectangle.width, rectangle.top + rectangle.height);
+
+        float left   = a.x < b.x ? a.x : b.x;
+        float top    = a.y < b.y ? a.y : b.y;
+        float right  = a.x < b.x ? b.x : a.x;
+        float bottom = a.y < b.y ? b.y : a.y;
+
+        return FloatRect(left, top, right - left, bottom - top);
+    }
+
     // Transform the 4 corners of the rectangle
     const Vector2f points[] =
     {
@@ -144,6 +187,23 @@ Transform& Transform::combine(const Transform& transform)
     const float* a = m_matrix;
     const float* b = transform.m_matrix;
 
+    // The product of two affine transforms is affine, only
+    // the 2x3 upper part of the matrix changes
+    if (isAffine(a) && isAffine(b))
+    {
+        float a00 = a[0] * b[0]  + a[4] * b[1];
+        float a01 = a[0] * b[4]  + a[4] * b[5];
+        float a02 = a[0] * b[12] + a[4] * b[13] + a[12];
+        float a10 = a[1] * b[0]  + a[5] * b[1];
+        float a11 = a[1] * b[4]  + a[5] * b[5];
+        float a12 = a[1] * b[12] + a[5] * b[13] + a[13];
+
+        m_matrix[0] = a00; m_matrix[4] = a01; m_matrix[12] = a02;
+        m_matrix[1] = a10; m_matrix[5] = a11; m_matrix[13] = a12;
+
+        return *this;
+    }
+
     *this = Transform(a[0] * b[0]  + a[4] * b[1]  + a[12] * b[3],
                       a[0] * b[4]  + a[4] * b[5]  + a[12] * b[7],
                       a[0] * b[12] + a[4] * b[13] + a[12] * b[15],
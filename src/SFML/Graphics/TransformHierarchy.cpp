@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TransformHierarchy.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const std::size_t TransformHierarchy::NoParent = static_cast<std::size_t>(-1);
+
+
+////////////////////////////////////////////////////////////
+TransformHierarchy::TransformHierarchy() :
+m_parents   (),
+m_locals    (),
+m_worlds    (),
+m_changed   (),
+m_needUpdate(false)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TransformHierarchy::addNode(std::size_t parent, const Transform& transform)
+{
+    if ((parent != NoParent) && (parent >= m_parents.size()))
+    {
+        err() << "Failed to add node to transform hierarchy, parent " << parent
+              << " doesn't exist (the node is added as a root node)" << std::endl;
+        parent = NoParent;
+    }
+
+    m_parents.push_back(parent);
+    m_locals.push_back(Affine());
+    m_worlds.push_back(Affine());
+    m_changed.push_back(0);
+
+    std::size_t node = m_parents.size() - 1;
+    setLocalTransform(node, transform);
+
+    return node;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TransformHierarchy::getNodeCount() const
+{
+    return m_parents.size();
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t TransformHierarchy::getParent(std::size_t node) const
+{
+    return m_parents[node];
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformHierarchy::clear()
+{
+    m_parents.clear();
+    m_locals.clear();
+    m_worlds.clear();
+    m_changed.clear();
+    m_needUpdate = false;
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformHierarchy::setLocalTransform(std::size_t node, const Transform& transform)
+{
+    const float* matrix = transform.getMatrix();
+
+    Affine& local = m_locals[node];
+    local.a00 = matrix[0]; local.a01 = matrix[4]; local.a02 = matrix[12];
+    local.a10 = matrix[1]; local.a11 = matrix[5]; local.a12 = matrix[13];
+
+    m_changed[node] = 1;
+    m_needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Transform TransformHierarchy::getLocalTransform(std::size_t node) const
+{
+    const Affine& local = m_locals[node];
+
+    return Transform(local.a00, local.a01, local.a02,
+                     local.a10, local.a11, local.a12,
+                     0.f,       0.f,       1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+Transform TransformHierarchy::getWorldTransform(std::size_t node) const
+{
+    if (m_needUpdate)
+        update();
+
+    const Affine& world = m_worlds[node];
+
+    return Transform(world.a00, world.a01, world.a02,
+                     world.a10, world.a11, world.a12,
+                     0.f,       0.f,       1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f TransformHierarchy::transformPoint(std::size_t node, const Vector2f& point) const
+{
+    if (m_needUpdate)
+        update();
+
+    const Affine& world = m_worlds[node];
+
+    return Vector2f(world.a00 * point.x + world.a01 * point.y + world.a02,
+                    world.a10 * point.x + world.a11 * point.y + world.a12);
+}
+
+
+////////////////////////////////////////////////////////////
+void TransformHierarchy::update() const
+{
+    std::size_t count = m_parents.size();
+    if (count == 0)
+        return;
+
+    const std::size_t* parents = &m_parents[0];
+    const Affine*      locals  = &m_locals[0];
+    Affine*            worlds  = &m_worlds[0];
+    Uint8*             changed = &m_changed[0];
+
+    // Parents come before their children, so when a node is
+    // visited its parent is already up to date, and so is the
+    // flag telling whether the parent changed
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        std::size_t parent = parents[i];
+
+        if (parent == NoParent)
+        {
+            if (changed[i])
+                worlds[i] = locals[i];
+            continue;
+        }
+
+        if (!changed[i] && !changed[parent])
+            continue;
+
+        changed[i] = 1;
+
+        // Same operations, in the same order, as Transform::combine
+        const Affine& a = worlds[parent];
+        const Affine& b = locals[i];
+        Affine& world   = worlds[i];
+        world.a00 = a.a00 * b.a00 + a.a01 * b.a10;
+        world.a01 = a.a00 * b.a01 + a.a01 * b.a11;
+        world.a02 = a.a00 * b.a02 + a.a01 * b.a12 + a.a02;
+        world.a10 = a.a10 * b.a00 + a.a11 * b.a10;
+        world.a11 = a.a10 * b.a01 + a.a11 * b.a11;
+        world.a12 = a.a10 * b.a02 + a.a11 * b.a12 + a.a12;
+    }
+
+    std::fill(m_changed.begin(), m_changed.end(), 0);
+    m_needUpdate = false;
+}
+
+} // namespace sf
@@ -37,6 +37,9 @@ m_origin                    (0, 0),
 m_position                  (0, 0),
 m_rotation                  (0),
 m_scale                     (1, 1),
+m_cosine                    (1),
+m_sine                      (0),
+m_rotationNeedUpdate        (false),
 m_transform                 (),
 m_transformNeedUpdate       (true),
 m_inverseTransform          (),
@@ -75,6 +78,7 @@ void Transformable::setRotation(float angle)
     if (m_rotation < 0)
         m_rotation += 360.f;
 
+    m_rotationNeedUpdate = true;
     m_transformNeedUpdate = true;
     m_inverseTransformNeedUpdate = true;
 }
@@ -183,13 +187,20 @@ const Transform& Transformable::getTransform() const
     // Recompute the combined transform if needed
     if (m_transformNeedUpdate)
     {
-        float angle  = -m_rotation * 3.141592654f / 180.f;
-        float cosine = static_cast<float>(std::cos(angle));
-        float sine   = static_cast<float>(std::sin(angle));
-        float sxc    = m_scale.x * cosine;
-        float syc    = m_scale.y * cosine;
-        float sxs    = m_scale.x * sine;
-        float sys    = m_scale.y * sine;
+        // Moving or scaling the object doesn't change its rotation,
+        // so the sine and cosine are only computed when it rotates
+        if (m_rotationNeedUpdate)
+        {
+            float angle = -m_rotation * 3.141592654f / 180.f;
+            m_cosine = static_cast<float>(std::cos(angle));
+            m_sine   = static_cast<float>(std::sin(angle));
+            m_rotationNeedUpdate = false;
+        }
+
+        float sxc    = m_scale.x * m_cosine;
+        float syc    = m_scale.y * m_cosine;
+        float sxs    = m_scale.x * m_sine;
+        float sys    = m_scale.y * m_sine;
         float tx     = -m_origin.x * sxc - m_origin.y * sys + m_position.x;
         float ty     =  m_origin.x * sxs - m_origin.y * syc + m_position.y;
 
@@ -80,6 +80,13 @@ const Context* Context::getActiveContext()
 }
 
 
+////////////////////////////////////////////////////////////
+Context::StartupTimings Context::getStartupTimings()
+{
+    return priv::GlContext::getStartupTimings();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Context::isExtensionAvailable(const char* name)
 {
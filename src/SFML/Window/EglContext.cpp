@@ -33,15 +33,67 @@
 #include <SFML/System/Sleep.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Clock.hpp>
+#include <vector>
+#include <cstring>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/Activity.hpp>
 #endif
-#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI)
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI) && !defined(SFML_HEADLESS)
     #include <X11/Xlib.h>
 #endif
 
+#if !defined(EGL_PLATFORM_SURFACELESS_MESA)
+    #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
 namespace
 {
+    // A config chosen for a given set of settings
+    struct ConfigEntry
+    {
+        EGLDisplay   display;
+        unsigned int bitsPerPixel;
+        unsigned int depthBits;
+        unsigned int stencilBits;
+        unsigned int antialiasingLevel;
+        EGLConfig    config;
+    };
+
+    // Configs already chosen, most contexts are created with the same settings
+    sf::Mutex configMutex;
+    std::vector<ConfigEntry> configs;
+
+#if defined(SFML_HEADLESS)
+
+    typedef EGLDisplay (EGLAPIENTRY *GetPlatformDisplayFuncType)(EGLenum, void*, const EGLint*);
+
+    // Get a display of the Mesa surfaceless platform, which doesn't need
+    // any display server, or EGL_NO_DISPLAY if it is not supported
+    EGLDisplay getSurfacelessDisplay()
+    {
+        // Client extensions are queried without a display
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (!extensions || !std::strstr(extensions, "EGL_MESA_platform_surfaceless"))
+            return EGL_NO_DISPLAY;
+
+        GetPlatformDisplayFuncType getPlatformDisplay = reinterpret_cast<GetPlatformDisplayFuncType>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (!getPlatformDisplay)
+            return EGL_NO_DISPLAY;
+
+        return getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL);
+    }
+
+#endif
+
+    // Select the client API of the contexts for the calling thread
+    void bindClientApi()
+    {
+#if !defined(SFML_OPENGL_ES)
+        eglBindAPI(EGL_OPENGL_API);
+#endif
+    }
+
     EGLDisplay getInitializedDisplay()
     {
 #if defined(SFML_SYSTEM_LINUX)
@@ -50,8 +102,19 @@ namespace
 
         if (display == EGL_NO_DISPLAY)
         {
+#if defined(SFML_HEADLESS)
+            display = getSurfacelessDisplay();
+
+            // Fall back to the default display, which supports pbuffers on most drivers
+            if (display == EGL_NO_DISPLAY)
+            {
+                display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
+            }
+#else
             display = eglCheck(eglGetDisplay(EGL_DEFAULT_DISPLAY));
-            eglCheck(eglInitialize(display, NULL, NULL));
+#endif
+            if (!eglInitialize(display, NULL, NULL))
+                sf::err() << "Failed to initialize the EGL display" << std::endl;
         }
 
         return display;
@@ -87,15 +150,8 @@ m_config  (NULL)
     m_config = getBestConfig(m_display, VideoMode::getDesktopMode().bitsPerPixel, ContextSettings());
     updateSettings();
 
-    // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
-    // but this is resulting in a segfault. Bug in Android?
-    EGLint attrib_list[] = {
-        EGL_WIDTH, 1,
-        EGL_HEIGHT,1,
-        EGL_NONE
-    };
-
-    m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+    // The shared context never renders, give it the smallest surface
+    createPbufferSurface(1, 1);
 
     // Create EGL context
     createContext(shared);
@@ -129,7 +185,11 @@ m_config  (NULL)
     // Create EGL context
     createContext(shared);
 
-#if !defined(SFML_SYSTEM_ANDROID)
+#if defined(SFML_HEADLESS)
+    // There is no native window, render to an offscreen surface of the same size
+    Vector2u size = owner->getSize();
+    createPbufferSurface(size.x, size.y);
+#elif !defined(SFML_SYSTEM_ANDROID)
     // Create EGL surface (except on Android because the window is created
     // asynchronously, its activity manager will call it for us)
     createSurface((EGLNativeWindowType)owner->getSystemHandle());
@@ -144,12 +204,26 @@ m_context (EGL_NO_CONTEXT),
 m_surface (EGL_NO_SURFACE),
 m_config  (NULL)
 {
+    // Get the initialized EGL display
+    m_display = getInitializedDisplay();
+
+    // Get the best EGL config matching the requested video settings
+    m_config = getBestConfig(m_display, VideoMode::getDesktopMode().bitsPerPixel, settings);
+    updateSettings();
+
+    // Render to an offscreen surface
+    createPbufferSurface(width, height);
+
+    // Create EGL context
+    createContext(shared);
 }
 
 
 ////////////////////////////////////////////////////////////
 EglContext::~EglContext()
 {
+    bindClientApi();
+
     // Deactivate the current context
     EGLContext currentContext = eglCheck(eglGetCurrentContext());
 
@@ -172,9 +246,18 @@ EglContext::~EglContext()
 }
 
 
+////////////////////////////////////////////////////////////
+GlFunctionPointer EglContext::getFunction(const char* name)
+{
+    return reinterpret_cast<GlFunctionPointer>(eglGetProcAddress(name));
+}
+
+
 ////////////////////////////////////////////////////////////
 bool EglContext::makeCurrent(bool current)
 {
+    bindClientApi();
+
     if (current)
         return m_surface != EGL_NO_SURFACE && eglCheck(eglMakeCurrent(m_display, m_surface, m_surface, m_context));
 
@@ -200,10 +283,25 @@ void EglContext::setVerticalSyncEnabled(bool enabled)
 ////////////////////////////////////////////////////////////
 void EglContext::createContext(EglContext* shared)
 {
+#if defined(SFML_OPENGL_ES2)
+    const EGLint clientVersion = 2;
+#elif defined(SFML_OPENGL_ES)
+    const EGLint clientVersion = 1;
+#endif
+
+#if defined(SFML_OPENGL_ES)
     const EGLint contextVersion[] = {
-        EGL_CONTEXT_CLIENT_VERSION, 1,
+        EGL_CONTEXT_CLIENT_VERSION, clientVersion,
         EGL_NONE
     };
+#else
+    // Desktop OpenGL, let the implementation choose the version
+    const EGLint contextVersion[] = {
+        EGL_NONE
+    };
+#endif
+
+    bindClientApi();
 
     EGLContext toShared;
 
@@ -227,6 +325,21 @@ void EglContext::createSurface(EGLNativeWindowType window)
 }
 
 
+////////////////////////////////////////////////////////////
+void EglContext::createPbufferSurface(unsigned int width, unsigned int height)
+{
+    // Note: The EGL specs say that attrib_list can be NULL when passed to eglCreatePbufferSurface,
+    // but this is resulting in a segfault. Bug in Android?
+    EGLint attrib_list[] = {
+        EGL_WIDTH, static_cast<EGLint>(width),
+        EGL_HEIGHT, static_cast<EGLint>(height),
+        EGL_NONE
+    };
+
+    m_surface = eglCheck(eglCreatePbufferSurface(m_display, m_config, attrib_list));
+}
+
+
 ////////////////////////////////////////////////////////////
 void EglContext::destroySurface()
 {
@@ -241,26 +354,64 @@ void EglContext::destroySurface()
 ////////////////////////////////////////////////////////////
 EGLConfig EglContext::getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
+    Lock lock(configMutex);
+    Clock clock;
+
+    // eglChooseConfig is slow on some drivers, reuse the config chosen for the same settings
+    for (std::vector<ConfigEntry>::const_iterator it = configs.begin(); it != configs.end(); ++it)
+    {
+        if ((it->display == display) && (it->bitsPerPixel == bitsPerPixel) && (it->depthBits == settings.depthBits) &&
+            (it->stencilBits == settings.stencilBits) && (it->antialiasingLevel == settings.antialiasingLevel))
+            return it->config;
+    }
+
     // Set our video settings constraint
     const EGLint attributes[] = {
-        EGL_BUFFER_SIZE, bitsPerPixel,
-        EGL_DEPTH_SIZE, settings.depthBits,
-        EGL_STENCIL_SIZE, settings.stencilBits,
-        EGL_SAMPLE_BUFFERS, settings.antialiasingLevel,
+        EGL_BUFFER_SIZE, static_cast<EGLint>(bitsPerPixel),
+        EGL_DEPTH_SIZE, static_cast<EGLint>(settings.depthBits),
+        EGL_STENCIL_SIZE, static_cast<EGLint>(settings.stencilBits),
+        EGL_SAMPLE_BUFFERS, static_cast<EGLint>(settings.antialiasingLevel),
+#if defined(SFML_HEADLESS)
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+#else
         EGL_SURFACE_TYPE, EGL_WINDOW_BIT | EGL_PBUFFER_BIT,
+#endif
+#if defined(SFML_OPENGL_ES2)
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+#elif defined(SFML_OPENGL_ES)
         EGL_RENDERABLE_TYPE, EGL_OPENGL_ES_BIT,
+#else
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+#endif
         EGL_NONE
     };
 
-    EGLint configCount;
-    EGLConfig configs[1];
+    EGLint configCount = 0;
+    EGLConfig config[1];
 
     // Ask EGL for the best config matching our video settings
-    eglCheck(eglChooseConfig(display, attributes, configs, 1, &configCount));
+    eglCheck(eglChooseConfig(display, attributes, config, 1, &configCount));
+
+    if (configCount == 0)
+    {
+        err() << "No EGL config matches the requested settings. You should check your graphics driver" << std::endl;
+        return NULL;
+    }
 
     // TODO: This should check EGL_CONFORMANT and pick the first conformant configuration.
 
-    return configs[0];
+    ConfigEntry entry;
+    entry.display = display;
+    entry.bitsPerPixel = bitsPerPixel;
+    entry.depthBits = settings.depthBits;
+    entry.stencilBits = settings.stencilBits;
+    entry.antialiasingLevel = settings.antialiasingLevel;
+    entry.config = config[0];
+    configs.push_back(entry);
+
+    addConfigSelectionTime(clock.getElapsedTime());
+
+    return config[0];
 }
 
 
@@ -279,13 +430,18 @@ void EglContext::updateSettings()
     eglCheck(eglGetConfigAttrib(m_display, m_config, EGL_SAMPLES, &tmp));
     m_settings.antialiasingLevel = tmp;
     
+#ifdef SFML_OPENGL_ES2
+    m_settings.majorVersion = 2;
+    m_settings.minorVersion = 0;
+#else
     m_settings.majorVersion = 1;
     m_settings.minorVersion = 1;
+#endif
     m_settings.attributeFlags = ContextSettings::Default;
 }
 
 
-#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI)
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI) && !defined(SFML_HEADLESS)
 ////////////////////////////////////////////////////////////
 XVisualInfo EglContext::selectBestVisual(::Display* XDisplay, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
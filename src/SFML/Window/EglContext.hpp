@@ -79,6 +79,16 @@ public:
     ////////////////////////////////////////////////////////////
     ~EglContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of an OpenGL function
+    ///
+    /// \param name Name of the function to get the address of
+    ///
+    /// \return Address of the OpenGL function, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlFunctionPointer getFunction(const char* name);
+
     ////////////////////////////////////////////////////////////
     /// \brief Activate the context as the current target
     ///        for rendering
@@ -151,7 +161,7 @@ public:
     ////////////////////////////////////////////////////////////
     static EGLConfig getBestConfig(EGLDisplay display, unsigned int bitsPerPixel, const ContextSettings& settings);
 
-#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI)
+#if defined(SFML_SYSTEM_LINUX) && !defined(SFML_RPI) && !defined(SFML_HEADLESS)
     ////////////////////////////////////////////////////////////
     /// \brief Select the best EGL visual for a given set of settings
     ///
@@ -167,6 +177,15 @@ public:
 
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create an offscreen EGL surface
+    ///
+    /// \param width  Width of the surface, in pixels
+    /// \param height Height of the surface, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void createPbufferSurface(unsigned int width, unsigned int height);
+
     ////////////////////////////////////////////////////////////
     /// \brief Helper to copy the picked EGL configuration 
     ////////////////////////////////////////////////////////////
@@ -30,6 +30,7 @@
 #include <SFML/System/ThreadLocalPtr.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/OpenGL.hpp>
 #include <algorithm>
@@ -40,7 +41,13 @@
 #include <cstring>
 #include <cassert>
 
-#if !defined(SFML_OPENGL_ES)
+#if defined(SFML_HEADLESS)
+
+    // Headless builds render through EGL, with OpenGL or OpenGL ES
+    #include <SFML/Window/EglContext.hpp>
+    typedef sf::priv::EglContext ContextType;
+
+#elif !defined(SFML_OPENGL_ES)
 
     #if defined(SFML_SYSTEM_WINDOWS)
 
@@ -197,8 +204,17 @@ namespace
     // context is currently being used on the current thread
     sf::ThreadLocalPtr<TransientContext> transientContext(NULL);
 
-    // Supported OpenGL extensions
+    // Supported OpenGL extensions, sorted
     std::vector<std::string> extensions;
+
+    // Driver identification, read once from the shared context
+    std::string vendorName;
+    std::string rendererName;
+
+    // Time spent setting up OpenGL, with its own mutex since it's
+    // updated from code that may already hold other context locks
+    sf::Mutex timingsMutex;
+    sf::Context::StartupTimings startupTimings;
 }
 
 
@@ -223,11 +239,14 @@ void GlContext::initResource()
             return;
         }
 
+        Clock clock;
+
         // Create the shared context
         sharedContext = new ContextType(NULL);
         sharedContext->initialize(ContextSettings());
 
         // Load our extensions vector
+        Clock extensionsClock;
         extensions.clear();
 
         // Check whether a >= 3.0 context is available
@@ -277,6 +296,25 @@ void GlContext::initResource()
             }
         }
 
+        // Sort the extensions so that they can be looked up quickly
+        std::sort(extensions.begin(), extensions.end());
+
+        {
+            Lock timingsLock(timingsMutex);
+            startupTimings.extensionsQuery += extensionsClock.getElapsedTime();
+        }
+
+        // The driver strings don't change, save them
+        const char* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+        const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+        vendorName = vendor ? vendor : "";
+        rendererName = renderer ? renderer : "";
+
+        {
+            Lock timingsLock(timingsMutex);
+            startupTimings.sharedContextCreation += clock.getElapsedTime();
+        }
+
         // Deactivate the shared context so that others can activate it when necessary
         sharedContext->setActive(false);
     }
@@ -354,6 +392,7 @@ GlContext* GlContext::create()
 
     Lock lock(mutex);
 
+    Clock clock;
     GlContext* context = NULL;
 
     // We don't use acquireTransientContext here since we have
@@ -370,6 +409,12 @@ GlContext* GlContext::create()
 
     context->initialize(ContextSettings());
 
+    {
+        Lock timingsLock(timingsMutex);
+        startupTimings.contextCreation += clock.getElapsedTime();
+        startupTimings.contextCount++;
+    }
+
     return context;
 }
 
@@ -382,6 +427,7 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
 
     Lock lock(mutex);
 
+    Clock clock;
     GlContext* context = NULL;
 
     // We don't use acquireTransientContext here since we have
@@ -399,6 +445,12 @@ GlContext* GlContext::create(const ContextSettings& settings, const WindowImpl*
     context->initialize(settings);
     context->checkSettings(settings);
 
+    {
+        Lock timingsLock(timingsMutex);
+        startupTimings.contextCreation += clock.getElapsedTime();
+        startupTimings.contextCount++;
+    }
+
     return context;
 }
 
@@ -411,6 +463,7 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
 
     Lock lock(mutex);
 
+    Clock clock;
     GlContext* context = NULL;
 
     // We don't use acquireTransientContext here since we have
@@ -428,6 +481,12 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
     context->initialize(settings);
     context->checkSettings(settings);
 
+    {
+        Lock timingsLock(timingsMutex);
+        startupTimings.contextCreation += clock.getElapsedTime();
+        startupTimings.contextCount++;
+    }
+
     return context;
 }
 
@@ -435,14 +494,14 @@ GlContext* GlContext::create(const ContextSettings& settings, unsigned int width
 ////////////////////////////////////////////////////////////
 bool GlContext::isExtensionAvailable(const char* name)
 {
-    return std::find(extensions.begin(), extensions.end(), name) != extensions.end();
+    return std::binary_search(extensions.begin(), extensions.end(), name);
 }
 
 
 ////////////////////////////////////////////////////////////
 GlFunctionPointer GlContext::getFunction(const char* name)
 {
-#if !defined(SFML_OPENGL_ES)
+#if !defined(SFML_SYSTEM_IOS)
 
     Lock lock(mutex);
 
@@ -456,6 +515,24 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 }
 
 
+////////////////////////////////////////////////////////////
+Context::StartupTimings GlContext::getStartupTimings()
+{
+    Lock lock(timingsMutex);
+
+    return startupTimings;
+}
+
+
+////////////////////////////////////////////////////////////
+void GlContext::addConfigSelectionTime(Time duration)
+{
+    Lock lock(timingsMutex);
+
+    startupTimings.configSelection += duration;
+}
+
+
 ////////////////////////////////////////////////////////////
 GlContext::~GlContext()
 {
@@ -653,6 +730,8 @@ void GlContext::initialize(const ContextSettings& requestedSettings)
                 }
             }
         }
+#if !defined(SFML_OPENGL_ES)
+        // OpenGL ES has no profiles, querying it would raise an error
         else if ((m_settings.majorVersion > 3) || (m_settings.minorVersion >= 2))
         {
             // Retrieve the context profile
@@ -662,6 +741,7 @@ void GlContext::initialize(const ContextSettings& requestedSettings)
             if (profile & GL_CONTEXT_CORE_PROFILE_BIT)
                 m_settings.attributeFlags |= ContextSettings::Core;
         }
+#endif
     }
 
     // Enable anti-aliasing if requested by the user and supported
@@ -699,16 +779,10 @@ void GlContext::checkSettings(const ContextSettings& requestedSettings)
     // Perform checks to inform the user if they are getting a context they might not have expected
 
     // Detect any known non-accelerated implementations and warn
-    const char* vendorName = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
-    const char* rendererName = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
-
-    if (vendorName && rendererName)
+    if ((vendorName == "Microsoft Corporation") && (rendererName == "GDI Generic"))
     {
-        if ((std::strcmp(vendorName, "Microsoft Corporation") == 0) && (std::strcmp(rendererName, "GDI Generic") == 0))
-        {
-            err() << "Warning: Detected \"Microsoft Corporation GDI Generic\" OpenGL implementation" << std::endl
-                  << "The current OpenGL implementation is not hardware-accelerated" << std::endl;
-        }
+        err() << "Warning: Detected \"Microsoft Corporation GDI Generic\" OpenGL implementation" << std::endl
+              << "The current OpenGL implementation is not hardware-accelerated" << std::endl;
     }
 
     int version = m_settings.majorVersion * 10 + m_settings.minorVersion;
@@ -143,6 +143,27 @@ public:
     ////////////////////////////////////////////////////////////
     static GlFunctionPointer getFunction(const char* name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the time spent so far setting up OpenGL
+    ///
+    /// \return Accumulated startup timings
+    ///
+    ////////////////////////////////////////////////////////////
+    static Context::StartupTimings getStartupTimings();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Account for the time spent selecting a config
+    ///
+    /// The specialized classes call this function when they are
+    /// done choosing a pixel format, visual or EGL config.
+    /// It only takes the lock guarding the timings, so it is
+    /// safe to call while holding any other context lock.
+    ///
+    /// \param duration Time spent in the selection
+    ///
+    ////////////////////////////////////////////////////////////
+    static void addConfigSelectionTime(Time duration);
+
     ////////////////////////////////////////////////////////////
     /// \brief Destructor
     ///
@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2017 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Headless/WindowImplHeadless.hpp>
+#include <SFML/System/Err.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+WindowImplHeadless::WindowImplHeadless(WindowHandle handle) :
+m_size(0, 0)
+{
+    // There are no native windows to attach to
+}
+
+
+////////////////////////////////////////////////////////////
+WindowImplHeadless::WindowImplHeadless(VideoMode mode, const String& title, unsigned long style, const ContextSettings& settings) :
+m_size(mode.width, mode.height)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+WindowImplHeadless::~WindowImplHeadless()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+WindowHandle WindowImplHeadless::getSystemHandle() const
+{
+    return 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2i WindowImplHeadless::getPosition() const
+{
+    // Not applicable
+    return Vector2i(0, 0);
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setPosition(const Vector2i& position)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u WindowImplHeadless::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setSize(const Vector2u& size)
+{
+    // The offscreen surface belongs to the context, which the window can't reach:
+    // keep the current size rather than reporting one that isn't rendered
+    if (size != m_size)
+        err() << "Headless windows can't be resized (requested " << size.x << "x" << size.y
+              << ", keeping " << m_size.x << "x" << m_size.y << ")" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setTitle(const String& title)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setIcon(unsigned int width, unsigned int height, const Uint8* pixels)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setVisible(bool visible)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setMouseCursorVisible(bool visible)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setMouseCursorGrabbed(bool grabbed)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::setKeyRepeatEnabled(bool enabled)
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::requestFocus()
+{
+    // Not applicable
+}
+
+
+////////////////////////////////////////////////////////////
+bool WindowImplHeadless::hasFocus() const
+{
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void WindowImplHeadless::processEvents()
+{
+    // No events without a display server
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -33,7 +33,9 @@
 #if defined(SFML_SYSTEM_WINDOWS)
     #include <SFML/Window/Win32/InputImpl.hpp>
 #elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
-    #if defined(SFML_RPI)
+    #if defined(SFML_HEADLESS)
+        #include <SFML/Window/Headless/InputImpl.hpp>
+    #elif defined(SFML_RPI)
         #include <SFML/Window/RPi/InputImpl.hpp>
     #else
         #include <SFML/Window/Unix/InputImpl.hpp>
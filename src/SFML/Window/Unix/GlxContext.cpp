@@ -30,6 +30,7 @@
 #include <SFML/Window/Unix/Display.hpp>
 #include <SFML/System/Mutex.hpp>
 #include <SFML/System/Lock.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <vector>
 
@@ -310,6 +311,8 @@ void GlxContext::setVerticalSyncEnabled(bool enabled)
 ////////////////////////////////////////////////////////////
 XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPerPixel, const ContextSettings& settings)
 {
+    Clock clock;
+
     // Make sure that extensions are initialized
     ensureExtensionsInit(display, DefaultScreen(display));
 
@@ -376,6 +379,8 @@ XVisualInfo GlxContext::selectBestVisual(::Display* display, unsigned int bitsPe
         // Free the array of visuals
         XFree(visuals);
 
+        addConfigSelectionTime(clock.getElapsedTime());
+
         return bestVisual;
     }
     else
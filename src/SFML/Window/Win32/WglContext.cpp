@@ -31,6 +31,7 @@
 #include <SFML/System/ThreadLocalPtr.hpp>
 #include <SFML/System/Lock.hpp>
 #include <SFML/System/Mutex.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <sstream>
 #include <vector>
@@ -267,6 +268,8 @@ void WglContext::setVerticalSyncEnabled(bool enabled)
 ////////////////////////////////////////////////////////////
 int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPixel, const ContextSettings& settings, bool pbuffer)
 {
+    Clock clock;
+
     // Let's find a suitable pixel format -- first try with wglChoosePixelFormatARB
     int bestFormat = 0;
     if (sfwgl_ext_ARB_pixel_format == sfwgl_LOAD_SUCCEEDED)
@@ -377,7 +380,10 @@ int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPix
 
     // ChoosePixelFormat doesn't support pbuffers
     if (pbuffer)
+    {
+        addConfigSelectionTime(clock.getElapsedTime());
         return bestFormat;
+    }
 
     // Find a pixel format with ChoosePixelFormat, if wglChoosePixelFormatARB is not supported
     if (bestFormat == 0)
@@ -399,6 +405,8 @@ int WglContext::selectBestPixelFormat(HDC deviceContext, unsigned int bitsPerPix
         bestFormat = ChoosePixelFormat(deviceContext, &descriptor);
     }
 
+    addConfigSelectionTime(clock.getElapsedTime());
+
     return bestFormat;
 }
 
@@ -40,7 +40,10 @@
 
 #elif defined(SFML_SYSTEM_LINUX) || defined(SFML_SYSTEM_FREEBSD)
 
-    #if defined(SFML_RPI)
+    #if defined(SFML_HEADLESS)
+        #include <SFML/Window/Headless/WindowImplHeadless.hpp>
+        typedef sf::priv::WindowImplHeadless WindowImplType;
+    #elif defined(SFML_RPI)
         #include <SFML/Window/RPi/WindowImplRPi.hpp>
         typedef sf::priv::WindowImplRPi WindowImplType;
     #else